@@ -31,6 +31,10 @@
 #include "SQLStorages.h"
 #include "World.h"
 
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <algorithm>
+
 /** \addtogroup auctionbot
  * @{
  * \file
@@ -47,20 +51,14 @@ struct BuyerAuctionEval
     time_t  LastExist;
 };
 
-struct BuyerItemInfo
-{
-    BuyerItemInfo() : ItemCount(0), BuyPrice(0), BidPrice(0), MinBuyPrice(0), MinBidPrice(0) {}
+typedef std::map<uint32, BuyerAuctionEval > CheckEntryMap;
+typedef std::vector<AuctionMarketEntry> MarketAuctions;     // sorted by auction id
 
-    uint32  ItemCount;
-    double  BuyPrice;
-    double  BidPrice;
-    uint32  MinBuyPrice;
-    uint32  MinBidPrice;
+struct AuctionMarketEntryIdLess
+{
+    bool operator()(AuctionMarketEntry const& entry, uint32 id) const { return entry.Id < id; }
 };
 
-typedef std::map<uint32, BuyerItemInfo > BuyerItemInfoMap;
-typedef std::map<uint32, BuyerAuctionEval > CheckEntryMap;
-
 struct AHB_Buyer_Config
 {
     public:
@@ -74,7 +72,6 @@ struct AHB_Buyer_Config
         AuctionHouseType GetHouseType() const { return m_houseType; }
 
     public:
-        BuyerItemInfoMap SameItemInfo;
         CheckEntryMap    CheckedEntry;
         uint32           FactionChance;
         bool             BuyerEnabled;
@@ -197,19 +194,22 @@ class AuctionBotBuyer : public AuctionBotAgent
 
         bool        Initialize() override;
         /**
-         * Updates the specified house type. Will buy items if there are any that match certain
+         * Plans for the specified house type. Will buy items if there are any that match certain
          * criteria.
          * @param houseType Type of the house.
-         * @return true if the update was successful, false otherwise
+         * @param actions The planned bids and buyouts.
+         * @return true if the buyer is enabled for the house, false otherwise
          */
-        bool        Update(AuctionHouseType houseType) override;
+        bool        Plan(AuctionHouseType houseType, AuctionBotActionList& actions) override;
 
         void        LoadConfig();
         /**
          * Adds the new auction buyer bot bid.
          * @param config The config.
+         * @param auctions The auctions of the house.
+         * @param actions The planned bids and buyouts.
          */
-        void        addNewAuctionBuyerBotBid(AHB_Buyer_Config& config);
+        void        addNewAuctionBuyerBotBid(AHB_Buyer_Config& config, MarketAuctions const& auctions, AuctionBotActionList& actions);
 
     private:
         uint32              m_CheckInterval;
@@ -245,18 +245,22 @@ class AuctionBotBuyer : public AuctionBotAgent
          */
         bool        IsBidableEntry(uint32 bidPrice, double InGame_BuyPrice, double MaxBidablePrice, uint32 MinBidPrice, uint32 MaxChance, uint32 ChanceRatio);
         /**
-         * Places the bid to entry.
+         * Plans the bid to entry.
          *
+         * @param config The config.
          * @param auction The auction.
          * @param bidPrice The bid price.
+         * @param actions The planned actions.
          */
-        void        PlaceBidToEntry(AuctionEntry* auction, uint32 bidPrice);
+        void        PlaceBidToEntry(AHB_Buyer_Config& config, AuctionMarketEntry const& auction, uint32 bidPrice, AuctionBotActionList& actions);
         /**
-         * Buys the entry.
+         * Plans to buy the entry.
          *
+         * @param config The config.
          * @param auction The auction.
+         * @param actions The planned actions.
          */
-        void        BuyEntry(AuctionEntry* auction);
+        void        BuyEntry(AHB_Buyer_Config& config, AuctionMarketEntry const& auction, AuctionBotActionList& actions);
         /**
          * Prepares the list of entry.
          *
@@ -267,9 +271,10 @@ class AuctionBotBuyer : public AuctionBotAgent
          * Gets the buyable entry.
          *
          * @param config The config.
+         * @param auctions The auctions of the house.
          * <returns></returns
          */
-        uint32      GetBuyableEntry(AHB_Buyer_Config& config);
+        uint32      GetBuyableEntry(AHB_Buyer_Config& config, MarketAuctions const& auctions);
 };
 
 /**
@@ -296,17 +301,19 @@ class AuctionBotSeller : public AuctionBotAgent
          */
         bool Initialize() override;
         /**
-         * Updates the specified house type by possibly putting up new items for
+         * Plans for the specified house type by possibly putting up new items for
          * sale if there's a need for it.
          * @param houseType Type of the house.
+         * @param actions The planned new auctions.
          */
-        bool Update(AuctionHouseType houseType) override;
+        bool Plan(AuctionHouseType houseType, AuctionBotActionList& actions) override;
         /**
          * Add new auction to one of the factions.
          * Faction and setting associated is passed with the config
          * @param config The config to use for adding the auctions
+         * @param actions The planned new auctions.
          */
-        void addNewAuctions(AHB_Seller_Config& config);
+        void addNewAuctions(AHB_Seller_Config& config, AuctionBotActionList& actions);
         /**
          * Sets the items ratio. This should be a value betweeen 0 and 10000 which
          * probably represents 0-100%
@@ -387,6 +394,42 @@ class AuctionBotSeller : public AuctionBotAgent
         void        LoadItemsQuantity(AHB_Seller_Config& config);
 };
 
+/**
+ * Runs the planning cycles of \ref AuctionHouseBot away from the world thread,
+ * one cycle per \ref AuctionBotPlanner::Request
+ */
+class AuctionBotPlanner : public ACE_Based::Runnable
+{
+    public:
+        AuctionBotPlanner() : m_condition(m_mutex), m_requested(false), m_busy(false), m_stop(false) {}
+
+        void run() override;
+
+        /**
+         * Starts a planning cycle.
+         * @return false if the previous cycle is still running
+         */
+        bool Request();
+        /**
+         * Blocks until the running cycle, if any, is finished.
+         */
+        void WaitIdle();
+        /**
+         * Moves the actions of the finished cycles to actions.
+         * @param actions Receives the actions.
+         */
+        void TakeResult(AuctionBotActionList& actions);
+        void Stop();
+
+    private:
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        bool m_requested;
+        bool m_busy;
+        bool m_stop;
+        AuctionBotActionList m_result;
+};
+
 INSTANTIATE_SINGLETON_1(AuctionHouseBot);
 INSTANTIATE_SINGLETON_1(AuctionBotConfig);
 
@@ -531,6 +574,7 @@ void AuctionBotConfig::GetConfigFromFile()
 
     setConfig(CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_BOOST      , "AuctionHouseBot.ItemsPerCycle.Boost"         , 75);
     setConfig(CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_NORMAL     , "AuctionHouseBot.ItemsPerCycle.Normal"        , 20);
+    setConfig(CONFIG_UINT32_AHBOT_ACTIONS_PER_UPDATE         , "AuctionHouseBot.ActionsPerUpdate"            , 10);
 
     setConfig(CONFIG_UINT32_AHBOT_ITEM_MIN_ITEM_LEVEL        , "AuctionHouseBot.Items.ItemLevel.Min"         , 0);
     setConfig(CONFIG_UINT32_AHBOT_ITEM_MAX_ITEM_LEVEL        , "AuctionHouseBot.Items.ItemLevel.Max"         , 0);
@@ -719,79 +763,38 @@ void AuctionBotBuyer::LoadConfig()
     }
 }
 
-uint32 AuctionBotBuyer::GetBuyableEntry(AHB_Buyer_Config& config)
+uint32 AuctionBotBuyer::GetBuyableEntry(AHB_Buyer_Config& config, MarketAuctions const& auctions)
 {
-    config.SameItemInfo.clear();
     uint32 count = 0;
     time_t Now = time(NULL);
 
-    AuctionHouseObject::AuctionEntryMapBounds bounds = sAuctionMgr.GetAuctionsMap(config.GetHouseType())->GetAuctionsBounds();
-    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+    for (MarketAuctions::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
     {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (item)
+        AuctionMarketEntry const& Aentry = *itr;
+        if (!sObjectMgr.GetItemPrototype(Aentry.itemTemplate))
         {
-            ItemPrototype const* prototype = item->GetProto();
-            if (prototype)
-            {
-                BuyerItemInfo& buyerItem = config.SameItemInfo[item->GetEntry()];  // Structure constructor will make sure Element are correctly initialised if entry is created here.
-                ++buyerItem.ItemCount;
-                buyerItem.BuyPrice = buyerItem.BuyPrice + (Aentry->buyout / item->GetCount());
-                buyerItem.BidPrice = buyerItem.BidPrice + (Aentry->startbid / item->GetCount());
-                if (Aentry->buyout != 0)
-                {
-                    if (Aentry->buyout / item->GetCount() < buyerItem.MinBuyPrice)
-                    {
-                        buyerItem.MinBuyPrice = Aentry->buyout / item->GetCount();
-                    }
-                    else if (buyerItem.MinBuyPrice == 0)
-                    {
-                        buyerItem.MinBuyPrice = Aentry->buyout / item->GetCount();
-                    }
-                }
-                if (Aentry->startbid / item->GetCount() < buyerItem.MinBidPrice)
-                {
-                    buyerItem.MinBidPrice = Aentry->startbid / item->GetCount();
-                }
-                else if (buyerItem.MinBidPrice == 0)
-                {
-                    buyerItem.MinBidPrice = Aentry->startbid / item->GetCount();
-                }
+            continue;
+        }
 
-                if (Aentry->owner == sAuctionBotConfig.GetAHBotId())
-                {
-                    if ((Aentry->bid != 0) && Aentry->bidder)                      // Add bided by player
-                    {
-                        config.CheckedEntry[Aentry->Id].LastExist = Now;
-                        config.CheckedEntry[Aentry->Id].AuctionId = Aentry->Id;
-                        ++count;
-                    }
-                }
-                else
-                {
-                    if (Aentry->bid != 0)
-                    {
-                        if (Aentry->bidder)
-                        {
-                            config.CheckedEntry[Aentry->Id].LastExist = Now;
-                            config.CheckedEntry[Aentry->Id].AuctionId = Aentry->Id;
-                            ++count;
-                        }
-                    }
-                    else
-                    {
-                        config.CheckedEntry[Aentry->Id].LastExist = Now;
-                        config.CheckedEntry[Aentry->Id].AuctionId = Aentry->Id;
-                        ++count;
-                    }
-                }
-            }
+        bool buyable;
+        if (Aentry.owner == sAuctionBotConfig.GetAHBotId())
+        {
+            buyable = Aentry.bid != 0 && Aentry.hasBidder;  // Add bided by player
+        }
+        else
+        {
+            buyable = Aentry.bid == 0 || Aentry.hasBidder;
+        }
+
+        if (buyable)
+        {
+            config.CheckedEntry[Aentry.Id].LastExist = Now;
+            config.CheckedEntry[Aentry.Id].AuctionId = Aentry.Id;
+            ++count;
         }
     }
 
     DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: %u items added to buyable vector for AH type: %u", count, config.GetHouseType());
-    DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: SameItemInfo size = %zu", config.SameItemInfo.size());
     return count;
 }
 
@@ -954,21 +957,31 @@ bool AuctionBotBuyer::IsBidableEntry(uint32 bidPrice, double InGame_BuyPrice, do
     }
 }
 
-void AuctionBotBuyer::PlaceBidToEntry(AuctionEntry* auction, uint32 bidPrice)
+void AuctionBotBuyer::PlaceBidToEntry(AHB_Buyer_Config& config, AuctionMarketEntry const& auction, uint32 bidPrice, AuctionBotActionList& actions)
 {
-    DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Bid placed to entry %u, %.2fg", auction->Id, float(bidPrice) / 10000.0f);
-    auction->UpdateBid(bidPrice);
+    AuctionBotAction action;
+    action.Type = AUCTIONBOT_ACTION_BID;
+    action.HouseType = config.GetHouseType();
+    action.AuctionId = auction.Id;
+    action.PlannedBid = auction.bid;
+    action.Price = bidPrice;
+    actions.push_back(action);
 }
 
-void AuctionBotBuyer::BuyEntry(AuctionEntry* auction)
+void AuctionBotBuyer::BuyEntry(AHB_Buyer_Config& config, AuctionMarketEntry const& auction, AuctionBotActionList& actions)
 {
-    DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Entry %u bought at %.2fg", auction->Id, float(auction->buyout) / 10000.0f);
-    auction->UpdateBid(auction->buyout);
+    AuctionBotAction action;
+    action.Type = AUCTIONBOT_ACTION_BUYOUT;
+    action.HouseType = config.GetHouseType();
+    action.AuctionId = auction.Id;
+    action.PlannedBid = auction.bid;
+    action.Price = auction.buyout;
+    actions.push_back(action);
 }
 
-void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
+void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config, MarketAuctions const& auctions, AuctionBotActionList& actions)
 {
-    AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(config.GetHouseType());
+    AuctionMarketSnapshot const& market = sAuctionMgr.GetAuctionsMap(config.GetHouseType())->GetMarket();
 
     PrepareListOfEntry(config);
 
@@ -987,19 +1000,20 @@ void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
     for (CheckEntryMap::iterator itr = config.CheckedEntry.begin(); itr != config.CheckedEntry.end();)
     {
         BuyerAuctionEval& auctionEval = itr->second;
-        AuctionEntry* auction = auctionHouse->GetAuction(auctionEval.AuctionId);
-        if (!auction)                                       // is auction not active now
+        MarketAuctions::const_iterator auction_itr = std::lower_bound(auctions.begin(), auctions.end(), auctionEval.AuctionId, AuctionMarketEntryIdLess());
+        if (auction_itr == auctions.end() || auction_itr->Id != auctionEval.AuctionId)  // is auction not active now
         {
-            DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Entry %u on ah %u doesn't exists, perhaps bought already?",
-                             auctionEval.AuctionId, auction->GetHouseId());
+            DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Entry %u on ah type %u doesn't exists, perhaps bought already?",
+                             auctionEval.AuctionId, config.GetHouseType());
 
             config.CheckedEntry.erase(itr++);
             continue;
         }
+        AuctionMarketEntry const& auction = *auction_itr;
 
         if ((auctionEval.LastChecked != 0) && ((Now - auctionEval.LastChecked) <= m_CheckInterval))
         {
-            DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: In time interval wait for entry %u!", auction->Id);
+            DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: In time interval wait for entry %u!", auction.Id);
             ++itr;
             continue;
         }
@@ -1011,40 +1025,38 @@ void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
 
         uint32 MaxChance = 5000;
 
-        Item* item = sAuctionMgr.GetAItem(auction->itemGuidLow);
-        if (!item)                                          // auction item not accessible, possible auction in payment pending mode
+        ItemPrototype const* prototype = sObjectMgr.GetItemPrototype(auction.itemTemplate);
+        if (!prototype)
         {
             config.CheckedEntry.erase(itr++);
             continue;
         }
 
-        ItemPrototype const* prototype = item->GetProto();
-
         uint32 BasePrice = sAuctionBotConfig.getConfig(CONFIG_BOOL_AHBOT_BUYPRICE_BUYER) ? prototype->BuyPrice : prototype->SellPrice;
-        BasePrice *= item->GetCount();
+        BasePrice *= auction.itemCount;
 
         double MaxBuyablePrice = (BasePrice * config.BuyerPriceRatio) / 100;
-        BuyerItemInfoMap::iterator sameitem_itr = config.SameItemInfo.find(item->GetEntry());
-        uint32 buyoutPrice = auction->buyout / item->GetCount();
+        uint32 buyoutPrice = auction.buyout / auction.itemCount;
 
         uint32 bidPrice;
         uint32 bidPriceByItem;
-        if (auction->bid >= auction->startbid)
+        if (auction.bid >= auction.startbid)
         {
-            bidPrice = auction->GetAuctionOutBid();
-            bidPriceByItem = auction->bid / item->GetCount();
+            bidPrice = AuctionEntry::GetAuctionOutBid(auction.bid);
+            bidPriceByItem = auction.bid / auction.itemCount;
         }
         else
         {
-            bidPrice = auction->startbid;
-            bidPriceByItem = auction->startbid / item->GetCount();
+            bidPrice = auction.startbid;
+            bidPriceByItem = auction.startbid / auction.itemCount;
         }
 
         double InGame_BuyPrice;
         double InGame_BidPrice;
         uint32 minBidPrice;
         uint32 minBuyPrice;
-        if (sameitem_itr == config.SameItemInfo.end())
+        AuctionMarketItemInfo sameBuyerItem;
+        if (!market.GetItemInfo(auction.itemTemplate, sameBuyerItem) || !sameBuyerItem.ItemCount)
         {
             InGame_BuyPrice = 0;
             InGame_BidPrice = 0;
@@ -1053,8 +1065,6 @@ void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
         }
         else
         {
-            const BuyerItemInfo& sameBuyerItem = sameitem_itr->second;
-
             if (sameBuyerItem.ItemCount == 1)
                 {
                     MaxBuyablePrice = MaxBuyablePrice * 5;
@@ -1074,40 +1084,40 @@ void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
                          minBuyPrice / 10000, minBidPrice / 10000);
         DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Actual Entry price,  Buy=%ug, Bid=%ug.", buyoutPrice / 10000, bidPrice / 10000);
 
-        if (auction->owner == sAuctionBotConfig.GetAHBotId())      // Original auction owner
+        if (auction.owner == sAuctionBotConfig.GetAHBotId())      // Original auction owner
         {
             MaxChance = MaxChance / 5;                             // if Owner is AHBot this mean player placed bid on this auction. We divide by 5 chance for AhBuyer to place bid on it. (This make more challenge than ignore entry)
         }
-        if (auction->buyout != 0)                                  // Is the item directly buyable?
+        if (auction.buyout != 0)                                  // Is the item directly buyable?
         {
             if (IsBuyableEntry(buyoutPrice, InGame_BuyPrice, MaxBuyablePrice, minBuyPrice, MaxChance, config.FactionChance))
             {
                 if (IsBidableEntry(bidPriceByItem, InGame_BuyPrice, MaxBidablePrice, minBidPrice, MaxChance / 2, config.FactionChance))
                     if (urand(0, 5) == 0)
                     {
-                        PlaceBidToEntry(auction, bidPrice);
+                        PlaceBidToEntry(config, auction, bidPrice, actions);
                     }
                     else
                     {
-                        BuyEntry(auction);
+                        BuyEntry(config, auction, actions);
                     }
                 else
                 {
-                    BuyEntry(auction);
+                    BuyEntry(config, auction, actions);
                 }
             }
             else
             {
                 if (IsBidableEntry(bidPriceByItem, InGame_BuyPrice, MaxBidablePrice, minBidPrice, MaxChance / 2, config.FactionChance))
                 {
-                    PlaceBidToEntry(auction, bidPrice);
+                    PlaceBidToEntry(config, auction, bidPrice, actions);
                 }
             }
         }
         else // buyout = 0 mean only bid are possible
             if (IsBidableEntry(bidPriceByItem, InGame_BuyPrice, MaxBidablePrice, minBidPrice, MaxChance, config.FactionChance))
             {
-                PlaceBidToEntry(auction, bidPrice);
+                PlaceBidToEntry(config, auction, bidPrice, actions);
             }
 
         auctionEval.LastChecked = Now;
@@ -1117,14 +1127,16 @@ void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
     }
 }
 
-bool AuctionBotBuyer::Update(AuctionHouseType houseType)
+bool AuctionBotBuyer::Plan(AuctionHouseType houseType, AuctionBotActionList& actions)
 {
     if (sAuctionBotConfig.getConfigBuyerEnabled(houseType))
     {
         DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: %s buying ...", AuctionBotConfig::GetHouseTypeName(houseType));
-        if (GetBuyableEntry(m_HouseConfig[houseType]) > 0)
+        MarketAuctions auctions;
+        sAuctionMgr.GetAuctionsMap(houseType)->GetMarket().GetAuctions(auctions);
+        if (GetBuyableEntry(m_HouseConfig[houseType], auctions) > 0)
         {
-            addNewAuctionBuyerBotBid(m_HouseConfig[houseType]);
+            addNewAuctionBuyerBotBid(m_HouseConfig[houseType], auctions, actions);
         }
         return true;
     }
@@ -1775,25 +1787,10 @@ void AuctionBotSeller::LoadSellerValues(AHB_Seller_Config& config)
 // Fill ItemInfos object with real content of AH.
 uint32 AuctionBotSeller::SetStat(AHB_Seller_Config& config)
 {
-    std::vector<std::vector<uint32> > ItemsInAH(MAX_AUCTION_QUALITY, std::vector< uint32 > (MAX_ITEM_CLASS));
+    // ahbot items only, counted by the market snapshot as auctions come and go
+    uint32 ItemsInAH[MAX_ITEM_QUALITY][MAX_ITEM_CLASS];
+    sAuctionMgr.GetAuctionsMap(config.GetHouseType())->GetMarket().GetTrackedCounts(ItemsInAH);
 
-    AuctionHouseObject::AuctionEntryMapBounds bounds = sAuctionMgr.GetAuctionsMap(config.GetHouseType())->GetAuctionsBounds();
-    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-    {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (item)
-        {
-            ItemPrototype const* prototype = item->GetProto();
-            if (prototype)
-            {
-                if (Aentry->owner == sAuctionBotConfig.GetAHBotId())             // Add only ahbot items
-                {
-                    ++ItemsInAH[prototype->Quality][prototype->Class];
-                }
-            }
-        }
-    }
     uint32 count = 0;
     for (uint32 j = 0; j < MAX_AUCTION_QUALITY; ++j)
     {
@@ -1931,7 +1928,7 @@ void AuctionBotSeller::SetItemsAmountForQuality(AuctionQuality quality, uint32 v
 
 // Add new auction to one of the factions.
 // Faction and setting assossiated is defined passed argument ( config )
-void AuctionBotSeller::addNewAuctions(AHB_Seller_Config& config)
+void AuctionBotSeller::addNewAuctions(AHB_Seller_Config& config, AuctionBotActionList& actions)
 {
     uint32 items;
 
@@ -1946,18 +1943,6 @@ void AuctionBotSeller::addNewAuctions(AHB_Seller_Config& config)
         items = sAuctionBotConfig.GetItemPerCycleNormal();
     }
 
-    uint32 houseid;
-    switch (config.GetHouseType())
-    {
-        case AUCTION_HOUSE_ALLIANCE: houseid =  1; break;
-        case AUCTION_HOUSE_HORDE:    houseid =  6; break;
-        default:                     houseid =  7; break;
-    }
-
-    AuctionHouseEntry const* ahEntry = sAuctionHouseStore.LookupEntry(houseid);
-
-    AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(config.GetHouseType());
-
     RandomArray randArray;
     std::vector<std::vector<uint32> > ItemsAdded(MAX_AUCTION_QUALITY, std::vector<uint32> (MAX_ITEM_CLASS));
     // Main loop
@@ -1988,39 +1973,40 @@ void AuctionBotSeller::addNewAuctions(AHB_Seller_Config& config)
 
         uint32 stackCount = urand(1, prototype->GetMaxStackSize());
 
-        Item* item = Item::CreateItem(itemID, stackCount);
-        if (!item)
-        {
-            sLog.outError("AHBot: Item::CreateItem() returned NULL for item %u (stack: %u)", itemID, stackCount);
-            return;
-        }
-
         uint32 buyoutPrice;
         uint32 bidPrice = 0;
         // Not sure if i will keep the next test
         if (sAuctionBotConfig.getConfig(CONFIG_BOOL_AHBOT_BUYPRICE_SELLER))
         {
-            buyoutPrice  = prototype->BuyPrice * item->GetCount();
+            buyoutPrice  = prototype->BuyPrice * stackCount;
         }
         else
         {
-            buyoutPrice  = prototype->SellPrice * item->GetCount();
+            buyoutPrice  = prototype->SellPrice * stackCount;
         }
         // Price of items are set here
         SetPricesOfItem(config, buyoutPrice, bidPrice, stackCount, ItemQualities(prototype->Quality));
 
-        auctionHouse->AddAuctionByGuid(ahEntry, item, urand(config.GetMinTime(), config.GetMaxTime()) * HOUR, bidPrice, buyoutPrice, sAuctionBotConfig.GetAHBotId());
+        AuctionBotAction action;
+        action.Type = AUCTIONBOT_ACTION_SELL;
+        action.HouseType = config.GetHouseType();
+        action.Price = buyoutPrice;
+        action.ItemId = itemID;
+        action.StackCount = stackCount;
+        action.StartBid = bidPrice;
+        action.Duration = urand(config.GetMinTime(), config.GetMaxTime()) * HOUR;
+        actions.push_back(action);
     }
 }
 
-bool AuctionBotSeller::Update(AuctionHouseType houseType)
+bool AuctionBotSeller::Plan(AuctionHouseType houseType, AuctionBotActionList& actions)
 {
     if (sAuctionBotConfig.getConfigItemAmountRatio(houseType) > 0)
     {
         DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_SELLER, "AHBot: %s selling ...", AuctionBotConfig::GetHouseTypeName(houseType));
         if (SetStat(m_HouseConfig[houseType]))
         {
-            addNewAuctions(m_HouseConfig[houseType]);
+            addNewAuctions(m_HouseConfig[houseType], actions);
         }
         return true;
     }
@@ -2030,18 +2016,101 @@ bool AuctionBotSeller::Update(AuctionHouseType houseType)
     }
 }
 
+//== AuctionBotPlanner functions ===========================
+
+void AuctionBotPlanner::run()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_mutex);
+    for (;;)
+    {
+        while (!m_requested && !m_stop)
+        {
+            m_condition.wait();
+        }
+
+        if (m_stop)
+        {
+            break;
+        }
+
+        m_requested = false;
+        guard.release();
+
+        AuctionBotActionList actions;
+        sAuctionBot.MakePlan(actions);
+
+        guard.acquire();
+        m_result.insert(m_result.end(), actions.begin(), actions.end());
+        m_busy = false;
+        m_condition.broadcast();
+    }
+}
+
+bool AuctionBotPlanner::Request()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, false);
+    if (m_busy)
+    {
+        return false;
+    }
+
+    m_busy = true;
+    m_requested = true;
+    m_condition.broadcast();
+    return true;
+}
+
+void AuctionBotPlanner::WaitIdle()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+    while (m_busy)
+    {
+        m_condition.wait();
+    }
+}
+
+void AuctionBotPlanner::TakeResult(AuctionBotActionList& actions)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+    actions.swap(m_result);
+    m_result.clear();
+}
+
+void AuctionBotPlanner::Stop()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+    m_stop = true;
+    m_condition.broadcast();
+}
+
 //== AuctionHouseBot functions =============================
 
-AuctionHouseBot::AuctionHouseBot() : m_Buyer(NULL), m_Seller(NULL), m_OperationSelector(0)
+AuctionHouseBot::AuctionHouseBot() : m_Buyer(NULL), m_Seller(NULL), m_OperationSelector(0),
+    m_Planner(NULL), m_PlannerThread(NULL), m_NextAction(0)
 {
 }
 
 AuctionHouseBot::~AuctionHouseBot()
 {
+    if (m_PlannerThread)
+    {
+        m_Planner->Stop();
+        m_PlannerThread->wait();
+        delete m_PlannerThread;                             // This also deletes m_Planner
+    }
+
     delete m_Buyer;
     delete m_Seller;
 }
 
+void AuctionHouseBot::WaitForPlanner()
+{
+    if (m_Planner)
+    {
+        m_Planner->WaitIdle();
+    }
+}
+
 void AuctionHouseBot::InitializeAgents()
 {
     if (sAuctionBotConfig.getConfig(CONFIG_BOOL_AHBOT_SELLER_ENABLED))
@@ -2064,18 +2133,28 @@ void AuctionHouseBot::InitializeAgents()
             m_Buyer = NULL;
         }
     }
+
+    // also reached from a config reload that just enabled the bot
+    if ((m_Buyer || m_Seller) && !m_PlannerThread)
+    {
+        m_Planner = new AuctionBotPlanner();
+        m_PlannerThread = new ACE_Based::Thread(m_Planner);
+    }
 }
 
 void AuctionHouseBot::Initialize()
 {
     if (sAuctionBotConfig.Initialize())
     {
+        sAuctionMgr.SetMarketTrackedOwner(sAuctionBotConfig.GetAHBotId());
         InitializeAgents();
     }
 }
 
 void AuctionHouseBot::SetItemsRatio(uint32 al, uint32 ho, uint32 ne)
 {
+    WaitForPlanner();
+
     if (AuctionBotSeller* seller = dynamic_cast<AuctionBotSeller*>(m_Seller))
     {
         seller->SetItemsRatio(al, ho, ne);
@@ -2084,6 +2163,8 @@ void AuctionHouseBot::SetItemsRatio(uint32 al, uint32 ho, uint32 ne)
 
 void AuctionHouseBot::SetItemsRatioForHouse(AuctionHouseType house, uint32 val)
 {
+    WaitForPlanner();
+
     if (AuctionBotSeller* seller = dynamic_cast<AuctionBotSeller*>(m_Seller))
     {
         seller->SetItemsRatioForHouse(house, val);
@@ -2092,6 +2173,8 @@ void AuctionHouseBot::SetItemsRatioForHouse(AuctionHouseType house, uint32 val)
 
 void AuctionHouseBot::SetItemsAmount(uint32(&vals) [MAX_AUCTION_QUALITY])
 {
+    WaitForPlanner();
+
     if (AuctionBotSeller* seller = dynamic_cast<AuctionBotSeller*>(m_Seller))
     {
         seller->SetItemsAmount(vals);
@@ -2100,6 +2183,8 @@ void AuctionHouseBot::SetItemsAmount(uint32(&vals) [MAX_AUCTION_QUALITY])
 
 void AuctionHouseBot::SetItemsAmountForQuality(AuctionQuality quality, uint32 val)
 {
+    WaitForPlanner();
+
     if (AuctionBotSeller* seller = dynamic_cast<AuctionBotSeller*>(m_Seller))
     {
         seller->SetItemsAmountForQuality(quality, val);
@@ -2108,12 +2193,24 @@ void AuctionHouseBot::SetItemsAmountForQuality(AuctionQuality quality, uint32 va
 
 bool AuctionHouseBot::ReloadAllConfig()
 {
+    WaitForPlanner();
+
     if (!sAuctionBotConfig.Reload())
     {
         sLog.outError("AHBot: Error while trying to reload config from file!");
         return false;
     }
 
+    // planned with the old config
+    m_Actions.clear();
+    m_NextAction = 0;
+    if (m_Planner)
+    {
+        AuctionBotActionList outdated;
+        m_Planner->TakeResult(outdated);
+    }
+
+    sAuctionMgr.SetMarketTrackedOwner(sAuctionBotConfig.GetAHBotId());
     InitializeAgents();
     return true;
 }
@@ -2173,11 +2270,20 @@ void AuctionHouseBot::Rebuild(bool all)
 void AuctionHouseBot::Update()
 {
     // nothing do...
-    if (!m_Buyer && !m_Seller)
+    if (!m_Planner || (!m_Buyer && !m_Seller))
     {
         return;
     }
 
+    // the previous cycle is still planned or applied, its actions were based on the market before them
+    if (m_NextAction < m_Actions.size() || !m_Planner->Request())
+    {
+        DEBUG_LOG("AHBot: previous cycle not finished yet, skipped");
+    }
+}
+
+void AuctionHouseBot::MakePlan(AuctionBotActionList& actions)
+{
     // scan all possible update cases until first success
     for (uint32 count = 0; count < 2 * MAX_AUCTION_HOUSE_TYPE; ++count)
     {
@@ -2187,14 +2293,14 @@ void AuctionHouseBot::Update()
         {
             if (m_Seller)
             {
-                successStep = m_Seller->Update(AuctionHouseType(m_OperationSelector));
+                successStep = m_Seller->Plan(AuctionHouseType(m_OperationSelector), actions);
             }
         }
         else
         {
             if (m_Buyer)
             {
-                successStep = m_Buyer->Update(AuctionHouseType(m_OperationSelector - MAX_AUCTION_HOUSE_TYPE));
+                successStep = m_Buyer->Plan(AuctionHouseType(m_OperationSelector - MAX_AUCTION_HOUSE_TYPE), actions);
             }
         }
 
@@ -2211,4 +2317,88 @@ void AuctionHouseBot::Update()
         }
     }
 }
+
+void AuctionHouseBot::ApplyPlannedActions()
+{
+    if (!m_Planner)
+    {
+        return;
+    }
+
+    if (m_NextAction >= m_Actions.size())
+    {
+        m_Actions.clear();
+        m_NextAction = 0;
+        m_Planner->TakeResult(m_Actions);
+        if (m_Actions.empty())
+        {
+            return;
+        }
+    }
+
+    uint32 limit = sAuctionBotConfig.getConfig(CONFIG_UINT32_AHBOT_ACTIONS_PER_UPDATE);
+    size_t end = limit && m_NextAction + limit < m_Actions.size() ? m_NextAction + limit : m_Actions.size();
+    for (; m_NextAction < end; ++m_NextAction)
+    {
+        ApplyAction(m_Actions[m_NextAction]);
+    }
+}
+
+void AuctionHouseBot::ApplyAction(AuctionBotAction const& action)
+{
+    AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(action.HouseType);
+
+    switch (action.Type)
+    {
+        case AUCTIONBOT_ACTION_BID:
+        case AUCTIONBOT_ACTION_BUYOUT:
+        {
+            // sold, expired or bid on since it was planned
+            AuctionEntry* auction = auctionHouse->GetAuction(action.AuctionId);
+            if (!auction || auction->bid != action.PlannedBid)
+            {
+                DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Entry %u changed since it was checked, skipped", action.AuctionId);
+                return;
+            }
+
+            // auction item not accessible, possible auction in payment pending mode
+            if (!sAuctionMgr.GetAItem(auction->itemGuidLow))
+            {
+                return;
+            }
+
+            if (action.Type == AUCTIONBOT_ACTION_BID)
+            {
+                DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Bid placed to entry %u, %.2fg", auction->Id, float(action.Price) / 10000.0f);
+                auction->UpdateBid(action.Price);
+            }
+            else
+            {
+                DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Entry %u bought at %.2fg", auction->Id, float(auction->buyout) / 10000.0f);
+                auction->UpdateBid(auction->buyout);
+            }
+            break;
+        }
+        case AUCTIONBOT_ACTION_SELL:
+        {
+            uint32 houseid;
+            switch (action.HouseType)
+            {
+                case AUCTION_HOUSE_ALLIANCE: houseid =  1; break;
+                case AUCTION_HOUSE_HORDE:    houseid =  6; break;
+                default:                     houseid =  7; break;
+            }
+
+            Item* item = Item::CreateItem(action.ItemId, action.StackCount);
+            if (!item)
+            {
+                sLog.outError("AHBot: Item::CreateItem() returned NULL for item %u (stack: %u)", action.ItemId, action.StackCount);
+                return;
+            }
+
+            auctionHouse->AddAuctionByGuid(sAuctionHouseStore.LookupEntry(houseid), item, action.Duration, action.StartBid, action.Price, sAuctionBotConfig.GetAHBotId());
+            break;
+        }
+    }
+}
 /** @} */
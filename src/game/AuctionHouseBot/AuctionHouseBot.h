@@ -30,6 +30,13 @@
 #include "SharedDefines.h"
 #include "Item.h"
 
+class AuctionBotPlanner;
+
+namespace ACE_Based
+{
+    class Thread;
+}
+
 /**
  * This is the AuctionHouseBot and it is used to make less populated servers
  * appear more populated than they actually are by having auctions created by
@@ -74,6 +81,7 @@ enum AuctionBotConfigUInt32Values
     CONFIG_UINT32_AHBOT_MINTIME,
     CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_BOOST,
     CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_NORMAL,
+    CONFIG_UINT32_AHBOT_ACTIONS_PER_UPDATE,
     CONFIG_UINT32_AHBOT_ALLIANCE_ITEM_AMOUNT_RATIO,
     CONFIG_UINT32_AHBOT_HORDE_ITEM_AMOUNT_RATIO,
     CONFIG_UINT32_AHBOT_NEUTRAL_ITEM_AMOUNT_RATIO,
@@ -361,6 +369,40 @@ class AuctionBotConfig
 
 #define sAuctionBotConfig MaNGOS::Singleton<AuctionBotConfig>::Instance()
 
+/**
+ * @brief What an agent decided to do, planned from the market snapshot on the planner thread
+ * and applied by the world thread in \ref AuctionHouseBot::ApplyPlannedActions
+ *
+ */
+enum AuctionBotActionType
+{
+    AUCTIONBOT_ACTION_BID,                      /**< place a bid of Price on AuctionId */
+    AUCTIONBOT_ACTION_BUYOUT,                   /**< buy AuctionId out */
+    AUCTIONBOT_ACTION_SELL                      /**< create a new auction of ItemId */
+};
+
+/**
+ * @brief
+ *
+ */
+struct AuctionBotAction
+{
+    AuctionBotAction() : Type(AUCTIONBOT_ACTION_BID), HouseType(AUCTION_HOUSE_NEUTRAL), AuctionId(0), PlannedBid(0), Price(0),
+        ItemId(0), StackCount(0), StartBid(0), Duration(0) {}
+
+    AuctionBotActionType Type;
+    AuctionHouseType HouseType;
+    uint32 AuctionId;                           /**< bid and buyout */
+    uint32 PlannedBid;                          /**< bid of the auction seen while planning, the action is dropped if it changed since */
+    uint32 Price;                               /**< bid price, or buyout price of a new auction */
+    uint32 ItemId;                              /**< sell */
+    uint32 StackCount;                          /**< sell */
+    uint32 StartBid;                            /**< sell */
+    uint32 Duration;                            /**< sell, in seconds */
+};
+
+typedef std::vector<AuctionBotAction> AuctionBotActionList;
+
 /**
  * @brief This is the base interface for the \ref AuctionBotSeller and \ref AuctionBotBuyer classes
  * which in itself only provides the possibility to use dynamic_cast in some of the
@@ -393,15 +435,17 @@ class AuctionBotAgent
         virtual bool Initialize() = 0;
 
         /**
-         * @brief This method updates what's going on on the AH for the bots, ie: if this is called for the
-         * \ref AuctionBotBuyer it will place bids on items etc if there's a config file for it. If
-         * the \ref AuctionBotSeller is called instead it would put up some new items if there's a
-         * config file for it.
+         * @brief This method plans what's going on on the AH for the bots, ie: if this is called for the
+         * \ref AuctionBotBuyer it will decide which bids to place etc if there's a config file for it. If
+         * the \ref AuctionBotSeller is called instead it would decide which new items to put up if there's a
+         * config file for it. It runs on the planner thread and only reads the \ref AuctionMarketSnapshot
+         * of the house, the decisions are applied later on by the world thread.
          *
-         * @param houseType the house type we should work with while updating
-         * @return bool true if any update was actually done, ie: we put some items up/bought some, false otherwise
+         * @param houseType the house type we should work with while planning
+         * @param actions the planned actions are appended here
+         * @return bool true if the house is handled by this agent, false otherwise
          */
-        virtual bool Update(AuctionHouseType houseType) = 0;
+        virtual bool Plan(AuctionHouseType houseType, AuctionBotActionList& actions) = 0;
 };
 
 /**
@@ -445,12 +489,24 @@ class AuctionHouseBot
         ~AuctionHouseBot();
 
         /**
-         * @brief Updates the \ref AuctionHouseBot by checking if either the \ref AuctionBotSeller or
-         * \ref AuctionBotBuyer wants to sell/buy anything and in that case lets one of them do
+         * @brief Starts a new planning cycle on the planner thread, unless the previous one is still
+         * being planned or applied. The planner checks if either the \ref AuctionBotSeller or
+         * \ref AuctionBotBuyer wants to sell/buy anything and in that case lets one of them plan
          * that and the other one will have to wait until the next call to \ref AuctionHouseBot::Update
          *
          */
         void Update();
+        /**
+         * @brief Applies a bounded number of the actions planned by the last cycle, called every world update
+         *
+         */
+        void ApplyPlannedActions();
+        /**
+         * @brief Runs one planning cycle, called by the planner thread
+         *
+         * @param actions the planned actions
+         */
+        void MakePlan(AuctionBotActionList& actions);
         /**
          * @brief Initializes this instance.
          *
@@ -518,10 +574,26 @@ class AuctionHouseBot
          *
          */
         void InitializeAgents();
+        /**
+         * @brief Waits for a running planning cycle, before the agents or their config are changed
+         *
+         */
+        void WaitForPlanner();
+        /**
+         * @brief Applies one planned action to the real auction house
+         *
+         * @param action the action
+         */
+        void ApplyAction(AuctionBotAction const& action);
         AuctionBotAgent* m_Buyer; /**< The buyer (\ref AuctionBotBuyer) for this \ref AuctionHouseBot */
         AuctionBotAgent* m_Seller; /**< The seller (\ref AuctionBotSeller) for this \ref AuctionHouseBot */
 
-        uint32 m_OperationSelector; /**< 0..2*MAX_AUCTION_HOUSE_TYPE-1 */
+        uint32 m_OperationSelector; /**< 0..2*MAX_AUCTION_HOUSE_TYPE-1, only used by the planner thread */
+
+        AuctionBotPlanner* m_Planner; /**< Runs \ref AuctionHouseBot::MakePlan, deleted with m_PlannerThread */
+        ACE_Based::Thread* m_PlannerThread; /**< TODO */
+        AuctionBotActionList m_Actions; /**< Planned actions not applied yet */
+        size_t m_NextAction; /**< Index of the next action in m_Actions to apply */
 };
 
 
@@ -255,6 +255,70 @@ bool ChatHandler::HandlePDumpWriteCommand(char* args)
     return true;
 }
 
+bool ChatHandler::HandlePDumpWriteAllCommand(char* args)
+{
+    char* dir = ExtractQuotedOrLiteralArg(&args);
+    if (!dir)
+    {
+        return false;
+    }
+
+    uint32 account_id = 0;
+    if (*args)
+    {
+        account_id = ExtractAccountId(&args);
+        if (!account_id)
+        {
+            return false;
+        }
+    }
+
+    QueryResult* result = account_id
+                          ? CharacterDatabase.PQuery("SELECT `guid` FROM `characters` WHERE `account` = '%u'", account_id)
+                          : CharacterDatabase.Query("SELECT `guid` FROM `characters`");
+
+    std::vector<uint32> guids;
+    if (result)
+    {
+        do
+        {
+            guids.push_back(result->Fetch()[0].GetUInt32());
+        }
+        while (result->NextRow());
+
+        delete result;
+    }
+
+    uint32 written = PlayerDumpBulk::WriteDumps(dir, guids);
+    PSendSysMessage("Dumped %u of %u characters to %s", written, uint32(guids.size()), dir);
+    return true;
+}
+
+bool ChatHandler::HandlePDumpLoadAllCommand(char* args)
+{
+    char* dir = ExtractQuotedOrLiteralArg(&args);
+    if (!dir)
+    {
+        return false;
+    }
+
+    // without account every character goes back to its dumped account
+    uint32 account_id = 0;
+    if (*args)
+    {
+        account_id = ExtractAccountId(&args);
+        if (!account_id)
+        {
+            return false;
+        }
+    }
+
+    uint32 total = 0;
+    uint32 loaded = PlayerDumpBulk::LoadDumps(dir, account_id, total);
+    PSendSysMessage("Loaded %u of %u character dumps from %s", loaded, total, dir);
+    return true;
+}
+
 // Misc COmmands
 
 bool ChatHandler::HandleFlushArenaPointsCommand(char* /*args*/)
@@ -65,7 +65,7 @@ static bool HandleResetStatsOrLevelHelper(Player* player)
         player->SetShapeshiftForm(FORM_NONE);
     }
 
-    player->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_WORLD_OBJECT_SIZE);
+    player->SetObjectBoundingRadius(DEFAULT_WORLD_OBJECT_SIZE);
     player->SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
 
     player->setFactionForRace(player->getRace());
@@ -29,6 +29,10 @@
 #include "GitRevision.h"
 #include "SystemConfig.h"
 #include "UpdateTime.h"
+#include "WorldTaskMgr.h"
+#include "Database/DatabaseEnv.h"
+#include "WorldSocket.h"
+#include "WorldSocketMgr.h"
 #include "revision_data.h"
 
  /**********************************************************************
@@ -74,6 +78,71 @@ bool ChatHandler::HandleServerInfoCommand(char* /*args*/)
     PSendSysMessage(LANG_UPTIME, str.c_str());
     PSendSysMessage("World Delay: %u", updateTime); // ToDo: move to language string
 
+    uint32 tasks, tasksDone, tasksTotal;
+    sWorldTaskMgr.GetStatistic(tasks, tasksDone, tasksTotal);
+    if (tasks)
+    {
+        PSendSysMessage("World tasks: %u running, %u/%u items done", tasks, tasksDone, tasksTotal);
+    }
+
+    return true;
+}
+
+/// Display queue depth and latencies of the async database threads
+bool ChatHandler::HandleServerDbStatsCommand(char* /*args*/)
+{
+    struct { char const* name; Database* db; } databases[] =
+    {
+        { "World", &WorldDatabase },
+        { "Character", &CharacterDatabase },
+        { "Login", &LoginDatabase }
+    };
+
+    for (size_t i = 0; i < countof(databases); ++i)
+    {
+        SqlDelayStats& stats = databases[i].db->GetDelayStats();
+
+        PSendSysMessage("%s database: %li queued, %li executed, %li write batches", databases[i].name,
+                        stats.GetQueueDepth(), stats.GetExecuted(), stats.GetBatches());
+
+        for (int bucket = 0; bucket < SqlDelayStats::HISTOGRAM_BUCKETS; ++bucket)
+        {
+            uint32 bound = SqlDelayStats::GetBucketBound(bucket);
+            if (bound)
+            {
+                PSendSysMessage("  < %u ms: %li waited, %li executed", bound, stats.GetWaitHistogram(bucket), stats.GetExecHistogram(bucket));
+            }
+            else
+            {
+                PSendSysMessage("  >= %u ms: %li waited, %li executed", SqlDelayStats::GetBucketBound(bucket - 1),
+                                stats.GetWaitHistogram(bucket), stats.GetExecHistogram(bucket));
+            }
+        }
+
+        SqlDelayStats::SlowStatementList slowest = stats.GetSlowestStatements();
+        for (SqlDelayStats::SlowStatementList::const_iterator itr = slowest.begin(); itr != slowest.end(); ++itr)
+        {
+            PSendSysMessage("  %u ms: %s", itr->execTime, itr->sql.c_str());
+        }
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleServerNetStatsCommand(char* /*args*/)
+{
+    std::vector<WorldNetworkLoopStats> stats;
+    sWorldSocketMgr->GetNetworkStats(stats);
+
+    uint32 uptime = std::max<uint32>(sWorld.GetUptime(), 1);
+
+    for (size_t i = 0; i < stats.size(); ++i)
+    {
+        PSendSysMessage("Network loop %u: %li connections, %li input events (%li/s), %li output events (%li/s), %li flushes (%li/s)",
+                        uint32(i), stats[i].connections, stats[i].inputEvents, stats[i].inputEvents / long(uptime),
+                        stats[i].outputEvents, stats[i].outputEvents / long(uptime), stats[i].flushes, stats[i].flushes / long(uptime));
+    }
+
     return true;
 }
 
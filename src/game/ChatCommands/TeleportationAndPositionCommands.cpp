@@ -661,6 +661,13 @@ bool ChatHandler::HandleGPSCommand(char* args)
         PSendSysMessage(LANG_LIQUID_STATUS, liquid_status.level, liquid_status.depth_level, liquid_status.type_flags, res);
     }
 
+    MapQueryCache const& queryCache = map->GetQueryCache();
+    PSendSysMessage("Map query cache hits: line of sight %u/%u, height %u/%u",
+                    queryCache.GetLineOfSightHits(), queryCache.GetLineOfSightHits() + queryCache.GetLineOfSightMisses(),
+                    queryCache.GetHeightHits(), queryCache.GetHeightHits() + queryCache.GetHeightMisses());
+    PSendSysMessage("Grid unload: %u grids in %u ms last update (max %u ms), %u queued",
+                    map->GetGridsUnloadedLastTick(), map->GetGridUnloadTimeLastTick(), map->GetGridUnloadTimeMax(), map->GetGridUnloadQueueSize());
+
     // Additional vmap debugging help
 #ifdef _DEBUG_VMAPS
     PSendSysMessage("Static terrain height (maps only): %f", obj->GetTerrain()->GetHeightStatic(obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ(), false));
@@ -532,6 +532,14 @@ void AuctionHouseMgr::Update()
     }
 }
 
+void AuctionHouseMgr::SetMarketTrackedOwner(uint32 owner)
+{
+    for (int i = 0; i < MAX_AUCTION_HOUSE_TYPE; ++i)
+    {
+        mAuctions[i].GetMarket().SetTrackedOwner(owner);
+    }
+}
+
 uint32 AuctionHouseMgr::GetAuctionHouseTeam(AuctionHouseEntry const* house)
 {
     // auction houses have faction field pointing to PLAYER,* factions,
@@ -641,6 +649,7 @@ void AuctionHouseObject::Update()
 
                 old->second->DeleteFromDB();
                 sAuctionMgr.RemoveAItem(old->second->itemGuidLow);
+                m_market.RemoveAuction(old->second);
                 delete old->second;
                 AuctionsMap.erase(old);
                 continue;
@@ -649,6 +658,168 @@ void AuctionHouseObject::Update()
     }
 }
 
+AuctionMarketSnapshot::AuctionMarketSnapshot() : m_trackedOwner(0)
+{
+    memset(m_trackedCounts, 0, sizeof(m_trackedCounts));
+}
+
+void AuctionMarketSnapshot::CountTracked(AuctionMarketEntry const& entry, int32 diff)
+{
+    if (entry.owner != m_trackedOwner)
+    {
+        return;
+    }
+
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(entry.itemTemplate);
+    if (!proto || proto->Quality >= MAX_ITEM_QUALITY || proto->Class >= MAX_ITEM_CLASS)
+    {
+        return;
+    }
+
+    m_trackedCounts[proto->Quality][proto->Class] += diff;
+}
+
+void AuctionMarketSnapshot::SetTrackedOwner(uint32 owner)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    m_trackedOwner = owner;
+    memset(m_trackedCounts, 0, sizeof(m_trackedCounts));
+    for (EntryMap::const_iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    {
+        CountTracked(itr->second, 1);
+    }
+}
+
+void AuctionMarketSnapshot::AddAuction(AuctionEntry const* auction)
+{
+    AuctionMarketEntry entry;
+    entry.Id = auction->Id;
+    entry.itemTemplate = auction->itemTemplate;
+    entry.itemCount = auction->itemCount ? auction->itemCount : 1;
+    entry.owner = auction->owner;
+    entry.startbid = auction->startbid;
+    entry.bid = auction->bid;
+    entry.buyout = auction->buyout;
+    entry.hasBidder = auction->bidder != 0;
+
+    uint32 buyPrice = entry.buyout / entry.itemCount;
+    uint32 bidPrice = entry.startbid / entry.itemCount;
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    std::pair<EntryMap::iterator, bool> res = m_entries.insert(EntryMap::value_type(entry.Id, entry));
+    if (!res.second)
+    {
+        return;
+    }
+
+    ItemStats& stats = m_itemStats[entry.itemTemplate];
+    ++stats.Count;
+    stats.BuyPrice += buyPrice;
+    stats.BidPrice += bidPrice;
+    if (buyPrice)
+    {
+        stats.BuyPrices.insert(buyPrice);
+    }
+    if (bidPrice)
+    {
+        stats.BidPrices.insert(bidPrice);
+    }
+
+    CountTracked(entry, 1);
+}
+
+void AuctionMarketSnapshot::RemoveAuction(AuctionEntry const* auction)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    EntryMap::iterator itr = m_entries.find(auction->Id);
+    if (itr == m_entries.end())
+    {
+        return;
+    }
+
+    AuctionMarketEntry const& entry = itr->second;
+    uint32 buyPrice = entry.buyout / entry.itemCount;
+    uint32 bidPrice = entry.startbid / entry.itemCount;
+
+    ItemStatsMap::iterator stats_itr = m_itemStats.find(entry.itemTemplate);
+    if (stats_itr != m_itemStats.end())
+    {
+        ItemStats& stats = stats_itr->second;
+        --stats.Count;
+        stats.BuyPrice -= buyPrice;
+        stats.BidPrice -= bidPrice;
+        if (buyPrice)
+        {
+            stats.BuyPrices.erase(stats.BuyPrices.find(buyPrice));
+        }
+        if (bidPrice)
+        {
+            stats.BidPrices.erase(stats.BidPrices.find(bidPrice));
+        }
+
+        if (!stats.Count)
+        {
+            m_itemStats.erase(stats_itr);
+        }
+    }
+
+    CountTracked(entry, -1);
+    m_entries.erase(itr);
+}
+
+void AuctionMarketSnapshot::UpdateBid(AuctionEntry const* auction)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    EntryMap::iterator itr = m_entries.find(auction->Id);
+    if (itr != m_entries.end())
+    {
+        itr->second.bid = auction->bid;
+        itr->second.hasBidder = auction->bidder != 0;
+    }
+}
+
+void AuctionMarketSnapshot::GetAuctions(std::vector<AuctionMarketEntry>& auctions) const
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    auctions.clear();
+    auctions.reserve(m_entries.size());
+    for (EntryMap::const_iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    {
+        auctions.push_back(itr->second);
+    }
+}
+
+bool AuctionMarketSnapshot::GetItemInfo(uint32 itemEntry, AuctionMarketItemInfo& info) const
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, false);
+
+    ItemStatsMap::const_iterator itr = m_itemStats.find(itemEntry);
+    if (itr == m_itemStats.end())
+    {
+        return false;
+    }
+
+    ItemStats const& stats = itr->second;
+    info.ItemCount = stats.Count;
+    info.BuyPrice = stats.BuyPrice;
+    info.BidPrice = stats.BidPrice;
+    info.MinBuyPrice = stats.BuyPrices.empty() ? 0 : *stats.BuyPrices.begin();
+    info.MinBidPrice = stats.BidPrices.empty() ? 0 : *stats.BidPrices.begin();
+    return true;
+}
+
+void AuctionMarketSnapshot::GetTrackedCounts(uint32 (&counts)[MAX_ITEM_QUALITY][MAX_ITEM_CLASS]) const
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    memcpy(counts, m_trackedCounts, sizeof(m_trackedCounts));
+}
+
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
 {
     for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -1104,7 +1275,7 @@ uint32 AuctionEntry::GetAuctionCut() const
 }
 
 /// the sum of outbid is (1% from current bid)*5, if bid is very small, it is 1c
-uint32 AuctionEntry::GetAuctionOutBid() const
+uint32 AuctionEntry::GetAuctionOutBid(uint32 bid)
 {
     uint32 outbid = (bid / 100) * 5;
     if (!outbid)
@@ -1177,6 +1348,7 @@ bool AuctionEntry::UpdateBid(uint32 newbid, Player* newbidder /*=NULL*/)
 
     bidder = newbidder ? newbidder->GetGUIDLow() : 0;
     bid = newbid;
+    sAuctionMgr.GetAuctionsMap(auctionHouseEntry)->GetMarket().UpdateBid(this);
 
     if ((newbid < buyout) || (buyout == 0))                 // bid
     {
@@ -40,6 +40,12 @@
 
 #include "Common.h"
 #include "DBCStructure.h"
+#include "SharedDefines.h"
+#include "ItemPrototype.h"
+
+#include <ace/Thread_Mutex.h>
+#include <set>
+#include <vector>
 
 /** \addtogroup auctionhouse
  * @{
@@ -100,7 +106,8 @@ struct AuctionEntry
     uint32 GetHouseId() const { return auctionHouseEntry->houseId; }
     uint32 GetHouseFaction() const { return auctionHouseEntry->faction; }
     uint32 GetAuctionCut() const;
-    uint32 GetAuctionOutBid() const;
+    uint32 GetAuctionOutBid() const { return GetAuctionOutBid(bid); }
+    static uint32 GetAuctionOutBid(uint32 bid);             // minimal outbid over the given bid
     bool BuildAuctionInfo(WorldPacket& data) const;
     void DeleteFromDB() const;
     void SaveToDB() const;
@@ -112,6 +119,80 @@ struct AuctionEntry
     bool UpdateBid(uint32 newbid, Player* newbidder = NULL);// true if normal bid, false if buyout, bidder==NULL for generated bid
 };
 
+/**
+ * Copy of the auction data the \ref AuctionHouseBot plans with, everything except the
+ * bid never changes while the auction exists.
+ */
+struct AuctionMarketEntry
+{
+    uint32 Id;
+    uint32 itemTemplate;
+    uint32 itemCount;
+    uint32 owner;
+    uint32 startbid;
+    uint32 bid;
+    uint32 buyout;
+    bool   hasBidder;
+};
+
+/**
+ * Price statistics of all auctions of one item entry, prices are per unit of the stack
+ */
+struct AuctionMarketItemInfo
+{
+    AuctionMarketItemInfo() : ItemCount(0), BuyPrice(0), BidPrice(0), MinBuyPrice(0), MinBidPrice(0) {}
+
+    uint32  ItemCount;                                      ///< auctions of the entry
+    double  BuyPrice;                                       ///< sum of the buyouts
+    double  BidPrice;                                       ///< sum of the start bids
+    uint32  MinBuyPrice;                                    ///< lowest non zero buyout
+    uint32  MinBidPrice;                                    ///< lowest non zero start bid
+};
+
+/**
+ * Market state of one auction house, updated with every auction change so the
+ * \ref AuctionHouseBot does not have to rescan the house. All methods lock, the
+ * bot reads it from its planner thread.
+ */
+class AuctionMarketSnapshot
+{
+    public:
+        AuctionMarketSnapshot();
+
+        void SetTrackedOwner(uint32 owner);                 ///< auctions of this owner (0 = server) are counted by quality and class
+
+        void AddAuction(AuctionEntry const* auction);
+        void RemoveAuction(AuctionEntry const* auction);
+        void UpdateBid(AuctionEntry const* auction);
+
+        void GetAuctions(std::vector<AuctionMarketEntry>& auctions) const;  ///< sorted by auction id
+        bool GetItemInfo(uint32 itemEntry, AuctionMarketItemInfo& info) const;
+        void GetTrackedCounts(uint32 (&counts)[MAX_ITEM_QUALITY][MAX_ITEM_CLASS]) const;
+
+    private:
+        struct ItemStats
+        {
+            ItemStats() : Count(0), BuyPrice(0), BidPrice(0) {}
+
+            uint32 Count;
+            double BuyPrice;
+            double BidPrice;
+            std::multiset<uint32> BuyPrices;                // non zero, for the minimum
+            std::multiset<uint32> BidPrices;
+        };
+
+        typedef std::map<uint32, AuctionMarketEntry> EntryMap;
+        typedef UNORDERED_MAP<uint32, ItemStats> ItemStatsMap;
+
+        void CountTracked(AuctionMarketEntry const& entry, int32 diff);
+
+        mutable ACE_Thread_Mutex m_lock;
+        EntryMap m_entries;
+        ItemStatsMap m_itemStats;
+        uint32 m_trackedOwner;
+        uint32 m_trackedCounts[MAX_ITEM_QUALITY][MAX_ITEM_CLASS];
+};
+
 // this class is used as auctionhouse instance
 class AuctionHouseObject
 {
@@ -137,6 +218,7 @@ class AuctionHouseObject
         {
             MANGOS_ASSERT(ah);
             AuctionsMap[ah->Id] = ah;
+            m_market.AddAuction(ah);
         }
 
         AuctionEntry* GetAuction(uint32 id) const
@@ -147,9 +229,19 @@ class AuctionHouseObject
 
         bool RemoveAuction(uint32 id)
         {
-            return AuctionsMap.erase(id);
+            AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+            if (itr == AuctionsMap.end())
+            {
+                return false;
+            }
+
+            m_market.RemoveAuction(itr->second);
+            AuctionsMap.erase(itr);
+            return true;
         }
 
+        AuctionMarketSnapshot& GetMarket() { return m_market; }
+
         void Update();
 
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -159,6 +251,7 @@ class AuctionHouseObject
         AuctionEntry* AddAuctionByGuid(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout, uint32 lowguid);
     private:
         AuctionEntryMap AuctionsMap;
+        AuctionMarketSnapshot m_market;
 };
 
 class AuctionSorter
@@ -228,6 +321,8 @@ class AuctionHouseMgr
 
         void Update();
 
+        void SetMarketTrackedOwner(uint32 owner);
+
     private:
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
@@ -76,10 +76,11 @@ class Camera
         void UpdateForCurrentViewPoint();
 
     public:
-        GridReference<Camera>& GetGridRef() { return m_gridRef; }
+        GridObjectRef& GetGridRef() { return m_gridRef; }
+        void BuildGridMirror(GridObjectMirror& /*mirror*/) const {}    // cameras are not prefiltered, mirror stays zeroed
         bool isActiveObject() const { return false; }
     private:
-        GridReference<Camera> m_gridRef;
+        GridObjectRef m_gridRef;
 };
 
 /// Object-observer, notifies farsight object state to cameras that attached to it
@@ -89,12 +89,8 @@ class Corpse : public WorldObject
         Player* lootRecipient;
         bool lootForBody;
 
-        GridReference<Corpse>& GetGridRef() { return m_gridRef; }
-
         bool IsExpired(time_t t) const;
     private:
-        GridReference<Corpse> m_gridRef;
-
         CorpseType m_type;
         time_t m_time;
         GridPair m_grid;                                    // gride for corpse position for fast search
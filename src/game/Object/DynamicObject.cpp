@@ -49,7 +49,7 @@ void DynamicObject::AddToWorld()
         GetMap()->GetObjectsStore().insert<DynamicObject>(GetObjectGuid(), (DynamicObject*)this);
     }
 
-    Object::AddToWorld();
+    WorldObject::AddToWorld();
 }
 
 void DynamicObject::RemoveFromWorld()
@@ -61,7 +61,7 @@ void DynamicObject::RemoveFromWorld()
         GetViewPoint().Event_RemovedFromWorld();
     }
 
-    Object::RemoveFromWorld();
+    WorldObject::RemoveFromWorld();
 }
 
 bool DynamicObject::Create(uint32 guidlow, Unit* caster, uint32 spellId, SpellEffectIndex effIndex, float x, float y, float z, int32 duration, float radius, DynamicObjectType type)
@@ -72,8 +72,6 @@ class DynamicObject : public WorldObject
 
         bool IsVisibleForInState(Player const* u, WorldObject const* viewPoint, bool inVisibleList) const override;
 
-        GridReference<DynamicObject>& GetGridRef() { return m_gridRef; }
-
     protected:
         uint32 m_spellId;
         SpellEffectIndex m_effIndex;
@@ -81,7 +79,5 @@ class DynamicObject : public WorldObject
         float m_radius;                                     // radius apply persistent effect, 0 = no persistent effect
         bool m_positive;
         GuidSet m_affected;
-    private:
-        GridReference<DynamicObject> m_gridRef;
 };
 #endif
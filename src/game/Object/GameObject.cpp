@@ -117,9 +117,9 @@ void GameObject::AddToWorld()
         GetMap()->InsertGameObjectModel(*m_model);
     }
 
-    Object::AddToWorld();
+    WorldObject::AddToWorld();
 
-    // After Object::AddToWorld so that for initial state the GO is added to the world (and hence handled correctly)
+    // After WorldObject::AddToWorld so that for initial state the GO is added to the world (and hence handled correctly)
     UpdateCollisionState();
 
 #ifdef ENABLE_ELUNA
@@ -173,7 +173,7 @@ void GameObject::RemoveFromWorld()
         GetMap()->GetObjectsStore().erase<GameObject>(GetObjectGuid(), (GameObject*)NULL);
     }
 
-    Object::RemoveFromWorld();
+    WorldObject::RemoveFromWorld();
 }
 
 void GameObject::CleanupsBeforeDelete()
@@ -2127,6 +2127,11 @@ void GameObject::SetQuaternion(G3D::Quat const& q)
     if (m_model)
     {
         m_model->UpdateRotation(q);
+        // bounds changed, the dynamic tree has to refit the model
+        if (IsInWorld() && GetMap()->ContainsGameObjectModel(*m_model))
+        {
+            GetMap()->RelocateGameObjectModel(*m_model);
+        }
     }
 }
 
@@ -2389,6 +2394,7 @@ void GameObject::UpdateCollisionState() const
     }
 
     m_model->SetCollidable(IsCollisionEnabled());
+    GetMap()->InvalidateQueryCache();
 }
 
 void GameObject::UpdateModel()
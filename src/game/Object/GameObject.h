@@ -748,8 +748,6 @@ class GameObject : public WorldObject
 
         GameObjectAI* AI() const { return m_AI.get(); }
 
-        GridReference<GameObject>& GetGridRef() { return m_gridRef; }
-
         GameObjectModel* m_model;
 
     protected:
@@ -800,8 +798,6 @@ class GameObject : public WorldObject
         void TickCapturePoint();
         void UpdateModel();                                 // updates model in case displayId were changed
         void UpdateCollisionState() const;                  // updates state in Map's dynamic collision tree
-
-        GridReference<GameObject> m_gridRef;
 };
 
 #endif
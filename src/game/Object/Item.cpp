@@ -29,6 +29,7 @@
 #include "Database/DatabaseEnv.h"
 #include "ItemEnchantmentMgr.h"
 #include "SQLStorages.h"
+#include "World.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
@@ -376,14 +377,11 @@ void Item::SaveToDB()
             SqlStatement stmt = CharacterDatabase.CreateStatement(delItem, "DELETE FROM `item_instance` WHERE `guid` = ?");
             stmt.PExecute(guid);
 
-            std::ostringstream ss;
-            for (uint16 i = 0; i < m_valuesCount; ++i)
-            {
-                ss << GetUInt32Value(i) << " ";
-            }
+            std::string data;
+            SaveValues(data, sWorld.getConfig(CONFIG_BOOL_COMPACT_UPDATE_FIELDS));
 
             stmt = CharacterDatabase.CreateStatement(insItem, "INSERT INTO `item_instance` (`guid`,`owner_guid`,`data`,`text`) VALUES (?, ?, ?, ?)");
-            stmt.PExecute(guid, GetOwnerGuid().GetCounter(), ss.str().c_str(), m_text.c_str());
+            stmt.PExecute(guid, GetOwnerGuid().GetCounter(), data.c_str(), m_text.c_str());
         } break;
         case ITEM_CHANGED:
         {
@@ -394,13 +392,10 @@ void Item::SaveToDB()
 
             SqlStatement stmt = CharacterDatabase.CreateStatement(updInstance, "UPDATE `item_instance` SET `data` = ?, `owner_guid` = ?, `text` = ? WHERE `guid` = ?");
 
-            std::ostringstream ss;
-            for (uint16 i = 0; i < m_valuesCount; ++i)
-            {
-                ss << GetUInt32Value(i) << " ";
-            }
+            std::string data;
+            SaveValues(data, sWorld.getConfig(CONFIG_BOOL_COMPACT_UPDATE_FIELDS));
 
-            stmt.PExecute(ss.str().c_str(), GetOwnerGuid().GetCounter(), m_text.c_str(), guid);
+            stmt.PExecute(data.c_str(), GetOwnerGuid().GetCounter(), m_text.c_str(), guid);
 
             if (HasFlag(ITEM_FIELD_FLAGS, ITEM_DYNFLAG_WRAPPED))
             {
@@ -592,13 +587,10 @@ bool Item::LoadFromDB(uint32 guidLow, Field* fields, ObjectGuid ownerGuid)
 
         SqlStatement stmt = CharacterDatabase.CreateStatement(updItem, "UPDATE `item_instance` SET `data` = ?, `owner_guid` = ? WHERE `guid` = ?");
 
-        std::ostringstream ss;
-        for (uint16 i = 0; i < m_valuesCount; ++i)
-        {
-            ss << GetUInt32Value(i) << " ";
-        }
+        std::string data;
+        SaveValues(data, sWorld.getConfig(CONFIG_BOOL_COMPACT_UPDATE_FIELDS));
 
-        stmt.addString(ss);
+        stmt.addString(data);
         stmt.addUInt32(GetOwnerGuid().GetCounter());
         stmt.addUInt32(guidLow);
         stmt.Execute();
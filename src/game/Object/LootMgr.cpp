@@ -121,12 +121,20 @@ void LootStore::LoadLootTable()
     // Clearing store (for reloading case)
     Clear();
 
-    //                                                 0      1     2                    3        4              5         6
-    QueryResult* result = WorldDatabase.PQuery("SELECT `entry`, `item`, `ChanceOrQuestChance`, `groupid`, `mincountOrRef`, `maxcount`, `condition_id` FROM `%s`", GetName());
+    // rows are streamed, so the total for the progress bar is counted first
+    uint32 rowCount = 0;
+    if (QueryResult* countResult = WorldDatabase.PQuery("SELECT COUNT(*) FROM `%s`", GetName()))
+    {
+        rowCount = countResult->Fetch()[0].GetUInt32();
+        delete countResult;
+    }
+
+    //                                                         0      1     2                    3        4              5         6
+    QueryResult* result = WorldDatabase.PQueryStreamed("SELECT `entry`, `item`, `ChanceOrQuestChance`, `groupid`, `mincountOrRef`, `maxcount`, `condition_id` FROM `%s`", GetName());
 
     if (result)
     {
-        BarGoLink bar(result->GetRowCount());
+        BarGoLink bar(rowCount);
 
         do
         {
@@ -0,0 +1,146 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#ifndef MANGOS_H_MAPOBJECTHANDLE
+#define MANGOS_H_MAPOBJECTHANDLE
+
+#include "Common.h"
+
+#include <vector>
+
+class WorldObject;
+
+/**
+ * @brief compact reference to a world object registered in a map slot table
+ *
+ * A handle is only meaningful for the map which issued it. Once the object
+ * leaves the map its slot generation is bumped, so stale handles resolve to
+ * NULL instead of to whatever object reuses the slot later.
+ */
+class MapObjectHandle
+{
+        friend class MapObjectSlotTable;
+
+    public:
+        MapObjectHandle() : m_index(0), m_generation(0) {}
+
+        bool IsEmpty() const { return m_generation == 0; }
+        void Clear() { m_index = 0; m_generation = 0; }
+
+        uint32 GetIndex() const { return m_index; }
+        uint32 GetGeneration() const { return m_generation; }
+
+        bool operator==(MapObjectHandle const& other) const { return m_index == other.m_index && m_generation == other.m_generation; }
+        bool operator!=(MapObjectHandle const& other) const { return !(*this == other); }
+
+    private:
+        MapObjectHandle(uint32 index, uint32 generation) : m_index(index), m_generation(generation) {}
+
+        uint32 m_index;
+        uint32 m_generation;                                // 0 for empty handle, never used by a live slot
+};
+
+/**
+ * @brief per map table of world objects addressed by MapObjectHandle
+ *
+ * Resolving a handle is a bounds check and a generation compare, no hashing.
+ * Freed slots are kept in an intrusive free list and reused, so the table
+ * stays as large as the peak object count of the map. Like the map object
+ * store it is only used from the thread updating the map.
+ */
+class MapObjectSlotTable
+{
+    public:
+        MapObjectSlotTable() : m_freeHead(NO_FREE_SLOT), m_count(0) {}
+
+        MapObjectHandle Insert(WorldObject* obj)
+        {
+            uint32 index;
+            if (m_freeHead != NO_FREE_SLOT)
+            {
+                index = m_freeHead;
+                m_freeHead = m_slots[index].nextFree;
+            }
+            else
+            {
+                index = uint32(m_slots.size());
+                m_slots.push_back(Slot());
+            }
+
+            Slot& slot = m_slots[index];
+            slot.object = obj;
+            slot.nextFree = NO_FREE_SLOT;
+            ++m_count;
+            return MapObjectHandle(index, slot.generation);
+        }
+
+        void Erase(MapObjectHandle const& handle)
+        {
+            if (!Find(handle))
+            {
+                return;
+            }
+
+            Slot& slot = m_slots[handle.m_index];
+            slot.object = NULL;
+            if (++slot.generation == 0)                     // keep 0 reserved for empty handles
+            {
+                slot.generation = 1;
+            }
+            slot.nextFree = m_freeHead;
+            m_freeHead = handle.m_index;
+            --m_count;
+        }
+
+        WorldObject* Find(MapObjectHandle const& handle) const
+        {
+            if (handle.m_index >= m_slots.size())
+            {
+                return NULL;
+            }
+
+            Slot const& slot = m_slots[handle.m_index];
+            return slot.generation == handle.m_generation ? slot.object : NULL;
+        }
+
+        uint32 GetCount() const { return m_count; }
+        uint32 GetCapacity() const { return uint32(m_slots.size()); }
+
+    private:
+        enum { NO_FREE_SLOT = 0xFFFFFFFF };
+
+        struct Slot
+        {
+            Slot() : object(NULL), generation(1), nextFree(NO_FREE_SLOT) {}
+
+            WorldObject* object;
+            uint32 generation;
+            uint32 nextFree;
+        };
+
+        std::vector<Slot> m_slots;
+        uint32 m_freeHead;
+        uint32 m_count;
+};
+
+#endif
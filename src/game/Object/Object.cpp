@@ -34,6 +34,7 @@
 #include "ObjectGuid.h"
 #include "UpdateData.h"
 #include "UpdateMask.h"
+#include "UpdateFieldBlob.h"
 #include "Util.h"
 #include "MapManager.h"
 #include "CellImpl.h"
@@ -659,21 +660,12 @@ bool Object::LoadValues(const char* data)
         _InitValues();
     }
 
-    Tokens tokens = StrSplit(data, " ");
-
-    if (tokens.size() != m_valuesCount)
-    {
-        return false;
-    }
-
-    Tokens::iterator iter;
-    int index;
-    for (iter = tokens.begin(), index = 0; index < m_valuesCount; ++iter, ++index)
-    {
-        m_uint32Values[index] = atol((*iter).c_str());
-    }
+    return UpdateFieldBlob::Decode(data, m_uint32Values, m_valuesCount) == m_valuesCount;
+}
 
-    return true;
+void Object::SaveValues(std::string& data, bool compact) const
+{
+    UpdateFieldBlob::Encode(data, m_uint32Values, m_valuesCount, compact);
 }
 
 void Object::_SetUpdateBits(UpdateMask* updateMask, Player* /*target*/) const
@@ -1046,6 +1038,7 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_position.y = y;
     m_position.z = z;
     m_position.o = MapManager::NormalizeOrientation(orientation);
+    m_gridRef.SetMirrorPosition(x, y);
 
     if (isType(TYPEMASK_UNIT))
     {
@@ -1058,6 +1051,7 @@ void WorldObject::Relocate(float x, float y, float z)
     m_position.x = x;
     m_position.y = y;
     m_position.z = z;
+    m_gridRef.SetMirrorPosition(x, y);
 
     if (isType(TYPEMASK_UNIT))
     {
@@ -1065,6 +1059,14 @@ void WorldObject::Relocate(float x, float y, float z)
     }
 }
 
+void WorldObject::BuildGridMirror(GridObjectMirror& mirror) const
+{
+    mirror.x = m_position.x;
+    mirror.y = m_position.y;
+    mirror.radius = GetObjectBoundingRadius();
+    mirror.flags = isType(TYPEMASK_UNIT) && ((Unit const*)this)->IsAlive() ? GRID_MIRROR_ALIVE : 0;
+}
+
 void WorldObject::SetOrientation(float orientation)
 {
     m_position.o = MapManager::NormalizeOrientation(orientation);
@@ -1675,6 +1677,11 @@ void WorldObject::SendMessageToSetExcept(WorldPacket* data, Player const* skippe
 void WorldObject::SetMap(Map* map)
 {
     MANGOS_ASSERT(map);
+    if (map != m_currMap)
+    {
+        ReleaseMapHandle();
+    }
+
     m_currMap = map;
     // lets save current map's Id/instanceId
     m_mapId = map->GetId();
@@ -1683,9 +1690,44 @@ void WorldObject::SetMap(Map* map)
 
 void WorldObject::ResetMap()
 {
+    ReleaseMapHandle();
     m_currMap = NULL;
 }
 
+void WorldObject::AddToWorld()
+{
+    ///- Register in the map slot table for handle lookup
+    if (!IsInWorld() && m_currMap && m_mapHandle.IsEmpty())
+    {
+        m_mapHandle = m_currMap->GetObjectSlots().Insert(this);
+    }
+
+    Object::AddToWorld();
+}
+
+void WorldObject::RemoveFromWorld()
+{
+    ReleaseMapHandle();
+
+    Object::RemoveFromWorld();
+}
+
+void WorldObject::ReleaseMapHandle()
+{
+    if (m_mapHandle.IsEmpty())
+    {
+        return;
+    }
+
+    // handles left over from a map we already left are only dropped
+    if (m_currMap)
+    {
+        m_currMap->GetObjectSlots().Erase(m_mapHandle);
+    }
+
+    m_mapHandle.Clear();
+}
+
 TerrainInfo const* WorldObject::GetTerrain() const
 {
     MANGOS_ASSERT(m_currMap);
@@ -1952,29 +1994,14 @@ void WorldObject::GetNearPoint(WorldObject const* searcher, float& x, float& y,
     // set first used pos in lists
     selector.InitializeAngle();
 
-    float angle;                                            // candidate of angle for free pos
-
-    // select in positions after current nodes (selection one by one)
-    while (selector.NextAngle(angle))                       // angle for free pos
+    // select in positions after current nodes
+    if (SelectNearPoint(searcher, selector, false, distance2d, absAngle, dist, x, y, z))
     {
-        GetNearPoint2D(x, y, distance2d, absAngle + angle);
-        z = GetPositionZ();
-
-        if (searcher)
-        {
-            searcher->UpdateAllowedPositionZ(x, y, z, GetMap());       // update to LOS height if available
-        }
-        else
-        {
-            UpdateGroundPositionZ(x, y, z);
-        }
-
-        if (fabs(init_z - z) < dist && IsWithinLOS(x, y, z))
-        {
-            return;
-        }
+        return;
     }
 
+    z = init_z;
+
     // BAD NEWS: not free pos (or used or have LOS problems)
     // Attempt find _used_ pos without LOS problem
     if (!first_los_conflict)
@@ -1996,30 +2023,16 @@ void WorldObject::GetNearPoint(WorldObject const* searcher, float& x, float& y,
     // set first used pos in lists
     selector.InitializeAngle();
 
-    // select in positions after current nodes (selection one by one)
-    while (selector.NextUsedAngle(angle))                   // angle for used pos but maybe without LOS problem
+    // select in positions after current nodes, used pos but maybe without LOS problem
+    if (SelectNearPoint(searcher, selector, true, distance2d, absAngle, dist, x, y, z))
     {
-        GetNearPoint2D(x, y, distance2d, absAngle + angle);
-        z = GetPositionZ();
-
-        if (searcher)
-        {
-            searcher->UpdateAllowedPositionZ(x, y, z, GetMap());       // update to LOS height if available
-        }
-        else
-        {
-            UpdateGroundPositionZ(x, y, z);
-        }
-
-        if (fabs(init_z - z) < dist && IsWithinLOS(x, y, z))
-        {
-            return;
-        }
+        return;
     }
 
     // BAD BAD NEWS: all found pos (free and used) have LOS problem :(
     x = first_x;
     y = first_y;
+    z = init_z;
 
     if (searcher)
     {
@@ -2031,6 +2044,69 @@ void WorldObject::GetNearPoint(WorldObject const* searcher, float& x, float& y,
     }
 }
 
+bool WorldObject::SelectNearPoint(WorldObject const* searcher, ObjectPosSelector& selector, bool usedAngles, float distance2d, float absAngle, float maxZDiff, float& x, float& y, float& z) const
+{
+    const float init_z = GetPositionZ();
+
+    // the first candidate is tried alone, the next ones are built and their ground queried a few at
+    // a time only if it failed; a searcher queries its own height per candidate, so it goes one by one
+    enum { NEAR_POINT_BATCH = 4 };
+    float c_x[NEAR_POINT_BATCH];
+    float c_y[NEAR_POINT_BATCH];
+    float c_z[NEAR_POINT_BATCH];
+    float ground[NEAR_POINT_BATCH];
+
+    float angle;
+    uint32 chunk = 1;
+    bool moreAngles = true;
+    while (moreAngles)
+    {
+        uint32 count = 0;
+        while (count < chunk && (moreAngles = usedAngles ? selector.NextUsedAngle(angle) : selector.NextAngle(angle)))
+        {
+            GetNearPoint2D(c_x[count], c_y[count], distance2d, absAngle + angle);
+            c_z[count] = init_z;
+            ++count;
+        }
+
+        if (!count)
+        {
+            break;
+        }
+
+        // a searcher picks its own allowed height (swim, fly, LOS), the plain ground is only needed without one
+        if (!searcher)
+        {
+            GetMap()->GetHeights(count, c_x, c_y, c_z, ground);
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float cz = init_z;
+            if (searcher)
+            {
+                searcher->UpdateAllowedPositionZ(c_x[i], c_y[i], cz, GetMap());   // update to LOS height if available
+            }
+            else if (ground[i] > INVALID_HEIGHT)
+            {
+                cz = ground[i] + 0.05f;                     // same as UpdateGroundPositionZ
+            }
+
+            if (fabs(init_z - cz) < maxZDiff && IsWithinLOS(c_x[i], c_y[i], cz))
+            {
+                x = c_x[i];
+                y = c_y[i];
+                z = cz;
+                return true;
+            }
+        }
+
+        chunk = searcher ? 1 : NEAR_POINT_BATCH;
+    }
+
+    return false;
+}
+
 void WorldObject::PlayDistanceSound(uint32 sound_id, Player const* target /*= NULL*/) const
 {
     WorldPacket data(SMSG_PLAY_OBJECT_SOUND, 4 + 8);
@@ -2125,7 +2201,7 @@ struct WorldObjectChangeAccumulator
         }
     }
 
-    template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+    template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
 };
 
 void WorldObject::BuildUpdateData(UpdateDataMapType& update_players)
@@ -31,6 +31,7 @@
 #include "UpdateData.h"
 #include "ObjectGuid.h"
 #include "Camera.h"
+#include "MapObjectHandle.h"
 #include "GameTime.h"
 #ifdef ENABLE_ELUNA
 #include "LuaValue.h"
@@ -85,6 +86,7 @@ class LuaVal;
 #endif /* ENABLE_ELUNA */
 class TransportInfo;
 struct MangosStringLocale;
+struct ObjectPosSelector;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
@@ -434,6 +436,7 @@ class Object
         void ClearUpdateMask(bool remove);
 
         bool LoadValues(const char* data);
+        void SaveValues(std::string& data, bool compact) const;
 
         uint16 GetValuesCount() const { return m_valuesCount; }
 
@@ -676,6 +679,17 @@ class WorldObject : public Object
         // used to check all object's GetMap() calls when object is not in world!
         void ResetMap();
 
+        void AddToWorld() override;
+        void RemoveFromWorld() override;
+
+        // slot in current map's object table, empty while not in world
+        MapObjectHandle const& GetMapHandle() const { return m_mapHandle; }
+
+        // membership in the per type object list of the cell
+        GridObjectRef& GetGridRef() { return m_gridRef; }
+        // hot state stored next to the object in the cell list, see GridObjectMirror
+        void BuildGridMirror(GridObjectMirror& mirror) const;
+
         // obtain terrain data for map where this object belong...
         TerrainInfo const* GetTerrain() const;
 
@@ -717,12 +731,19 @@ class WorldObject : public Object
 
         virtual void StopGroupLoot() {}
 
+        void ReleaseMapHandle();
+
+        // first free (or used) selector angle giving a spot on allowed height within maxZDiff and in LoS
+        bool SelectNearPoint(WorldObject const* searcher, ObjectPosSelector& selector, bool usedAngles, float distance2d, float absAngle, float maxZDiff, float& x, float& y, float& z) const;
+
         std::string m_name;
 
         TransportInfo* m_transportInfo;
 
     private:
         Map* m_currMap;                                     // current object's Map location
+        MapObjectHandle m_mapHandle;                        // slot in m_currMap object table
+        GridObjectRef m_gridRef;
 
         uint32 m_mapId;                                     // object at map with map_id
         uint32 m_InstanceId;                                // in map copy with instance id
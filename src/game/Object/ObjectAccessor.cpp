@@ -34,6 +34,7 @@
 #include "GridNotifiersImpl.h"
 #include "ObjectGuid.h"
 #include "World.h"
+#include "WorldTaskMgr.h"
 
 #include <algorithm>
 
@@ -108,13 +109,10 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    ACE_READ_GUARD_RETURN(HashMapHolder<Player>::LockType, guard, i_playerMap.GetLock(), nullptr)
-    for (auto& iter : i_playerMap.GetContainer())
-        if (iter.second->IsInWorld() && (::strcmp(name, iter.second->GetName()) == 0))
-        {
-            return iter.second;
-        }
-    return nullptr;
+    return i_playerMap.FindIf([name](Player* player)
+    {
+        return player->IsInWorld() && ::strcmp(name, player->GetName()) == 0;
+    });
 }
 
 //This method should not be here
@@ -289,6 +287,61 @@ Corpse* ObjectAccessor::ConvertCorpseForPlayer(ObjectGuid player_guid, bool insi
     return bones;
 }
 
+/// Expired corpses turned into bones a few per world update
+class RemoveOldCorpsesTask : public WorldTask
+{
+    public:
+        RemoveOldCorpsesTask() : WorldTask("Removing old corpses", sWorld.getConfig(CONFIG_UINT32_TASK_BUDGET_OLD_CORPSES)), m_now(time(nullptr)) {}
+
+    protected:
+        bool Start() override
+        {
+            sObjectAccessor.GetExpiredCorpseOwners(m_now, m_owners);
+            SetTotal(uint32(m_owners.size()));
+            return !m_owners.empty();
+        }
+
+        bool Step() override
+        {
+            if (m_owners.empty())
+            {
+                return false;
+            }
+
+            // the corpse may be gone already (resurrection, bones)
+            ObjectGuid owner = m_owners.back();
+            m_owners.pop_back();
+            Corpse* corpse = sObjectAccessor.GetCorpseForPlayerGUID(owner);
+            if (corpse && corpse->IsExpired(m_now))
+            {
+                sObjectAccessor.ConvertCorpseForPlayer(owner);
+            }
+            return true;
+        }
+
+    private:
+        time_t m_now;
+        std::vector<ObjectGuid> m_owners;
+};
+
+void ObjectAccessor::GetExpiredCorpseOwners(time_t now, std::vector<ObjectGuid>& owners)
+{
+    ACE_GUARD(LockType, guard, i_corpseGuard)
+
+    for (Player2CorpsesMapType::const_iterator itr = i_player2corpse.begin(); itr != i_player2corpse.end(); ++itr)
+    {
+        if (itr->second->IsExpired(now))
+        {
+            owners.push_back(itr->first);
+        }
+    }
+}
+
+void ObjectAccessor::QueueRemoveOldCorpses()
+{
+    sWorldTaskMgr.AddTask(new RemoveOldCorpsesTask());
+}
+
 void ObjectAccessor::RemoveOldCorpses()
 {
     time_t now = time(nullptr);
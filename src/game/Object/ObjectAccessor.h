@@ -36,7 +36,10 @@
 #include "Player.h"
 #include "Corpse.h"
 
+#include <ace/Thread_Mutex.h>
+#include <atomic>
 #include <unordered_map>
+#include <vector>
 
 class Unit;
 class WorldObject;
@@ -51,40 +54,296 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         ObjectAccessor(const ObjectAccessor&);
         ObjectAccessor& operator=(const ObjectAccessor&);
 
+        // Read-mostly guid -> object table, split in shards by guid counter.
+        // Each shard is an open addressed array guarded by a sequence lock:
+        // readers never take a mutex or touch a shared reference count, they
+        // read the slots and retry only if a writer changed the shard meanwhile.
+        // Writers serialize on the shard mutex and change slots in place. A
+        // table replaced by a bigger one is kept until the holder is destroyed,
+        // because a reader may still be probing it; growth is geometric, so
+        // the retired tables never add up to more than the current one.
         template <class T>
         struct HashMapHolder
         {
-            using MapType = std::unordered_map<ObjectGuid, T*>;
-            using LockType = ACE_RW_Thread_Mutex;
+            using LockType = ACE_Thread_Mutex;
 
-            HashMapHolder() : i_lock(nullptr), m_objectMap() {}
+            static const uint32 SHARD_COUNT = 32;
+            static const uint32 INITIAL_CAPACITY = 64;      // power of 2
+
+            static const uint64 EMPTY_KEY = 0;
+            static const uint64 REMOVED_KEY = ~uint64(0);
+
+            struct Table
+            {
+                explicit Table(uint32 capacity) : m_capacity(capacity), m_keys(new std::atomic<uint64>[capacity]), m_values(new std::atomic<T*>[capacity])
+                {
+                    for (uint32 i = 0; i < capacity; ++i)
+                    {
+                        m_keys[i].store(EMPTY_KEY, std::memory_order_relaxed);
+                        m_values[i].store(nullptr, std::memory_order_relaxed);
+                    }
+                }
+
+                ~Table()
+                {
+                    delete[] m_keys;
+                    delete[] m_values;
+                }
+
+                uint32 m_capacity;
+                std::atomic<uint64>* m_keys;
+                std::atomic<T*>* m_values;
+            };
+
+            struct Shard
+            {
+                Shard() : m_sequence(0), m_table(new Table(INITIAL_CAPACITY)), m_used(0), m_count(0) {}
+
+                ~Shard()
+                {
+                    delete m_table.load(std::memory_order_relaxed);
+                    for (typename std::vector<Table*>::const_iterator itr = m_retired.begin(); itr != m_retired.end(); ++itr)
+                    {
+                        delete *itr;
+                    }
+                }
+
+                std::atomic<uint32> m_sequence;             // odd while a writer changes the shard
+                std::atomic<Table*> m_table;
+                LockType i_lock;                            // serializes writers only
+                uint32 m_used;                              // slots holding a key or REMOVED_KEY
+                uint32 m_count;                             // slots holding a key
+                std::vector<Table*> m_retired;
+                char _cache_guard[64];
+            };
 
             void Insert(T* o)
             {
-                ACE_WRITE_GUARD(LockType, guard, i_lock)
-                m_objectMap[o->GetObjectGuid()] = o;
+                uint64 key = o->GetObjectGuid().GetRawValue();
+                Shard& shard = GetShard(o->GetObjectGuid());
+                ACE_GUARD(LockType, guard, shard.i_lock)
+
+                BeginWrite(shard);
+                Table* table = shard.m_table.load(std::memory_order_relaxed);
+                int32 slot = FindSlot(*table, key);
+                if (slot >= 0)
+                {
+                    table->m_values[slot].store(o, std::memory_order_relaxed);
+                }
+                else
+                {
+                    if ((shard.m_used + 1) * 4 > table->m_capacity * 3)
+                    {
+                        table = Rehash(shard);
+                    }
+
+                    uint32 mask = table->m_capacity - 1;
+                    uint32 i = Hash(key) & mask;
+                    uint64 cur = table->m_keys[i].load(std::memory_order_relaxed);
+                    while (cur != EMPTY_KEY && cur != REMOVED_KEY)
+                    {
+                        i = (i + 1) & mask;
+                        cur = table->m_keys[i].load(std::memory_order_relaxed);
+                    }
+
+                    if (cur == EMPTY_KEY)
+                    {
+                        ++shard.m_used;
+                    }
+
+                    ++shard.m_count;
+                    table->m_values[i].store(o, std::memory_order_relaxed);
+                    table->m_keys[i].store(key, std::memory_order_relaxed);
+                }
+                EndWrite(shard);
             }
 
             void Remove(T* o)
             {
-                ACE_WRITE_GUARD(LockType, guard, i_lock)
-                m_objectMap.erase(o->GetObjectGuid());
+                uint64 key = o->GetObjectGuid().GetRawValue();
+                Shard& shard = GetShard(o->GetObjectGuid());
+                ACE_GUARD(LockType, guard, shard.i_lock)
+
+                Table* table = shard.m_table.load(std::memory_order_relaxed);
+                int32 slot = FindSlot(*table, key);
+                if (slot < 0)
+                {
+                    return;
+                }
+
+                BeginWrite(shard);
+                table->m_keys[slot].store(REMOVED_KEY, std::memory_order_relaxed);
+                table->m_values[slot].store(nullptr, std::memory_order_relaxed);
+                --shard.m_count;
+                EndWrite(shard);
             }
 
             T* Find(ObjectGuid guid)
             {
-                ACE_READ_GUARD_RETURN (LockType, guard, i_lock, nullptr)
-                auto itr = m_objectMap.find(guid);
-                return (itr != m_objectMap.end()) ? itr->second : nullptr;
+                uint64 key = guid.GetRawValue();
+                Shard& shard = GetShard(guid);
+                for (;;)
+                {
+                    uint32 seq = shard.m_sequence.load(std::memory_order_acquire);
+                    if (seq & 1)
+                    {
+                        continue;                           // writer in progress, it only holds the shard for a few stores
+                    }
+
+                    Table const* table = shard.m_table.load(std::memory_order_acquire);
+                    int32 slot = FindSlot(*table, key);
+                    T* result = slot >= 0 ? table->m_values[slot].load(std::memory_order_relaxed) : nullptr;
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (shard.m_sequence.load(std::memory_order_relaxed) == seq)
+                    {
+                        return result;
+                    }
+                }
+            }
+
+            // f returns true to stop; it is called on a copy of each shard taken when the shard is reached,
+            // so it may itself insert or remove objects
+            template<typename F>
+            T* FindIf(F&& f)
+            {
+                std::vector<T*> objects;
+                for (uint32 i = 0; i < SHARD_COUNT; ++i)
+                {
+                    Snapshot(m_shards[i], objects);
+                    for (typename std::vector<T*>::const_iterator itr = objects.begin(); itr != objects.end(); ++itr)
+                    {
+                        if (f(*itr))
+                        {
+                            return *itr;
+                        }
+                    }
+                }
+                return nullptr;
+            }
+
+            inline Shard& GetShard(ObjectGuid guid) { return m_shards[guid.GetCounter() % SHARD_COUNT]; }
+
+            Shard m_shards[SHARD_COUNT];
+
+        private:
+            static uint32 Hash(uint64 key)
+            {
+                key *= UI64LIT(0x9E3779B97F4A7C15);
+                return uint32(key >> 32);
+            }
+
+            // slot of key or -1, probing stops at the first empty slot
+            static int32 FindSlot(Table const& table, uint64 key)
+            {
+                uint32 mask = table.m_capacity - 1;
+                uint32 i = Hash(key) & mask;
+                for (uint32 probes = 0; probes < table.m_capacity; ++probes)
+                {
+                    uint64 cur = table.m_keys[i].load(std::memory_order_relaxed);
+                    if (cur == key)
+                    {
+                        return int32(i);
+                    }
+
+                    if (cur == EMPTY_KEY)
+                    {
+                        break;
+                    }
+
+                    i = (i + 1) & mask;
+                }
+                return -1;
+            }
+
+            static void BeginWrite(Shard& shard)
+            {
+                shard.m_sequence.store(shard.m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            static void EndWrite(Shard& shard)
+            {
+                shard.m_sequence.store(shard.m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
             }
 
-            inline MapType& GetContainer() { return m_objectMap; }
-            inline LockType& GetLock() { return i_lock; }
+            // called inside BeginWrite/EndWrite: drops removed slots in place, or moves to a table twice
+            // as big when the live objects fill half of it
+            static Table* Rehash(Shard& shard)
+            {
+                Table* table = shard.m_table.load(std::memory_order_relaxed);
 
-            LockType i_lock;
-            MapType  m_objectMap;
-            char _cache_guard[512];
+                std::vector<std::pair<uint64, T*> > live;
+                live.reserve(shard.m_count);
+                for (uint32 i = 0; i < table->m_capacity; ++i)
+                {
+                    uint64 key = table->m_keys[i].load(std::memory_order_relaxed);
+                    if (key != EMPTY_KEY && key != REMOVED_KEY)
+                    {
+                        live.push_back(std::make_pair(key, table->m_values[i].load(std::memory_order_relaxed)));
+                    }
+                }
 
+                if ((shard.m_count + 1) * 2 > table->m_capacity)
+                {
+                    shard.m_retired.push_back(table);
+                    table = new Table(table->m_capacity * 2);
+                }
+                else
+                {
+                    for (uint32 i = 0; i < table->m_capacity; ++i)
+                    {
+                        table->m_keys[i].store(EMPTY_KEY, std::memory_order_relaxed);
+                        table->m_values[i].store(nullptr, std::memory_order_relaxed);
+                    }
+                }
+
+                uint32 mask = table->m_capacity - 1;
+                for (typename std::vector<std::pair<uint64, T*> >::const_iterator itr = live.begin(); itr != live.end(); ++itr)
+                {
+                    uint32 i = Hash(itr->first) & mask;
+                    while (table->m_keys[i].load(std::memory_order_relaxed) != EMPTY_KEY)
+                    {
+                        i = (i + 1) & mask;
+                    }
+
+                    table->m_values[i].store(itr->second, std::memory_order_relaxed);
+                    table->m_keys[i].store(itr->first, std::memory_order_relaxed);
+                }
+
+                shard.m_used = uint32(live.size());
+                shard.m_table.store(table, std::memory_order_release);
+                return table;
+            }
+
+            static void Snapshot(Shard& shard, std::vector<T*>& objects)
+            {
+                for (;;)
+                {
+                    objects.clear();
+
+                    uint32 seq = shard.m_sequence.load(std::memory_order_acquire);
+                    if (seq & 1)
+                    {
+                        continue;
+                    }
+
+                    Table const* table = shard.m_table.load(std::memory_order_acquire);
+                    for (uint32 i = 0; i < table->m_capacity; ++i)
+                    {
+                        if (T* object = table->m_values[i].load(std::memory_order_relaxed))
+                        {
+                            objects.push_back(object);
+                        }
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (shard.m_sequence.load(std::memory_order_relaxed) == seq)
+                    {
+                        return;
+                    }
+                }
+            }
         };
 
         using Player2CorpsesMapType = std::unordered_map<ObjectGuid, Corpse*>;
@@ -112,6 +371,9 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         void AddCorpsesToGrid(GridPair const& gridpair, GridType& grid, Map* map);
         Corpse* ConvertCorpseForPlayer(ObjectGuid player_guid, bool insignia = false);
         void RemoveOldCorpses();
+        // same as RemoveOldCorpses, spread over the next world updates
+        void QueueRemoveOldCorpses();
+        void GetExpiredCorpseOwners(time_t now, std::vector<ObjectGuid>& owners);
 
         // For call from Player/Corpse AddToWorld/RemoveFromWorld only
         void AddObject(Corpse* object) { i_corpseMap.Insert(object); }
@@ -122,14 +384,11 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         template<typename F>
         void DoForAllPlayers(F&& f)
         {
-            ACE_READ_GUARD(HashMapHolder<Player>::LockType, g, i_playerMap.GetLock())
-            for (auto& iter : i_playerMap.GetContainer())
+            i_playerMap.FindIf([&f](Player* player)
             {
-                if(iter.second != nullptr)
-                {
-                    std::forward<F>(f)(iter.second);
-                }
-            }
+                f(player);
+                return false;
+            });
         }
 
     private:
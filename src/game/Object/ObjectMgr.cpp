@@ -52,6 +52,7 @@
 #include "GridNotifiersImpl.h"
 #include "CellImpl.h"
 #include "DisableMgr.h"
+#include "WorldTaskMgr.h"
 
 #include "ItemEnchantmentMgr.h"
 #include <limits>
@@ -1430,8 +1431,17 @@ void ObjectMgr::LoadCreatureModelRace()
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult* result = WorldDatabase.Query("SELECT `creature`.`guid`, `creature`.`id`, `map`, `modelid`,"
+
+    // rows are streamed, the progress bar total comes from the spawn table
+    uint32 spawnCount = 0;
+    if (QueryResult* countResult = WorldDatabase.Query("SELECT COUNT(*) FROM `creature`"))
+    {
+        spawnCount = countResult->Fetch()[0].GetUInt32();
+        delete countResult;
+    }
+
+    //                                                        0                       1   2    3
+    QueryResult* result = WorldDatabase.QueryStreamed("SELECT `creature`.`guid`, `creature`.`id`, `map`, `modelid`,"
                           //   4             5           6           7           8            9              10         11
                           "`equipment_id`, `position_x`, `position_y`, `position_z`, `orientation`, `spawntimesecs`, `spawndist`, `currentwaypoint`,"
                           //   12         13       14          15            16         17
@@ -1461,7 +1471,7 @@ void ObjectMgr::LoadCreatures()
                 heroicCreatures.insert(cInfo->HeroicEntry);
             }
 
-    BarGoLink bar(result->GetRowCount());
+    BarGoLink bar(spawnCount);
 
     do
     {
@@ -1650,8 +1660,16 @@ void ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
 
-    //                                                           0                1              2               3                      4                      5                      6
-    QueryResult* result = WorldDatabase.Query("SELECT `gameobject`.`guid`, `gameobject`.`id`, `gameobject`.`map`, `gameobject`.`position_x`, `gameobject`.`position_y`, `gameobject`.`position_z`, `gameobject`.`orientation`, "
+    // rows are streamed, the progress bar total comes from the spawn table
+    uint32 spawnCount = 0;
+    if (QueryResult* countResult = WorldDatabase.Query("SELECT COUNT(*) FROM `gameobject`"))
+    {
+        spawnCount = countResult->Fetch()[0].GetUInt32();
+        delete countResult;
+    }
+
+    //                                                                   0                1              2               3                      4                      5                      6
+    QueryResult* result = WorldDatabase.QueryStreamed("SELECT `gameobject`.`guid`, `gameobject`.`id`, `gameobject`.`map`, `gameobject`.`position_x`, `gameobject`.`position_y`, `gameobject`.`position_z`, `gameobject`.`orientation`, "
                           //             7                         8                         9                         10                        11                            12                           13                    14
                           "`gameobject`.`rotation0`, `gameobject`.`rotation1`, `gameobject`.`rotation2`, `gameobject`.`rotation3`, `gameobject`.`spawntimesecs`, `gameobject`.`animprogress`, `gameobject`.`state`, `gameobject`.`spawnMask`,"
                           //             15                      16                          17
@@ -1670,7 +1688,7 @@ void ObjectMgr::LoadGameObjects()
         return;
     }
 
-    BarGoLink bar(result->GetRowCount());
+    BarGoLink bar(spawnCount);
 
     do
     {
@@ -5085,6 +5103,48 @@ void ObjectMgr::LoadGossipTextLocales()
     sLog.outString();
 }
 
+//                                       0    1              2         3           4            5              6      7          8
+#define OLD_MAILS_QUERY "SELECT `id`,`messageType`,`sender`,`receiver`,`has_items`,`expire_time`,`cod`,`checked`,`mailTemplateId` FROM `mail` WHERE `expire_time` < '" UI64FMTD "'"
+
+/// Expired mails of a running server, returned/deleted a few per world update
+class ReturnOldMailsTask : public WorldTask
+{
+    public:
+        ReturnOldMailsTask() : WorldTask("Returning expired mails", sWorld.getConfig(CONFIG_UINT32_TASK_BUDGET_OLD_MAILS)),
+            m_basetime(time(NULL)), m_result(NULL), m_first(true) {}
+        ~ReturnOldMailsTask() { delete m_result; }
+
+    protected:
+        bool Start() override
+        {
+            m_result = CharacterDatabase.PQuery(OLD_MAILS_QUERY, m_basetime);
+            if (!m_result)
+            {
+                return false;
+            }
+
+            SetTotal(uint32(m_result->GetRowCount()));
+            return true;
+        }
+
+        bool Step() override
+        {
+            if (!m_first && !m_result->NextRow())
+            {
+                return false;
+            }
+
+            m_first = false;
+            sObjectMgr.ReturnOrDeleteOldMail(m_result->Fetch(), m_basetime, true);
+            return true;
+        }
+
+    private:
+        uint64 m_basetime;
+        QueryResult* m_result;
+        bool m_first;                                       // the result is positioned on the first row already
+};
+
 // not very fast function but it is called only once a day, or on starting-up
 /// @param serverUp true if the server is already running, false when the server is started
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
@@ -5095,13 +5155,17 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
     uint64 basetime(curTime);
     sLog.outString("Returning mails current time: hour: %d, minute: %d, second: %d ", lt.tm_hour, lt.tm_min, lt.tm_sec);
 
-    // delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
+    // running server, spread the work over the next world updates
+    if (serverUp)
     {
-        CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `expire_time` < '" UI64FMTD "' AND `has_items` = '0' AND `body` = ''", (uint64)basetime);
+        sWorldTaskMgr.AddTask(new ReturnOldMailsTask());
+        return;
     }
-    //                                                     0  1           2      3        4          5         6           7   8       9
-    QueryResult* result = CharacterDatabase.PQuery("SELECT `id`,`messageType`,`sender`,`receiver`,`has_items`,`expire_time`,`cod`,`checked`,`mailTemplateId` FROM `mail` WHERE `expire_time` < '" UI64FMTD "'", (uint64)basetime);
+
+    // delete all old mails without item and without body immediately, if starting server
+    CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `expire_time` < '" UI64FMTD "' AND `has_items` = '0' AND `body` = ''", (uint64)basetime);
+
+    QueryResult* result = CharacterDatabase.PQuery(OLD_MAILS_QUERY, (uint64)basetime);
     if (!result)
     {
         BarGoLink bar(1);
@@ -5111,99 +5175,98 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
         return;                                             // any mails need to be returned or deleted
     }
 
-    // std::ostringstream delitems, delmails; // will be here for optimization
-    // bool deletemail = false, deleteitem = false;
-    // delitems << "DELETE FROM `item_instance` WHERE `guid` IN ( ";
-    // delmails << "DELETE FROM `mail` WHERE `id` IN ( "
-
     BarGoLink bar(result->GetRowCount());
     uint32 count = 0;
-    Field* fields;
 
     do
     {
         bar.step();
 
-        fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
-        bool has_items = fields[4].GetBool();
-        m->expire_time = (time_t)fields[5].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[6].GetUInt32();
-        m->checked = fields[7].GetUInt32();
-        m->mailTemplateId = fields[8].GetInt16();
-
-        Player* pl = 0;
-        if (serverUp)
-        {
-            pl = GetPlayer(m->receiverGuid);
-        }
-        if (pl)
+        if (ReturnOrDeleteOldMail(result->Fetch(), basetime, serverUp))
         {
-            // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            // his in mailbox and he has already listed his mails )
-            delete m;
-            continue;
+            ++count;
         }
-        // delete or return mail:
-        if (has_items)
+    }
+    while (result->NextRow());
+    delete result;
+
+    sLog.outString(">> Loaded %u mails", count);
+    sLog.outString();
+}
+
+bool ObjectMgr::ReturnOrDeleteOldMail(Field* fields, uint64 basetime, bool serverUp)
+{
+    Mail* m = new Mail;
+    m->messageID = fields[0].GetUInt32();
+    m->messageType = fields[1].GetUInt8();
+    m->sender = fields[2].GetUInt32();
+    m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
+    bool has_items = fields[4].GetBool();
+    m->expire_time = (time_t)fields[5].GetUInt64();
+    m->deliver_time = 0;
+    m->COD = fields[6].GetUInt32();
+    m->checked = fields[7].GetUInt32();
+    m->mailTemplateId = fields[8].GetInt16();
+
+    Player* pl = 0;
+    if (serverUp)
+    {
+        pl = GetPlayer(m->receiverGuid);
+    }
+    if (pl)
+    {
+        // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+        // his in mailbox and he has already listed his mails )
+        delete m;
+        return false;
+    }
+    // delete or return mail:
+    if (has_items)
+    {
+        QueryResult* resultItems = CharacterDatabase.PQuery("SELECT `item_guid`,`item_template` FROM `mail_items` WHERE `mail_id`='%u'", m->messageID);
+        if (resultItems)
         {
-            QueryResult* resultItems = CharacterDatabase.PQuery("SELECT `item_guid`,`item_template` FROM `mail_items` WHERE `mail_id`='%u'", m->messageID);
-            if (resultItems)
+            do
             {
-                do
-                {
-                    Field* fields2 = resultItems->Fetch();
+                Field* fields2 = resultItems->Fetch();
 
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
+                uint32 item_guid_low = fields2[0].GetUInt32();
+                uint32 item_template = fields2[1].GetUInt32();
 
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
-
-                delete resultItems;
+                m->AddItem(item_guid_low, item_template);
             }
-            // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            while (resultItems->NextRow());
+
+            delete resultItems;
+        }
+        // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+        if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+        {
+            // mail open and then not returned
+            for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
             {
-                // mail open and then not returned
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    CharacterDatabase.PExecute("DELETE FROM `item_instance` WHERE `guid` = '%u'", itr2->item_guid);
-                }
+                CharacterDatabase.PExecute("DELETE FROM `item_instance` WHERE `guid` = '%u'", itr2->item_guid);
             }
-            else
+        }
+        else
+        {
+            // mail will be returned:
+            CharacterDatabase.PExecute("UPDATE `mail` SET `sender` = '%u', `receiver` = '%u', `expire_time` = '" UI64FMTD "', `deliver_time` = '" UI64FMTD "', `cod` = '0', `checked` = '%u' WHERE `id` = '%u'",
+                                       m->receiverGuid.GetCounter(), m->sender, (uint64)(basetime + 30 * DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
+            for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
             {
-                // mail will be returned:
-                CharacterDatabase.PExecute("UPDATE `mail` SET `sender` = '%u', `receiver` = '%u', `expire_time` = '" UI64FMTD "', `deliver_time` = '" UI64FMTD "', `cod` = '0', `checked` = '%u' WHERE `id` = '%u'",
-                                           m->receiverGuid.GetCounter(), m->sender, (uint64)(basetime + 30 * DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    CharacterDatabase.PExecute("UPDATE `mail_items` SET `receiver` = %u WHERE `item_guid` = '%u'", m->sender, itr2->item_guid);
-                    CharacterDatabase.PExecute("UPDATE `item_instance` SET `owner_guid` = %u WHERE `guid` = '%u'", m->sender, itr2->item_guid);
-                }
-                delete m;
-                continue;
+                // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+                CharacterDatabase.PExecute("UPDATE `mail_items` SET `receiver` = %u WHERE `item_guid` = '%u'", m->sender, itr2->item_guid);
+                CharacterDatabase.PExecute("UPDATE `item_instance` SET `owner_guid` = %u WHERE `guid` = '%u'", m->sender, itr2->item_guid);
             }
+            delete m;
+            return false;
         }
-
-        // deletemail = true;
-        // delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `id` = '%u'", m->messageID);
-        delete m;
-        ++count;
     }
-    while (result->NextRow());
-    delete result;
 
-    sLog.outString(">> Loaded %u mails", count);
-    sLog.outString();
+    CharacterDatabase.PExecute("DELETE FROM `mail` WHERE `id` = '%u'", m->messageID);
+    delete m;
+    return true;
 }
 
 void ObjectMgr::LoadQuestAreaTriggers()
@@ -770,6 +770,7 @@ class ObjectMgr
         }
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        bool ReturnOrDeleteOldMail(Field* fields, uint64 basetime, bool serverUp);
 
         void SetHighestGuids();
 
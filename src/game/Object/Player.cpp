@@ -32,6 +32,7 @@
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "UpdateMask.h"
+#include "UpdateFieldBlob.h"
 #include "SkillDiscovery.h"
 #include "QuestDef.h"
 #include "GossipDef.h"
@@ -69,6 +70,7 @@
 #include "DBCStores.h"
 #include "SQLStorages.h"
 #include "DisableMgr.h"
+#include "WorldTaskMgr.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
@@ -178,14 +180,13 @@ void PlayerTaxi::InitTaxiNodesForLevel(uint32 race, uint32 level)
 
 void PlayerTaxi::LoadTaxiMask(const char* data)
 {
-    Tokens tokens = StrSplit(data, " ");
+    TaxiMask mask;
+    uint32 count = std::min(UpdateFieldBlob::Decode(data, mask, TaxiMaskSize), uint32(TaxiMaskSize));
 
-    int index;
-    Tokens::iterator iter;
-    for (iter = tokens.begin(), index = 0; (index < TaxiMaskSize) && (iter != tokens.end()); ++iter, ++index)
+    for (uint32 index = 0; index < count; ++index)
     {
         // load and set bits only for existing taxi nodes
-        m_taximask[index] = sTaxiNodesMask[index] & uint32(atol((*iter).c_str()));
+        m_taximask[index] = sTaxiNodesMask[index] & mask[index];
     }
 }
 
@@ -291,6 +292,11 @@ std::ostringstream& operator<< (std::ostringstream& ss, PlayerTaxi const& taxi)
     return ss;
 }
 
+void PlayerTaxi::SaveTaxiMask(std::string& data, bool compact) const
+{
+    UpdateFieldBlob::Encode(data, m_taximask, TaxiMaskSize, compact);
+}
+
 SpellModifier::SpellModifier(SpellModOp _op, SpellModType _type, int32 _value, SpellEntry const* spellEntry, SpellEffectIndex eff, int16 _charges /*= 0*/) : op(_op), type(_type), charges(_charges), value(_value), spellId(spellEntry->Id), lastAffected(NULL)
 {
     mask = sSpellMgr.GetSpellAffectMask(spellEntry->Id, eff);
@@ -4879,6 +4885,49 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
     }
 }
 
+//                                          0       1
+#define OLD_CHARACTERS_QUERY "SELECT `guid`, `deleteInfos_Account` FROM `characters` WHERE `deleteDate` IS NOT NULL AND `deleteDate` < '" UI64FMTD "'"
+
+/// Characters deleted keepDays ago, removed from the DB a few per world update
+class DeleteOldCharactersTask : public WorldTask
+{
+    public:
+        explicit DeleteOldCharactersTask(uint32 keepDays) : WorldTask("Deleting old characters", sWorld.getConfig(CONFIG_UINT32_TASK_BUDGET_OLD_CHARACTERS)),
+            m_keepDays(keepDays), m_result(NULL), m_first(true) {}
+        ~DeleteOldCharactersTask() { delete m_result; }
+
+    protected:
+        bool Start() override
+        {
+            m_result = CharacterDatabase.PQuery(OLD_CHARACTERS_QUERY, uint64(time(NULL) - time_t(m_keepDays * DAY)));
+            if (!m_result)
+            {
+                return false;
+            }
+
+            SetTotal(uint32(m_result->GetRowCount()));
+            return true;
+        }
+
+        bool Step() override
+        {
+            if (!m_first && !m_result->NextRow())
+            {
+                return false;
+            }
+
+            m_first = false;
+            Field* charFields = m_result->Fetch();
+            Player::DeleteFromDB(ObjectGuid(HIGHGUID_PLAYER, charFields[0].GetUInt32()), charFields[1].GetUInt32(), true, true);
+            return true;
+        }
+
+    private:
+        uint32 m_keepDays;
+        QueryResult* m_result;
+        bool m_first;                                       // the result is positioned on the first row already
+};
+
 /**
  * Characters which were kept back in the database after being deleted and are now too old (see config option "CharDelete.KeepDays"), will be completely deleted.
  *
@@ -4892,7 +4941,8 @@ void Player::DeleteOldCharacters()
         return;
     }
 
-    Player::DeleteOldCharacters(keepDays);
+    // periodic cleanup of a running server, spread over the next world updates
+    sWorldTaskMgr.AddTask(new DeleteOldCharactersTask(keepDays));
 }
 
 /**
@@ -4906,7 +4956,7 @@ void Player::DeleteOldCharacters(uint32 keepDays)
 {
     sLog.outString("Player::DeleteOldChars: Deleting all characters which have been deleted %u days before...", keepDays);
 
-    QueryResult* resultChars = CharacterDatabase.PQuery("SELECT `guid`, `deleteInfos_Account` FROM `characters` WHERE `deleteDate` IS NOT NULL AND `deleteDate` < '" UI64FMTD "'", uint64(time(NULL) - time_t(keepDays * DAY)));
+    QueryResult* resultChars = CharacterDatabase.PQuery(OLD_CHARACTERS_QUERY, uint64(time(NULL) - time_t(keepDays * DAY)));
     if (resultChars)
     {
         sLog.outString("Player::DeleteOldChars: Found %u character(s) to delete", uint32(resultChars->GetRowCount()));
@@ -17149,19 +17199,13 @@ void Player::_LoadIntoDataField(const char* data, uint32 startOffset, uint32 cou
         return;
     }
 
-    Tokens tokens = StrSplit(data, " ");
-
-    if (tokens.size() != count)
+    std::vector<uint32> values(count);
+    if (UpdateFieldBlob::Decode(data, &values[0], count) != count)
     {
         return;
     }
 
-    Tokens::iterator iter;
-    uint32 index;
-    for (iter = tokens.begin(), index = 0; index < count; ++iter, ++index)
-    {
-        m_uint32Values[startOffset + index] = atol((*iter).c_str());
-    }
+    std::copy(values.begin(), values.end(), &m_uint32Values[startOffset]);
 }
 
 bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
@@ -19177,9 +19221,11 @@ void Player::SaveToDB()
         uberInsert.addFloat(finiteAlways(GetTeleportDest().orientation));
     }
 
-    std::ostringstream ss;
-    ss << m_taxi;                                   // string with TaxiMaskSize numbers
-    uberInsert.addString(ss);
+    bool compactData = sWorld.getConfig(CONFIG_BOOL_COMPACT_UPDATE_FIELDS);
+
+    std::string fieldData;
+    m_taxi.SaveTaxiMask(fieldData, compactData);    // string with TaxiMaskSize numbers
+    uberInsert.addString(fieldData);
 
     uberInsert.addUInt32(IsInWorld() ? 1 : 0);
 
@@ -19221,6 +19267,7 @@ void Player::SaveToDB()
 
     uberInsert.addUInt64(uint64(m_deathExpireTime));
 
+    std::ostringstream ss;
     ss << m_taxi.SaveTaxiDestinationsToString();       // string
     uberInsert.addString(ss);
 
@@ -19252,11 +19299,9 @@ void Player::SaveToDB()
         uberInsert.addUInt32(GetPower(Powers(i)));
     }
 
-    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i) // string
-    {
-        ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << " ";
-    }
-    uberInsert.addString(ss); // exploredZOnes
+    fieldData.clear();
+    UpdateFieldBlob::Encode(fieldData, &m_uint32Values[PLAYER_EXPLORED_ZONES_1], PLAYER_EXPLORED_ZONES_SIZE, compactData);
+    uberInsert.addString(fieldData); // exploredZOnes
 
     for (uint32 i = 0; i < EQUIPMENT_SLOT_END; ++i)         // string: item id, ench (perm/temp)
     {
@@ -19270,11 +19315,9 @@ void Player::SaveToDB()
 
     uberInsert.addUInt32(GetUInt32Value(PLAYER_AMMO_ID));
 
-    for (uint32 i = 0; i < 2; ++i)
-    {
-        ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << " ";
-    }
-    uberInsert.addString(ss);
+    fieldData.clear();
+    UpdateFieldBlob::Encode(fieldData, &m_uint32Values[PLAYER__FIELD_KNOWN_TITLES], 2, compactData);
+    uberInsert.addString(fieldData);
 
     uberInsert.addUInt32(uint32(GetByteValue(PLAYER_FIELD_BYTES, 2))); // actionbars
     uberInsert.addUInt32(GetCreatedDate());
@@ -856,6 +856,7 @@ class PlayerTaxi
 
         // Load taxi mask from data
         void LoadTaxiMask(const char* data);
+        void SaveTaxiMask(std::string& data, bool compact) const;
 
         // Check if a taxi node is known
         bool IsTaximaskNodeKnown(uint32 nodeidx) const
@@ -3772,9 +3773,6 @@ class Player : public Unit
         // Set the original group
         void SetOriginalGroup(Group* group, int8 subgroup = -1);
 
-        // Get the grid reference
-        GridReference<Player>& GetGridRef() { return m_gridRef; }
-
         // Get the map reference
         MapReference& GetMapRef() { return m_mapRef; }
 
@@ -4145,9 +4143,6 @@ class Player : public Unit
         // The player's camera
         Camera m_camera;
 
-        // Grid reference for the player
-        GridReference<Player> m_gridRef;
-
         // Map reference for the player
         MapReference m_mapRef;
 
@@ -2269,6 +2269,66 @@ bool SpellMgr::canStackSpellRanksInSpellBook(SpellEntry const* spellInfo) const
 }
 
 bool SpellMgr::IsNoStackSpellDueToSpell(uint32 spellId_1, uint32 spellId_2) const
+{
+    if (spellId_1 == spellId_2)
+    {
+        return false;
+    }
+
+    // not loaded yet
+    if (mSpellStackFlags.empty())
+    {
+        return IsNoStackSpellDueToSpellUncached(spellId_1, spellId_2);
+    }
+
+    uint8 flags_1 = spellId_1 < mSpellStackFlags.size() ? mSpellStackFlags[spellId_1] : 0;
+    uint8 flags_2 = spellId_2 < mSpellStackFlags.size() ? mSpellStackFlags[spellId_2] : 0;
+
+    if (!(flags_1 & SPELL_STACK_FLAG_EXISTS) || !(flags_2 & SPELL_STACK_FLAG_EXISTS))
+    {
+        return false;
+    }
+
+    // Resurrection sickness and passive spells stack with everything not of their own kind
+    if ((flags_1 ^ flags_2) & (SPELL_STACK_FLAG_PASSIVE | SPELL_STACK_FLAG_RES_SICKNESS))
+    {
+        return false;
+    }
+
+    // the remaining rules only depend on static spell data, so each ordered pair is resolved once
+    uint64 key = (uint64(spellId_1) << 32) | spellId_2;
+    SpellStackCacheShard& shard = mSpellStackCache[(spellId_1 ^ spellId_2) % SPELL_STACK_CACHE_SHARDS];
+    bool validate = sWorld.getConfig(CONFIG_BOOL_VALIDATE_SPELL_STACK_CACHE);
+
+    {
+        ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, shard.lock, IsNoStackSpellDueToSpellUncached(spellId_1, spellId_2))
+
+        SpellStackCacheShard::PairMap::const_iterator itr = shard.pairs.find(key);
+        if (itr != shard.pairs.end())
+        {
+            if (!validate)
+            {
+                return itr->second;
+            }
+
+            bool result = IsNoStackSpellDueToSpellUncached(spellId_1, spellId_2);
+            if (result != itr->second)
+            {
+                sLog.outError("SpellMgr::IsNoStackSpellDueToSpell: cached result %u for spells %u and %u differs from stacking rules result %u",
+                              uint32(itr->second), spellId_1, spellId_2, uint32(result));
+            }
+            return result;
+        }
+    }
+
+    bool result = IsNoStackSpellDueToSpellUncached(spellId_1, spellId_2);
+
+    ACE_WRITE_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, shard.lock, result)
+    shard.pairs[key] = result;
+    return result;
+}
+
+bool SpellMgr::IsNoStackSpellDueToSpellUncached(uint32 spellId_1, uint32 spellId_2) const
 {
     SpellEntry const* spellInfo_1 = sSpellStore.LookupEntry(spellId_1);
     SpellEntry const* spellInfo_2 = sSpellStore.LookupEntry(spellId_2);
@@ -3452,6 +3512,41 @@ void SpellMgr::LoadSpellChains()
 
     sLog.outString(">> Loaded %u spell chain records (%u from DBC data with %u req field updates, and %u loaded from table)", dbc_count + new_count, dbc_count, req_count, new_count);
     sLog.outString();
+
+    LoadSpellStackInfo();
+}
+
+void SpellMgr::LoadSpellStackInfo()
+{
+    mSpellStackFlags.assign(sSpellStore.GetNumRows(), 0);
+
+    for (uint32 spell_id = 0; spell_id < sSpellStore.GetNumRows(); ++spell_id)
+    {
+        SpellEntry const* spellInfo = sSpellStore.LookupEntry(spell_id);
+        if (!spellInfo)
+        {
+            continue;
+        }
+
+        uint8 flags = SPELL_STACK_FLAG_EXISTS;
+        if (spellInfo->HasAttribute(SPELL_ATTR_PASSIVE))
+        {
+            flags |= SPELL_STACK_FLAG_PASSIVE;
+        }
+        if (spellInfo->Id == SPELL_ID_PASSIVE_RESURRECTION_SICKNESS)
+        {
+            flags |= SPELL_STACK_FLAG_RES_SICKNESS;
+        }
+
+        mSpellStackFlags[spell_id] = flags;
+    }
+
+    // cached pairs can depend on the rank chains
+    for (int i = 0; i < SPELL_STACK_CACHE_SHARDS; ++i)
+    {
+        ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, mSpellStackCache[i].lock)
+        mSpellStackCache[i].pairs.clear();
+    }
 }
 
 void SpellMgr::LoadSpellLearnSkills()
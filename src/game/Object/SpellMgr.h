@@ -37,6 +37,8 @@
 #include "Utilities/UnorderedMapSet.h"
 
 #include <map>
+#include <vector>
+#include <ace/RW_Thread_Mutex.h>
 
 class Player;
 class Spell;
@@ -906,6 +908,27 @@ struct SpellChainNode
 typedef UNORDERED_MAP<uint32, SpellChainNode> SpellChainMap;
 typedef std::multimap<uint32, uint32> SpellChainMapNext;
 
+// Spell data resolved at load for the cheap aura stacking checks
+enum SpellStackFlags
+{
+    SPELL_STACK_FLAG_EXISTS         = 0x01,                 // spell present in sSpellStore
+    SPELL_STACK_FLAG_PASSIVE        = 0x02,
+    SPELL_STACK_FLAG_RES_SICKNESS   = 0x04,
+};
+
+typedef std::vector<uint8> SpellStackFlagsVector;           // SpellStackFlags indexed by spell id
+
+// Memoized IsNoStackSpellDueToSpell results, split in shards to keep map threads from waiting on each other
+#define SPELL_STACK_CACHE_SHARDS 16
+
+struct SpellStackCacheShard
+{
+    typedef UNORDERED_MAP<uint64, bool> PairMap;            // (spellId_1 << 32 | spellId_2) -> no stack
+
+    ACE_RW_Thread_Mutex lock;
+    PairMap pairs;
+};
+
 // Spell learning properties (accessed using SpellMgr functions)
 struct SpellLearnSkillNode
 {
@@ -1169,6 +1192,8 @@ class SpellMgr
 
         bool IsRankSpellDueToSpell(SpellEntry const* spellInfo_1, uint32 spellId_2) const;
         bool IsNoStackSpellDueToSpell(uint32 spellId_1, uint32 spellId_2) const;
+        // full stacking rules, IsNoStackSpellDueToSpell caches its results
+        bool IsNoStackSpellDueToSpellUncached(uint32 spellId_1, uint32 spellId_2) const;
         bool canStackSpellRanksInSpellBook(SpellEntry const* spellInfo) const;
         bool IsRankedSpellNonStackableInSpellBook(SpellEntry const* spellInfo) const
         {
@@ -1292,6 +1317,7 @@ class SpellMgr
         void LoadSkillRaceClassInfoMap();
         void LoadSpellPetAuras();
         void LoadSpellAreas();
+        void LoadSpellStackInfo();                          // called from LoadSpellChains, also resets the stack cache
 
         // Edit DBC data spells at startup
         void ModDBCSpellAttributes();
@@ -1315,6 +1341,8 @@ class SpellMgr
         SpellAreaMap         mSpellAreaMap;
         SpellAreaForAuraMap  mSpellAreaForAuraMap;
         SpellAreaForAreaMap  mSpellAreaForAreaMap;
+        SpellStackFlagsVector mSpellStackFlags;
+        mutable SpellStackCacheShard mSpellStackCache[SPELL_STACK_CACHE_SHARDS];
 };
 
 #define sSpellMgr SpellMgr::Instance()
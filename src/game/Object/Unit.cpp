@@ -219,6 +219,9 @@ Unit::Unit() :
 
     m_Visibility = VISIBILITY_ON;
     m_AINotifyScheduled = false;
+    m_splinePositionStale = false;
+    m_splineCellLeaveId = 0;
+    m_splineCellLeaveTime = 0;
 
     m_detectInvisibilityMask = 0;
     m_invisibilityMask = 0;
@@ -1160,6 +1163,7 @@ struct PetOwnerKilledUnitHelper
 void Unit::JustKilledCreature(Creature* victim, Player* responsiblePlayer)
 {
     victim->m_deathState = DEAD;                            // so that IsAlive, IsDead return expected results in the called hooks of JustKilledCreature
+    victim->GetGridRef().SetMirrorFlags(GRID_MIRROR_ALIVE, false);
     // must be used only shortly before SetDeathState(JUST_DIED) and only for Creatures or Pets
 
     // some critters required for quests (need normal entry instead possible heroic in any cases)
@@ -8948,6 +8952,7 @@ void Unit::SetDeathState(DeathState s)
         //_ApplyAllAuraMods();
     }
     m_deathState = s;
+    GetGridRef().SetMirrorFlags(GRID_MIRROR_ALIVE, s == ALIVE);
 }
 
 /*########################################
@@ -10042,7 +10047,7 @@ uint32 Unit::GetCreatePowers(Powers power) const
 
 void Unit::AddToWorld()
 {
-    Object::AddToWorld();
+    WorldObject::AddToWorld();
     ScheduleAINotify(0);
 
 #ifdef ENABLE_ELUNA
@@ -10080,7 +10085,7 @@ void Unit::RemoveFromWorld()
     }
 #endif
 
-    Object::RemoveFromWorld();
+    WorldObject::RemoveFromWorld();
 }
 
 void Unit::CleanupsBeforeDelete()
@@ -10720,6 +10725,7 @@ void Unit::InterruptMoving(bool forceSendStop /*=false*/)
         Movement::Location loc = movespline->ComputePosition();
         movespline->_Interrupt();
         Relocate(loc.x, loc.y, loc.z, loc.orientation);
+        m_splinePositionStale = false;
         isMoving = true;
     }
 
@@ -10954,12 +10960,18 @@ void Unit::SetDisplayId(uint32 modelId)
     }
 }
 
+void Unit::SetObjectBoundingRadius(float radius)
+{
+    SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, radius);
+    GetGridRef().SetMirrorRadius(radius);
+}
+
 void Unit::UpdateModelData()
 {
     if (CreatureModelInfo const* modelInfo = sObjectMgr.GetCreatureModelInfo(GetDisplayId()))
     {
         // we expect values in database to be relative to scale = 1.0
-        SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
+        SetObjectBoundingRadius(GetObjectScale() * modelInfo->bounding_radius);
 
         // never actually update combat_reach for player, it's always the same. Below player case is for initialization
         if (GetTypeId() == TYPEID_PLAYER)
@@ -11667,21 +11679,90 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
     if (m_movesplineTimer.Passed() || arrived)
     {
         m_movesplineTimer.Reset(POSITION_UPDATE_DELAY);
-        Movement::Location loc = movespline->ComputePosition();
 
         if (GetTypeId() == TYPEID_PLAYER)
         {
+            Movement::Location loc = movespline->ComputePosition();
             ((Player*)this)->SetPosition(loc.x, loc.y, loc.z, loc.orientation);
         }
+        else if (!arrived && movespline->timePassed() + POSITION_UPDATE_DELAY < m_splineCellLeaveTime && CanDeferSplineRelocation())
+        {
+            // nobody sees it and it stays in its cell until the next update: the position is only computed
+            // when something visits the cell, see Map::Visit
+            m_splinePositionStale = true;
+            GetMap()->MarkStaleSplineCell(((Creature*)this)->GetCurrentCell());
+        }
         else
         {
+            Movement::Location loc = movespline->ComputePosition();
+            m_splinePositionStale = false;
             GetMap()->CreatureRelocation((Creature*)this, loc.x, loc.y, loc.z, loc.orientation);
+
+            if (!arrived)
+            {
+                UpdateSplineCellLeaveTime();
+            }
         }
     }
 }
 
+bool Unit::CanDeferSplineRelocation() const
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_LAZY_SPLINE_RELOCATION))
+    {
+        return false;
+    }
+
+    // the leave time belongs to another spline, or a cyclic one restarts its time
+    if (movespline->GetId() != m_splineCellLeaveId || movespline->isCyclic())
+    {
+        return false;
+    }
+
+    // fighting, active and controlled units are looked up directly by others and keep exact positions
+    if (IsInCombat() || IsActiveObject() || !GetCharmerOrOwnerGuid().IsEmpty())
+    {
+        return false;
+    }
+
+    return !GetMap()->IsCellObserved(((Creature const*)this)->GetCurrentCell());
+}
+
+void Unit::UpdateSplineCellLeaveTime()
+{
+    CellPair cell = ((Creature const*)this)->GetCurrentCell().cellPair();
+
+    // inverse of MaNGOS::ComputeCellPair
+    float minX = (int32(cell.x_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    float minY = (int32(cell.y_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+
+    m_splineCellLeaveId = movespline->GetId();
+    m_splineCellLeaveTime = movespline->timeToLeaveBox(minX, minY, minX + SIZE_OF_GRID_CELL, minY + SIZE_OF_GRID_CELL);
+}
+
+void Unit::UpdateStaleSplinePosition()
+{
+    if (!m_splinePositionStale || movespline->Finalized())
+    {
+        return;
+    }
+
+    Movement::Location loc = movespline->ComputePosition();
+
+    // a smooth path can bulge out of the cell, the next update relocates it properly then
+    Cell cell(MaNGOS::ComputeCellPair(loc.x, loc.y));
+    if (cell != ((Creature const*)this)->GetCurrentCell())
+    {
+        return;
+    }
+
+    m_splinePositionStale = false;
+    Relocate(loc.x, loc.y, loc.z, loc.orientation);
+}
+
 void Unit::DisableSpline()
 {
+    m_splinePositionStale = false;
     m_movementInfo.RemoveMovementFlag(MovementFlags(MOVEFLAG_SPLINE_ENABLED | MOVEFLAG_FORWARD));
     movespline->_Interrupt();
 }
@@ -1232,6 +1232,12 @@ class Unit : public WorldObject
             return m_floatValues[UNIT_FIELD_BOUNDINGRADIUS];
         }
 
+        /**
+         * Sets UNIT_FIELD_BOUNDINGRADIUS and keeps the cell list mirror of it in sync
+         * @param radius the new bounding radius
+         */
+        void SetObjectBoundingRadius(float radius);
+
         /**
          * Gets the current DiminishingLevels for the given group
          * @param group The group that you would like to know the current diminishing return level for
@@ -3864,6 +3870,8 @@ class Unit : public WorldObject
         uint32 m_lastManaUseTimer;
 
         void DisableSpline();
+        // brings a spline position left behind by lazy spline relocation up to date, as long as it stays in the cell
+        void UpdateStaleSplinePosition();
         bool m_isCreatureLinkingTrigger;
         bool m_isSpawningLinked;
 
@@ -3871,6 +3879,8 @@ class Unit : public WorldObject
 
         void CleanupDeletedAuras();
         void UpdateSplineMovement(uint32 t_diff);
+        bool CanDeferSplineRelocation() const;
+        void UpdateSplineCellLeaveTime();
 
         Unit* _GetTotem(TotemSlot slot) const;              // for templated function without include need
         Pet* _GetPet(ObjectGuid guid) const;                // for templated function without include need
@@ -3888,6 +3898,9 @@ class Unit : public WorldObject
         Position m_last_notified_position;
         bool m_AINotifyScheduled;
         TimeTracker m_movesplineTimer;
+        bool m_splinePositionStale;                         // spline moved on, map position not updated (lazy spline relocation)
+        uint32 m_splineCellLeaveId;                         // spline the leave time below was computed for
+        int32 m_splineCellLeaveTime;                        // spline time at which the unit may leave its current cell
 
         Diminishing m_Diminishing;
         // Manage all Units threatening us
@@ -0,0 +1,276 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "UpdateFieldBlob.h"
+
+namespace
+{
+    char const base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // 0xFF for characters outside of the base64 alphabet
+    struct Base64DecodeTable
+    {
+        uint8 map[256];
+
+        Base64DecodeTable()
+        {
+            memset(map, 0xFF, sizeof(map));
+            for (uint8 i = 0; i < 64; ++i)
+            {
+                map[uint8(base64Chars[i])] = i;
+            }
+        }
+    };
+
+    Base64DecodeTable const base64Decode;
+
+    void AppendVarint(std::string& bytes, uint32 value)
+    {
+        while (value >= 0x80)
+        {
+            bytes += char(uint8(value) | 0x80);
+            value >>= 7;
+        }
+        bytes += char(uint8(value));
+    }
+
+    void AppendBase64(std::string& out, std::string const& bytes)
+    {
+        out.reserve(out.size() + (bytes.size() + 2) / 3 * 4);
+
+        size_t i = 0;
+        for (; i + 2 < bytes.size(); i += 3)
+        {
+            uint32 triple = (uint8(bytes[i]) << 16) | (uint8(bytes[i + 1]) << 8) | uint8(bytes[i + 2]);
+            out += base64Chars[(triple >> 18) & 0x3F];
+            out += base64Chars[(triple >> 12) & 0x3F];
+            out += base64Chars[(triple >> 6) & 0x3F];
+            out += base64Chars[triple & 0x3F];
+        }
+
+        // no padding, the decoder knows the payload length from the text length
+        size_t rest = bytes.size() - i;
+        if (rest == 1)
+        {
+            uint32 triple = uint8(bytes[i]) << 16;
+            out += base64Chars[(triple >> 18) & 0x3F];
+            out += base64Chars[(triple >> 12) & 0x3F];
+        }
+        else if (rest == 2)
+        {
+            uint32 triple = (uint8(bytes[i]) << 16) | (uint8(bytes[i + 1]) << 8);
+            out += base64Chars[(triple >> 18) & 0x3F];
+            out += base64Chars[(triple >> 12) & 0x3F];
+            out += base64Chars[(triple >> 6) & 0x3F];
+        }
+    }
+
+    /// Streams bytes out of the base64 armour without materializing the payload
+    class Base64Reader
+    {
+        public:
+            explicit Base64Reader(char const* text) : m_text(text), m_bits(0), m_bitCount(0) {}
+
+            bool ReadByte(uint8& byte)
+            {
+                while (m_bitCount < 8)
+                {
+                    uint8 sextet = base64Decode.map[uint8(*m_text)];
+                    if (sextet == 0xFF)
+                    {
+                        return false;                       // end of text or broken armour
+                    }
+
+                    m_bits = (m_bits << 6) | sextet;
+                    m_bitCount += 6;
+                    ++m_text;
+                }
+
+                m_bitCount -= 8;
+                byte = uint8(m_bits >> m_bitCount);
+                return true;
+            }
+
+            bool ReadVarint(uint32& value)
+            {
+                value = 0;
+                for (uint32 shift = 0; shift < 35; shift += 7)
+                {
+                    uint8 byte;
+                    if (!ReadByte(byte))
+                    {
+                        return false;
+                    }
+
+                    value |= uint32(byte & 0x7F) << shift;
+                    if (!(byte & 0x80))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;                               // more than 5 bytes can't be an uint32
+            }
+
+        private:
+            char const* m_text;
+            uint32 m_bits;
+            uint32 m_bitCount;
+    };
+
+    uint32 DecodeCompact(char const* data, uint32* values, uint32 maxCount)
+    {
+        if (data[1] != '0' + UpdateFieldBlob::UPDATEFIELD_BLOB_VERSION)
+        {
+            return 0;
+        }
+
+        Base64Reader reader(data + 2);
+
+        uint32 count;
+        if (!reader.ReadVarint(count))
+        {
+            return 0;
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            uint32 value;
+            if (!reader.ReadVarint(value))
+            {
+                return 0;
+            }
+
+            if (i < maxCount)
+            {
+                values[i] = value;
+            }
+        }
+
+        return count;
+    }
+
+    // same token rules as StrSplit(data, " ") + atol, without the temporary strings
+    uint32 DecodeText(char const* data, uint32* values, uint32 maxCount)
+    {
+        uint32 count = 0;
+        char const* itr = data;
+        while (*itr)
+        {
+            if (*itr == ' ')
+            {
+                ++itr;
+                continue;
+            }
+
+            bool negative = false;
+            if (*itr == '-' || *itr == '+')
+            {
+                negative = *itr == '-';
+                ++itr;
+            }
+
+            uint64 value = 0;
+            while (*itr >= '0' && *itr <= '9')
+            {
+                value = value * 10 + uint64(*itr - '0');
+                ++itr;
+            }
+
+            // skip the rest of a malformed token, atol ignores it too
+            while (*itr && *itr != ' ')
+            {
+                ++itr;
+            }
+
+            if (count < maxCount)
+            {
+                values[count] = negative ? uint32(-int64(value)) : uint32(value);
+            }
+            ++count;
+        }
+
+        return count;
+    }
+}
+
+bool UpdateFieldBlob::IsCompact(char const* data)
+{
+    return data && data[0] == UPDATEFIELD_BLOB_MARKER;
+}
+
+void UpdateFieldBlob::Encode(std::string& out, uint32 const* values, uint32 count, bool compact)
+{
+    if (!compact)
+    {
+        char buf[12];
+        out.reserve(out.size() + count * 3);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            int len = snprintf(buf, sizeof(buf), "%u ", values[i]);
+            out.append(buf, len);
+        }
+        return;
+    }
+
+    std::string bytes;
+    bytes.reserve(count + 5);
+    AppendVarint(bytes, count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        AppendVarint(bytes, values[i]);
+    }
+
+    out += char(UPDATEFIELD_BLOB_MARKER);
+    out += char('0' + UPDATEFIELD_BLOB_VERSION);
+    AppendBase64(out, bytes);
+}
+
+uint32 UpdateFieldBlob::Decode(char const* data, uint32* values, uint32 maxCount)
+{
+    if (!data)
+    {
+        return 0;
+    }
+
+    return IsCompact(data) ? DecodeCompact(data, values, maxCount) : DecodeText(data, values, maxCount);
+}
+
+bool UpdateFieldBlob::Convert(char const* data, std::string& out, bool compact)
+{
+    uint32 count = Decode(data, NULL, 0);
+    if (!count && IsCompact(data))
+    {
+        return false;
+    }
+
+    std::vector<uint32> values(count);
+    if (count && Decode(data, &values[0], count) != count)
+    {
+        return false;
+    }
+
+    Encode(out, count ? &values[0] : NULL, count, compact);
+    return true;
+}
@@ -0,0 +1,70 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_UPDATEFIELDBLOB
+#define MANGOS_H_UPDATEFIELDBLOB
+
+#include "Common.h"
+
+/**
+ * Encoding of uint32 update-field arrays stored in text columns
+ * (`item_instance`.`data`, `characters`.`taximask`, `exploredZones`, `knownTitles`).
+ *
+ * Two formats are understood by the loaders:
+ *  - legacy text: space separated decimal numbers ("1 0 5 ");
+ *  - compact v1:  UPDATEFIELD_BLOB_MARKER, a version digit and a base64 armoured
+ *                 little-endian binary payload: varint(count) followed by count
+ *                 varint (LEB128) encoded values.
+ *
+ * The armour keeps the payload valid for the existing TEXT columns so the
+ * schema does not have to change; zero fields, the common case, cost 1 byte.
+ */
+namespace UpdateFieldBlob
+{
+    enum
+    {
+        UPDATEFIELD_BLOB_MARKER     = '#',
+        UPDATEFIELD_BLOB_VERSION    = 1
+    };
+
+    /// true if data is stored in the compact format
+    bool IsCompact(char const* data);
+
+    /// Appends count values to out, in compact or legacy text format
+    void Encode(std::string& out, uint32 const* values, uint32 count, bool compact);
+
+    /**
+     * Decodes data in either format into values.
+     *
+     * @return amount of values found in data, only the first maxCount are stored.
+     *         Callers that require an exact amount compare the result with maxCount.
+     *         Returns 0 for NULL or malformed compact data.
+     */
+    uint32 Decode(char const* data, uint32* values, uint32 maxCount);
+
+    /// Re-encodes data into the requested format, returns false for malformed data
+    bool Convert(char const* data, std::string& out, bool compact);
+}
+
+#endif
@@ -234,6 +234,12 @@ void WorldSession::QueuePacket(WorldPacket* new_packet)
     _recvQueue.add(new_packet);
 }
 
+/// Add several incoming packets to the queue at once
+void WorldSession::QueuePackets(std::vector<WorldPacket*> const& new_packets)
+{
+    _recvQueue.add(new_packets.begin(), new_packets.end());
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnexpectedOpcode(WorldPacket* packet, const char* reason)
 {
@@ -252,6 +252,7 @@ class WorldSession
         void KickPlayer();
 
         void QueuePacket(WorldPacket* new_packet);
+        void QueuePackets(std::vector<WorldPacket*> const& new_packets);
 
         bool Update(PacketFilter& updater);
 
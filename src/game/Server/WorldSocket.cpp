@@ -83,12 +83,15 @@ WorldSocket::WorldSocket(void) :
     m_LastPingTime(ACE_Time_Value::zero),
     m_OverSpeedPings(0),
     m_Session(0),
-    m_RecvWPct(0),
-    m_RecvPct(),
-    m_Header(sizeof(ClientPktHeader)),
+    m_InBuffer(0),
+    m_InBufferSize(16384),
+    m_RecvHeaderReady(false),
     m_OutBufferLock(),
     m_OutBuffer(0),
     m_OutBufferSize(65536),
+    m_NetworkLoop(NULL),
+    m_OutActive(false),
+    m_OutQueued(false),
     m_Seed(static_cast<uint32>(rand32()))
 {
     reference_counting_policy().value(ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
@@ -96,7 +99,15 @@ WorldSocket::WorldSocket(void) :
 
 WorldSocket::~WorldSocket(void)
 {
-    delete m_RecvWPct;
+    if (m_InBuffer)
+    {
+        m_InBuffer->release();
+    }
+
+    for (std::vector<WorldPacket*>::iterator itr = m_RecvBatch.begin(); itr != m_RecvBatch.end(); ++itr)
+    {
+        delete *itr;
+    }
 
     if (m_OutBuffer)
     {
@@ -112,6 +123,11 @@ WorldSocket::~WorldSocket(void)
     {
         delete pct;
     }
+
+    if (m_NetworkLoop)
+    {
+        m_NetworkLoop->OnSocketClose();
+    }
 }
 
 bool WorldSocket::IsClosed(void) const
@@ -166,14 +182,18 @@ int WorldSocket::SendPacket(const WorldPacket& pkt)
         }
     }
 
-    Guard.release();
-
-    if (reactor()->schedule_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
+    // handle_output or an already queued flush will pick the data up
+    if (m_OutActive || m_OutQueued)
     {
-        sLog.outError("SendPacket failed setting WRITE mask, peer = %s", GetRemoteAddress().c_str());
-        return -1;
+        return 0;
     }
 
+    m_OutQueued = true;
+
+    Guard.release();
+
+    m_NetworkLoop->QueueOutput(this);
+
     return 0;
 }
 
@@ -203,8 +223,9 @@ int WorldSocket::open(void* a)
         return -1;
     }
 
-    // Allocate the buffer.
+    // Allocate the buffers.
     ACE_NEW_RETURN(m_OutBuffer, ACE_Message_Block(m_OutBufferSize), -1);
+    ACE_NEW_RETURN(m_InBuffer, ACE_Message_Block(m_InBufferSize), -1);
 
     // Store peer address.
     ACE_INET_Addr remote_addr;
@@ -252,6 +273,8 @@ int WorldSocket::handle_input(ACE_HANDLE)
         return -1;
     }
 
+    m_NetworkLoop->OnInputEvent();
+
     switch (handle_input_missing_data())
     {
         case -1 :
@@ -266,6 +289,9 @@ int WorldSocket::handle_input(ACE_HANDLE)
             errno = ECONNRESET;
             return -1;
         }
+        case 1:
+            // the read filled the whole buffer, there is likely more waiting in the kernel
+            return 1;
         default:
             return 0;
     }
@@ -282,83 +308,100 @@ int WorldSocket::handle_output(ACE_HANDLE)
         return -1;
     }
 
-    const size_t send_len = m_OutBuffer->length();
+    m_NetworkLoop->OnOutputEvent();
 
-    if (send_len == 0)
+    switch (iFlushOutBuffer())
     {
-        Guard.release();
-        if (reactor()->cancel_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
-        {
+        case -1:
             return -1;
-        }
-        return 0;
+        case 1:
+            // kernel buffer still full, stay armed
+            return 0;
+        default:
+            break;
     }
 
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
+    // all sent, further output goes through the flushes of the network loop again
+    m_OutActive = false;
 
-    if (n == 0)
+    Guard.release();
+    if (reactor()->cancel_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
     {
         return -1;
     }
+    return 0;
+}
 
-    else if (n == -1)
+void WorldSocket::FlushOutput()
+{
+    ACE_GUARD(LockType, Guard, m_OutBufferLock);
+
+    m_OutQueued = false;
+
+    if (closing_ || m_OutActive)
     {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-        {
-            Guard.release();
-            if (reactor()->schedule_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
-            {
-                return -1;
-            }
-            return 0;
-        }
-        return -1;
+        return;
     }
-    else if (n < (ssize_t)send_len) // now n > 0
+
+    // on errors handle_output is armed too, it fails the same way and lets the reactor close the socket
+    if (iFlushOutBuffer() == 0)
     {
-        m_OutBuffer->rd_ptr(static_cast<size_t>(n));
+        return;
+    }
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    m_OutActive = true;
 
-        Guard.release();
-        if (reactor()->schedule_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
-        {
-            return -1;
-        }
-        return 0;
+    Guard.release();
+    if (reactor()->schedule_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
+    {
+        sLog.outError("WorldSocket::FlushOutput failed setting WRITE mask, peer = %s", GetRemoteAddress().c_str());
     }
-    else // now n == send_len
+}
+
+int WorldSocket::iFlushOutBuffer()
+{
+    for (;;)
     {
-        m_OutBuffer->reset();
+        const size_t send_len = m_OutBuffer->length();
 
-        if (!iFlushPacketQueue()) //no more packets in queue
+        if (send_len == 0)
         {
-            Guard.release();
-            if (reactor()->cancel_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
+            m_OutBuffer->reset();
+
+            // refill from the queued packets, done if there are none
+            if (!iFlushPacketQueue())
             {
-                return -1;
+                return 0;
             }
-            return 0;
+            continue;
         }
-        else
+
+#ifdef MSG_NOSIGNAL
+        ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+#else
+        ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len);
+#endif // MSG_NOSIGNAL
+
+        if (n == 0)
         {
-            Guard.release();
-            if (reactor()->schedule_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
-            {
-                return -1;
-            }
-            return 0;
+            return -1;
+        }
+        else if (n == -1)
+        {
+            return (errno == EWOULDBLOCK || errno == EAGAIN) ? 1 : -1;
+        }
+
+        m_OutBuffer->rd_ptr(static_cast<size_t>(n));
+
+        if (n < (ssize_t)send_len)
+        {
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
+            return 1;
         }
     }
-    ACE_NOTREACHED(return 0);
 }
 
-
 int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
 {
     {
@@ -381,13 +424,14 @@ int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
 
 int WorldSocket::handle_input_header(void)
 {
-    MANGOS_ASSERT(m_RecvWPct == NULL);
+    MANGOS_ASSERT(!m_RecvHeaderReady);
 
-    MANGOS_ASSERT(m_Header.length() == sizeof(ClientPktHeader));
+    MANGOS_ASSERT(m_InBuffer->length() >= sizeof(ClientPktHeader));
 
-    m_Crypt.DecryptRecv((uint8*) m_Header.rd_ptr(), sizeof(ClientPktHeader));
+    // decrypted in place, the header stays in m_InBuffer until its payload is complete too
+    m_Crypt.DecryptRecv((uint8*) m_InBuffer->rd_ptr(), sizeof(ClientPktHeader));
 
-    ClientPktHeader& header = *((ClientPktHeader*) m_Header.rd_ptr());
+    ClientPktHeader& header = *((ClientPktHeader*) m_InBuffer->rd_ptr());
 
     EndianConvertReverse(header.size);
     EndianConvert(header.cmd);
@@ -403,17 +447,7 @@ int WorldSocket::handle_input_header(void)
 
     header.size -= 4;
 
-    ACE_NEW_RETURN(m_RecvWPct, WorldPacket(OpcodesList(header.cmd), header.size), -1);
-
-    if (header.size > 0)
-    {
-        m_RecvWPct->resize(header.size);
-        m_RecvPct.base((char*) m_RecvWPct->contents(), m_RecvWPct->size());
-    }
-    else
-    {
-        MANGOS_ASSERT(m_RecvPct.space() == 0);
-    }
+    m_RecvHeaderReady = true;
 
     return 0;
 }
@@ -423,17 +457,24 @@ int WorldSocket::handle_input_payload(void)
     // set errno properly here on error !!!
     // now have a header and payload
 
-    MANGOS_ASSERT(m_RecvPct.space() == 0);
-    MANGOS_ASSERT(m_Header.space() == 0);
-    MANGOS_ASSERT(m_RecvWPct != NULL);
+    MANGOS_ASSERT(m_RecvHeaderReady);
+
+    ClientPktHeader const& header = *((ClientPktHeader const*) m_InBuffer->rd_ptr());
+
+    MANGOS_ASSERT(m_InBuffer->length() >= sizeof(ClientPktHeader) + header.size);
 
-    const int ret = ProcessIncoming(m_RecvWPct);
+    WorldPacket* new_pct;
+    ACE_NEW_RETURN(new_pct, WorldPacket(OpcodesList(header.cmd), header.size), -1);
 
-    m_RecvPct.base(NULL, 0);
-    m_RecvPct.reset();
-    m_RecvWPct = NULL;
+    if (header.size > 0)
+    {
+        new_pct->append((uint8 const*) m_InBuffer->rd_ptr() + sizeof(ClientPktHeader), header.size);
+    }
 
-    m_Header.reset();
+    m_InBuffer->rd_ptr(sizeof(ClientPktHeader) + header.size);
+    m_RecvHeaderReady = false;
+
+    const int ret = ProcessIncoming(new_pct);
 
     if (ret == -1)
     {
@@ -445,23 +486,12 @@ int WorldSocket::handle_input_payload(void)
 
 int WorldSocket::handle_input_missing_data(void)
 {
-    char buf [4096];
-
-    ACE_Data_Block db(sizeof(buf),
-                      ACE_Message_Block::MB_DATA,
-                      buf,
-                      0,
-                      0,
-                      ACE_Message_Block::DONT_DELETE,
-                      0);
+    // a partially received packet is moved to the base of the buffer, so a complete one always fits
+    m_InBuffer->crunch();
 
-    ACE_Message_Block message_block(&db,
-                                    ACE_Message_Block::DONT_DELETE,
-                                    0);
+    const size_t recv_size = m_InBuffer->space();
 
-    const size_t recv_size = message_block.space();
-
-    const ssize_t n = peer().recv(message_block.wr_ptr(),
+    const ssize_t n = peer().recv(m_InBuffer->wr_ptr(),
                                   recv_size);
 
     if (n <= 0)
@@ -469,69 +499,68 @@ int WorldSocket::handle_input_missing_data(void)
         return (int)n;
     }
 
-    message_block.wr_ptr(n);
+    m_InBuffer->wr_ptr(n);
+
+    int ret = size_t(n) == recv_size ? 1 : 2;
 
-    while (message_block.length() > 0)
+    // decode every packet that is complete now
+    for (;;)
     {
-        if (m_Header.space() > 0)
+        if (!m_RecvHeaderReady)
         {
-            // need to receive the header
-            const size_t to_header = (message_block.length() > m_Header.space() ? m_Header.space() : message_block.length());
-            m_Header.copy(message_block.rd_ptr(), to_header);
-            message_block.rd_ptr(to_header);
-
-            if (m_Header.space() > 0)
+            if (m_InBuffer->length() < sizeof(ClientPktHeader))
             {
-                // Couldn't receive the whole header this time.
-                MANGOS_ASSERT(message_block.length() == 0);
-                errno = EWOULDBLOCK;
-                return -1;
+                break;
             }
 
-            // We just received nice new header
             if (handle_input_header() == -1)
             {
-                MANGOS_ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
-                return -1;
+                ret = -1;
+                break;
             }
         }
 
-        // Its possible on some error situations that this happens
-        // for example on closing when epoll receives more chunked data and stuff
-        // hope this is not hack ,as proper m_RecvWPct is asserted around
-        if (!m_RecvWPct)
+        const size_t payload = ((ClientPktHeader const*) m_InBuffer->rd_ptr())->size;
+        if (m_InBuffer->length() < sizeof(ClientPktHeader) + payload)
         {
-            sLog.outError("Forcing close on input m_RecvWPct = NULL");
-            errno = EINVAL;
-            return -1;
+            break;
         }
 
-        // We have full read header, now check the data payload
-        if (m_RecvPct.space() > 0)
+        if (handle_input_payload() == -1)
         {
-            // need more data in the payload
-            const size_t to_data = (message_block.length() > m_RecvPct.space() ? m_RecvPct.space() : message_block.length());
-            m_RecvPct.copy(message_block.rd_ptr(), to_data);
-            message_block.rd_ptr(to_data);
-
-            if (m_RecvPct.space() > 0)
-            {
-                // Couldn't receive the whole data this time.
-                MANGOS_ASSERT(message_block.length() == 0);
-                errno = EWOULDBLOCK;
-                return -1;
-            }
+            ret = -1;
+            break;
         }
+    }
 
-        // just received fresh new payload
-        if (handle_input_payload() == -1)
+    // hand over what was decoded to the session with one lock
+    const int err = errno;
+    FlushRecvBatch();
+    errno = err;
+
+    return ret;
+}
+
+void WorldSocket::FlushRecvBatch()
+{
+    if (m_RecvBatch.empty())
+    {
+        return;
+    }
+
+    if (m_Session)
+    {
+        m_Session->QueuePackets(m_RecvBatch);
+    }
+    else
+    {
+        for (std::vector<WorldPacket*>::iterator itr = m_RecvBatch.begin(); itr != m_RecvBatch.end(); ++itr)
         {
-            MANGOS_ASSERT((errno != EWOULDBLOCK) && (errno != EAGAIN));
-            return -1;
+            delete *itr;
         }
     }
 
-    return size_t(n) == recv_size ? 1 : 2;
+    m_RecvBatch.clear();
 }
 
 int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
@@ -594,9 +623,9 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
             {
                 if (m_Session != NULL)
                 {
-                    // OK ,give the packet to WorldSession
+                    // OK ,give the packet to WorldSession, at the end of the current read
                     aptr.release();
-                    m_Session->QueuePacket(new_pct);
+                    m_RecvBatch.push_back(new_pct);
                     return 0;
                 }
                 else
@@ -53,6 +53,7 @@ class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
 class WorldSocket;
+class WorldNetworkLoop;
 
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
 typedef ACE_Acceptor< WorldSocket, ACE_SOCK_ACCEPTOR > WorldAcceptor;
@@ -72,18 +73,19 @@ typedef ACE_Acceptor< WorldSocket, ACE_SOCK_ACCEPTOR > WorldAcceptor;
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
  * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() override method).
+ * is 10ms celling (WORLD_SOCKET_FLUSH_DELAY), write readiness
+ * is only requested when the kernel buffer is full.
  * This concept is similar to TCP_CORK, but TCP_CORK
  * uses 200ms celling. As result overhead generated by
  * sending packets from "producer" threads is minimal,
  * and doing a lot of writes with small size is tolerated.
  *
- * The calls to Update () method are managed by WorldSocketMgr.
+ * The flushes are done by the WorldNetworkLoop of the socket.
  *
- * For input, the class uses one 1024 bytes buffer on stack
- * to which it does recv() calls. And then received data is
- * distributed where its needed. 1024 matches pretty well the
- * traffic generated by client for now.
+ * For input, the class uses one buffer per connection (16K usually)
+ * to which it does recv() calls. All complete packets in it are
+ * decoded in place and given to the session together, a partial
+ * packet stays in the buffer until the rest arrives.
  *
  * The input/output do speculative reads/writes (AKA it tryes
  * to read all data available in the kernel buffer or tryes to
@@ -99,6 +101,7 @@ class WorldSocket : protected WorldHandler
         /// Declare some friends
         friend class ACE_Acceptor< WorldSocket, ACE_SOCK_ACCEPTOR >;
         friend class WorldSocketMgr;
+        friend class WorldNetworkLoop;
 
         /// Mutex type used for various synchronizations.
         typedef ACE_Thread_Mutex LockType;
@@ -153,6 +156,9 @@ class WorldSocket : protected WorldHandler
         int handle_input_payload(void);
         int handle_input_missing_data(void);
 
+        /// Queue the packets decoded by the last read to the session.
+        void FlushRecvBatch();
+
         /// process one incoming packet.
         /// @param new_pct received packet ,note that you need to delete it.
         int ProcessIncoming(WorldPacket* new_pct);
@@ -173,6 +179,14 @@ class WorldSocket : protected WorldHandler
         /// to mark the socket for output ).
         bool iFlushPacketQueue();
 
+        /// Send m_OutBuffer and m_PacketQueue to the kernel as far as possible
+        /// Need to be called with m_OutBufferLock lock held
+        /// @return 0 if everything was sent, 1 if the kernel buffer is full, -1 on error
+        int iFlushOutBuffer();
+
+        /// Called by the network loop for sockets that queued output
+        void FlushOutput();
+
     private:
         /// Time in which the last ping was received
         ACE_Time_Value m_LastPingTime;
@@ -189,16 +203,17 @@ class WorldSocket : protected WorldHandler
         /// Session to which received packets are routed
         WorldSession* m_Session;
 
-        /// here are stored the fragments of the received data
-        WorldPacket* m_RecvWPct;
+        /// Buffer for the received data, only complete packets are taken out of it.
+        ACE_Message_Block* m_InBuffer;
 
-        /// This block actually refers to m_RecvWPct contents,
-        /// which allows easy and safe writing to it.
-        /// It wont free memory when its deleted. m_RecvWPct takes care of freeing.
-        ACE_Message_Block m_RecvPct;
+        /// Size of the m_InBuffer.
+        size_t m_InBufferSize;
 
-        /// Fragment of the received header.
-        ACE_Message_Block m_Header;
+        /// The header at the start of m_InBuffer is already decrypted.
+        bool m_RecvHeaderReady;
+
+        /// Packets decoded by the current read, queued to the session at once.
+        std::vector<WorldPacket*> m_RecvBatch;
 
         /// Mutex for protecting output related data.
         LockType m_OutBufferLock;
@@ -209,6 +224,15 @@ class WorldSocket : protected WorldHandler
         /// Size of the m_OutBuffer.
         size_t m_OutBufferSize;
 
+        /// Network loop the socket was assigned to when accepted.
+        WorldNetworkLoop* m_NetworkLoop;
+
+        /// Write readiness is armed in the reactor, handle_output sends the output.
+        bool m_OutActive;
+
+        /// Socket is queued for the next flush of its network loop.
+        bool m_OutQueued;
+
         /// Here are stored packets for which there was no space on m_OutBuffer,
         /// this allows not-to kick player if its buffer is overflowed.
         PacketQueueT m_PacketQueue;
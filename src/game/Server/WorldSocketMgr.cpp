@@ -36,6 +36,9 @@
 
 #include <ace/ACE.h>
 #include <ace/TP_Reactor.h>
+#if defined (ACE_HAS_EVENT_POLL)
+#include <ace/Dev_Poll_Reactor.h>
+#endif
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -43,23 +46,108 @@
 
 #include <set>
 
+WorldNetworkLoop::WorldNetworkLoop() : m_reactor(NULL),
+    m_connections(0), m_inputEvents(0), m_outputEvents(0), m_flushes(0)
+{
+}
+
+WorldNetworkLoop::~WorldNetworkLoop()
+{
+    for (SocketList::iterator itr = m_pending.begin(); itr != m_pending.end(); ++itr)
+    {
+        (*itr)->RemoveReference();
+    }
+
+    if (m_reactor)
+    {
+        delete m_reactor;
+    }
+}
+
+int WorldNetworkLoop::Open()
+{
+    // epoll where ACE supports it, each loop is run by a single thread in both cases
+#if defined (ACE_HAS_EVENT_POLL)
+    ACE_Reactor_Impl* imp = new ACE_Dev_Poll_Reactor();
+#else
+    ACE_Reactor_Impl* imp = new ACE_TP_Reactor();
+#endif
+    imp->max_notify_iterations(128);
+    m_reactor = new ACE_Reactor(imp, 1);
+
+    ACE_Time_Value interval(0, WORLD_SOCKET_FLUSH_DELAY * 1000);
+    if (m_reactor->schedule_timer(this, 0, interval, interval) == -1)
+    {
+        sLog.outError("WorldNetworkLoop::Open: unable to schedule the flush timer");
+        return -1;
+    }
+
+    return 0;
+}
+
+void WorldNetworkLoop::Run()
+{
+    m_reactor->owner(ACE_Thread::self());
+    m_reactor->run_reactor_event_loop();
+}
+
+void WorldNetworkLoop::Stop()
+{
+    m_reactor->end_reactor_event_loop();
+}
+
+void WorldNetworkLoop::QueueOutput(WorldSocket* sock)
+{
+    sock->AddReference();
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_pendingLock);
+    m_pending.push_back(sock);
+}
+
+int WorldNetworkLoop::handle_timeout(const ACE_Time_Value& /*current_time*/, const void* /*act*/)
+{
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_pendingLock, 0);
+        m_flushing.swap(m_pending);
+    }
+
+    for (SocketList::iterator itr = m_flushing.begin(); itr != m_flushing.end(); ++itr)
+    {
+        (*itr)->FlushOutput();
+        (*itr)->RemoveReference();
+    }
+
+    m_flushes += long(m_flushing.size());
+    m_flushing.clear();
+    return 0;
+}
+
+void WorldNetworkLoop::GetStats(WorldNetworkLoopStats& stats) const
+{
+    stats.connections = m_connections.value();
+    stats.inputEvents = m_inputEvents.value();
+    stats.outputEvents = m_outputEvents.value();
+    stats.flushes = m_flushes.value();
+}
+
 WorldSocketMgr::WorldSocketMgr()
-  : m_SockOutKBuff(-1), m_SockOutUBuff(65536), m_UseNoDelay(true),
-    reactor_(NULL), acceptor_(NULL)
+  : m_SockOutKBuff(-1), m_SockOutUBuff(65536), m_SockInUBuff(16384), m_UseNoDelay(true),
+    m_nextThreadLoop(0), m_nextSocketLoop(0), acceptor_(NULL)
 {
     InitializeOpcodes();
 }
 
 WorldSocketMgr::~WorldSocketMgr()
 {
-    if (reactor_)
-    {
-        delete reactor_;
-    }
     if (acceptor_)
     {
         delete acceptor_;
     }
+
+    for (NetworkLoopList::iterator itr = m_loops.begin(); itr != m_loops.end(); ++itr)
+    {
+        delete *itr;
+    }
 }
 
 
@@ -67,7 +155,7 @@ int WorldSocketMgr::svc()
 {
     DEBUG_LOG("Starting Network Thread");
 
-    reactor_->run_reactor_event_loop();
+    m_loops[(++m_nextThreadLoop - 1) % m_loops.size()]->Run();
 
     DEBUG_LOG("Network Thread Exitting");
     return 0;
@@ -91,19 +179,34 @@ int WorldSocketMgr::StartNetwork(ACE_INET_Addr& addr)
         return -1;
     }
 
+    // must hold the biggest packet a client may send
+    m_SockInUBuff = sConfig.GetIntDefault("Network.InUBuff", 16384);
+    if (m_SockInUBuff < 10246)
+    {
+        sLog.outError("Network.InUBuff is wrong in your config file, it must be at least 10246");
+        return -1;
+    }
+
     // -1 means use default
     m_SockOutKBuff = sConfig.GetIntDefault("Network.OutKBuff", -1);
     m_UseNoDelay = sConfig.GetBoolDefault("Network.TcpNodelay", true);
 
+    // one independent event loop per network thread
+    for (int i = 0; i < num_threads; ++i)
+    {
+        WorldNetworkLoop* loop = new WorldNetworkLoop;
+        m_loops.push_back(loop);
 
-    ACE_Reactor_Impl* imp = 0;
-    imp = new ACE_TP_Reactor();
-    imp->max_notify_iterations(128);
-    reactor_ = new ACE_Reactor(imp, 1);
+        if (loop->Open() == -1)
+        {
+            return -1;
+        }
+    }
 
     acceptor_ = new WorldAcceptor;
 
-    if (acceptor_->open(addr, reactor_, ACE_NONBLOCK) == -1)
+    // accepting is done by the first loop, the sockets are spread over all of them in OnSocketOpen
+    if (acceptor_->open(addr, m_loops[0]->GetReactor(), ACE_NONBLOCK) == -1)
     {
         sLog.outError("Failed to open acceptor, check if the port is free");
         return -1;
@@ -124,13 +227,24 @@ void WorldSocketMgr::StopNetwork()
     {
         acceptor_->close();
     }
-    if (reactor_)
+
+    for (NetworkLoopList::iterator itr = m_loops.begin(); itr != m_loops.end(); ++itr)
     {
-        reactor_->end_reactor_event_loop();
+        (*itr)->Stop();
     }
+
     wait();
 }
 
+void WorldSocketMgr::GetNetworkStats(std::vector<WorldNetworkLoopStats>& stats) const
+{
+    stats.resize(m_loops.size());
+    for (size_t i = 0; i < m_loops.size(); ++i)
+    {
+        m_loops[i]->GetStats(stats[i]);
+    }
+}
+
 int WorldSocketMgr::OnSocketOpen(WorldSocket* sock)
 {
     // set some options here
@@ -156,7 +270,12 @@ int WorldSocketMgr::OnSocketOpen(WorldSocket* sock)
     }
 
     sock->m_OutBufferSize = static_cast<size_t>(m_SockOutUBuff);
-    sock->reactor(reactor_);
+    sock->m_InBufferSize = static_cast<size_t>(m_SockInUBuff);
+
+    WorldNetworkLoop* loop = m_loops[(++m_nextSocketLoop - 1) % m_loops.size()];
+    sock->m_NetworkLoop = loop;
+    sock->reactor(loop->GetReactor());
+    loop->OnSocketOpen();
 
     return 0;
 }
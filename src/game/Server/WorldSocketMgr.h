@@ -37,10 +37,74 @@
 #include <ace/INET_Addr.h>
 #include <ace/Task.h>
 #include <ace/Acceptor.h>
+#include <ace/Event_Handler.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
+#include <vector>
 
 class WorldSocket;
 
-/// This is a pool of threads designed to be used by an ACE_TP_Reactor.
+/// Delay in ms between two flushes of the output buffers of a network loop
+#define WORLD_SOCKET_FLUSH_DELAY 10
+
+/// Counters of one network loop, see WorldSocketMgr::GetNetworkStats
+struct WorldNetworkLoopStats
+{
+    long connections;
+    long inputEvents;
+    long outputEvents;
+    long flushes;
+};
+
+/// One reactor run by exactly one network thread.
+/// Sockets stay on the loop they were assigned to at accept time, so all
+/// their reactor callbacks are serialized without a shared demultiplexer.
+/// Output written by other threads is collected and sent by a timer every
+/// WORLD_SOCKET_FLUSH_DELAY ms, write readiness is only armed when the
+/// kernel buffer of a socket is full.
+class WorldNetworkLoop : public ACE_Event_Handler
+{
+    public:
+        WorldNetworkLoop();
+        ~WorldNetworkLoop();
+
+        int Open();
+        void Run();
+        void Stop();
+
+        ACE_Reactor* GetReactor() { return m_reactor; }
+
+        /// Socket has output for the next flush, called with no socket lock held
+        void QueueOutput(WorldSocket* sock);
+
+        void OnSocketOpen() { ++m_connections; }
+        void OnSocketClose() { --m_connections; }
+        void OnInputEvent() { ++m_inputEvents; }
+        void OnOutputEvent() { ++m_outputEvents; }
+
+        void GetStats(WorldNetworkLoopStats& stats) const;
+
+        /// Flush timer
+        int handle_timeout(const ACE_Time_Value& current_time, const void* act = 0) override;
+
+    private:
+        typedef std::vector<WorldSocket*> SocketList;
+        typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> Counter;
+
+        ACE_Reactor* m_reactor;
+
+        ACE_Thread_Mutex m_pendingLock;
+        SocketList m_pending;                               // holds a reference to each socket
+        SocketList m_flushing;                              // only used by the loop thread
+
+        Counter m_connections;
+        Counter m_inputEvents;
+        Counter m_outputEvents;
+        Counter m_flushes;
+};
+
+/// This is a pool of threads each running its own WorldNetworkLoop.
 /// Manages all sockets connected to peers
 
 class WorldSocketMgr : public ACE_Task_Base
@@ -51,6 +115,9 @@ class WorldSocketMgr : public ACE_Task_Base
         int StartNetwork(ACE_INET_Addr& addr);
         void StopNetwork();
 
+        /// Counters of all network loops, one entry per Network.Threads
+        void GetNetworkStats(std::vector<WorldNetworkLoopStats>& stats) const;
+
     private:
         int OnSocketOpen(WorldSocket* sock);
         virtual int svc();
@@ -61,9 +128,14 @@ class WorldSocketMgr : public ACE_Task_Base
     private:
         int m_SockOutKBuff;
         int m_SockOutUBuff;
+        int m_SockInUBuff;
         bool m_UseNoDelay;
 
-        ACE_Reactor   *reactor_;
+        typedef std::vector<WorldNetworkLoop*> NetworkLoopList;
+        NetworkLoopList m_loops;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_nextThreadLoop;     // loop taken by the next starting thread
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_nextSocketLoop;     // round robin for accepted sockets
+
         WorldAcceptor *acceptor_;
 };
 
@@ -27,7 +27,32 @@
 #include "World.h"
 #include "Database/DatabaseEnv.h"
 #include "DBCStores.h"
-#include "ProgressBar.h"
+#include "ObjectMgr.h"
+#include "SQLStorages.h"
+
+using namespace CharacterDatabaseCleaner;
+
+static CleanupCheck cleanupChecks[] =
+{
+    // flag                  table                        column           valid ids     parent table      parent column  item column
+    { CLEANING_FLAG_SKILLS,  "character_skills",          "skill",         &SkillIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_SPELLS,  "character_spell",           "spell",         &SpellIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_SPELLS,  "character_aura",            "spell",         &SpellIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_SPELLS,  "character_spell_cooldown",  "spell",         &SpellIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_SPELLS,  "pet_spell",                 "spell",         &SpellIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_SPELLS,  "pet_aura",                  "spell",         &SpellIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_SPELLS,  "pet_spell_cooldown",        "spell",         &SpellIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_ITEMS,   "character_inventory",       "item_template", &ItemIds,     NULL,             NULL,          "item",      0, false },
+    { CLEANING_FLAG_ITEMS,   "mail_items",                "item_template", &ItemIds,     NULL,             NULL,          "item_guid", 0, false },
+    { CLEANING_FLAG_QUESTS,  "character_queststatus",     "quest",         &QuestIds,    NULL,             NULL,          NULL,        0, false },
+    { CLEANING_FLAG_PETS,    "character_pet",             "entry",         &CreatureIds, NULL,             NULL,          NULL,        0, false },
+    // parent table checks, after the id checks that delete parent rows
+    { CLEANING_FLAG_ITEMS,   "character_inventory",       "item",          NULL,         "item_instance",  "guid",        NULL,        0, false },
+    { CLEANING_FLAG_PETS,    "pet_spell",                 "guid",          NULL,         "character_pet",  "id",          NULL,        0, false },
+    { CLEANING_FLAG_PETS,    "pet_aura",                  "guid",          NULL,         "character_pet",  "id",          NULL,        0, false },
+    { CLEANING_FLAG_PETS,    "pet_spell_cooldown",        "guid",          NULL,         "character_pet",  "id",          NULL,        0, false },
+    { CLEANING_FLAG_MAIL,    "mail_items",                "mail_id",       NULL,         "mail",           "id",          "item_guid", 0, false },
+};
 
 void CharacterDatabaseCleaner::CleanDatabase()
 {
@@ -37,8 +62,6 @@ void CharacterDatabaseCleaner::CleanDatabase()
         return;
     }
 
-    sLog.outString("Cleaning character database...");
-
     // check flags which clean ups are necessary
     QueryResult* result = CharacterDatabase.PQuery("SELECT `cleaning_flags` FROM `saved_variables`");
     if (!result)
@@ -48,78 +71,246 @@ void CharacterDatabaseCleaner::CleanDatabase()
     uint32 flags = (*result)[0].GetUInt32();
     delete result;
 
-    // clean up
-    if (flags & CLEANING_FLAG_SKILLS)
+    if (!flags)
     {
-        CleanCharacterSkills();
+        return;
     }
-    if (flags & CLEANING_FLAG_SPELLS)
+
+    bool dryRun = sWorld.getConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB_DRY_RUN);
+    sLog.outString("Cleaning character database%s...", dryRun ? " (dry run, nothing is deleted)" : "");
+
+    // the id checks delete rows the parent table checks look for, so they run first
+    std::vector<CleanupCheck> idChecks;
+    std::vector<CleanupCheck> parentChecks;
+    for (size_t i = 0; i < countof(cleanupChecks); ++i)
     {
-        CleanCharacterSpell();
+        if (flags & cleanupChecks[i].flag)
+        {
+            (cleanupChecks[i].validIds ? idChecks : parentChecks).push_back(cleanupChecks[i]);
+        }
     }
-    CharacterDatabase.Execute("UPDATE `saved_variables` SET `cleaning_flags` = 0");
-}
 
-void CharacterDatabaseCleaner::CheckUnique(const char* column, const char* table, bool (*check)(uint32))
-{
-    QueryResult* result = CharacterDatabase.PQuery("SELECT DISTINCT `%s` FROM `%s`", column, table);
-    if (!result)
+    RunChecks(idChecks, dryRun);
+    RunChecks(parentChecks, dryRun);
+
+    uint32 invalidRows = 0;
+    bool failed = false;
+    for (size_t i = 0; i < idChecks.size(); ++i)
     {
-        sLog.outString("Table %s is empty.", table);
-        return;
+        invalidRows += idChecks[i].invalidRows;
+        failed |= idChecks[i].failed;
+    }
+    for (size_t i = 0; i < parentChecks.size(); ++i)
+    {
+        invalidRows += parentChecks[i].invalidRows;
+        failed |= parentChecks[i].failed;
     }
 
-    bool found = false;
-    std::ostringstream ss;
-    BarGoLink bar(result->GetRowCount());
-    do
+    // mails that lost all their items
+    if (!dryRun && (flags & CLEANING_FLAG_ITEMS))
     {
-        bar.step();
+        failed |= !CharacterDatabase.DirectExecute("UPDATE `mail` m LEFT JOIN `mail_items` mi ON m.`id` = mi.`mail_id` SET m.`has_items` = 0 WHERE m.`has_items` = 1 AND mi.`mail_id` IS NULL");
+    }
 
-        Field* fields = result->Fetch();
+    sLog.outString(">> %u invalid character data rows %s", invalidRows, dryRun ? "found" : "deleted");
+    sLog.outString();
 
-        uint32 id = fields[0].GetUInt32();
+    // a dry run or failed check has to run again next start
+    if (!dryRun && !failed)
+    {
+        CharacterDatabase.Execute("UPDATE `saved_variables` SET `cleaning_flags` = 0");
+    }
+}
+
+class CleanupWorker : public ACE_Based::Runnable
+{
+    public:
+        CleanupWorker(std::vector<CleanupCheck>& checks, ACE_Atomic_Op<ACE_Thread_Mutex, long>& next, bool dryRun)
+            : m_checks(checks), m_next(next), m_dryRun(dryRun) {}
 
-        if (!check(id))
+        void run() override
         {
-            if (!found)
+            CharacterDatabase.ThreadStart();
+
+            SqlConnection* conn = CharacterDatabase.AcquireConnection();
+            for (long i = ++m_next - 1; i < long(m_checks.size()); i = ++m_next - 1)
             {
-                ss << "DELETE FROM `" << table << "` WHERE `" << column << "` IN (";
-                found = true;
+                CleanupCheck& check = m_checks[i];
+                if (!conn)
+                {
+                    check.failed = true;
+                    continue;
+                }
+
+                RunCheck(conn, check, m_dryRun);
+
+                if (check.failed)
+                {
+                    sLog.outError("CharacterDatabaseCleaner: Check of %s.%s failed", check.table, check.column);
+                }
+                else
+                {
+                    sLog.outString("CharacterDatabaseCleaner: [%li/%u] %s.%s: %u invalid rows", i + 1, uint32(m_checks.size()),
+                                   check.table, check.column, check.invalidRows);
+                }
             }
-            else
+
+            if (conn)
             {
-                ss << ",";
+                CharacterDatabase.ReleaseStreamConnection(conn);
             }
-            ss << id;
+
+            CharacterDatabase.ThreadEnd();
         }
+
+    private:
+        std::vector<CleanupCheck>& m_checks;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long>& m_next;
+        bool m_dryRun;
+};
+
+void CharacterDatabaseCleaner::RunChecks(std::vector<CleanupCheck>& checks, bool dryRun)
+{
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> next(0);
+    std::vector<ACE_Based::Thread*> threads;
+    for (size_t i = 0; i < CLEANER_THREADS && i < checks.size(); ++i)
+    {
+        threads.push_back(new ACE_Based::Thread(new CleanupWorker(checks, next, dryRun)));
     }
-    while (result->NextRow());
-    delete result;
 
-    if (found)
+    for (size_t i = 0; i < threads.size(); ++i)
     {
-        ss << ")";
-        CharacterDatabase.Execute(ss.str().c_str());
+        threads[i]->wait();
+        delete threads[i];                                  // This also deletes the worker
     }
 }
 
-bool CharacterDatabaseCleaner::SkillCheck(uint32 skill)
+void CharacterDatabaseCleaner::RunCheck(SqlConnection* conn, CleanupCheck& check, bool dryRun)
 {
-    return sSkillLineStore.LookupEntry(skill);
+    char const* parentTable = check.parentTable;
+    char const* parentColumn = check.parentColumn;
+
+    // temporary tables are per connection, every worker has its own
+    if (check.validIds)
+    {
+        parentTable = "cleaner_valid_ids";
+        parentColumn = "id";
+
+        if (!conn->Execute("CREATE TEMPORARY TABLE `cleaner_valid_ids` (`id` INT UNSIGNED NOT NULL PRIMARY KEY) ENGINE = MEMORY"))
+        {
+            check.failed = true;
+            return;
+        }
+
+        std::vector<uint32> ids;
+        check.validIds(ids);
+
+        // no known ids at all means a store failed to load, not that every row is invalid
+        check.failed = ids.empty();
+
+        std::string sql;
+        for (size_t i = 0; i < ids.size() && !check.failed; ++i)
+        {
+            sql += sql.empty() ? "INSERT INTO `cleaner_valid_ids` VALUES (" : ",(";
+            sql += std::to_string(ids[i]) + ")";
+            if (sql.size() > MAX_QUERY_LEN - 20 || i + 1 == ids.size())
+            {
+                check.failed = !conn->Execute(sql.c_str());
+                sql.clear();
+            }
+        }
+    }
+
+    // rows whose column has no match in the valid ids / parent table
+    char join[512];
+    snprintf(join, sizeof(join), "FROM `%s` c LEFT JOIN `%s` p ON c.`%s` = p.`%s` WHERE p.`%s` IS NULL",
+             check.table, parentTable, check.column, parentColumn, parentColumn);
+
+    if (!check.failed)
+    {
+        QueryResult* result = conn->Query((std::string("SELECT COUNT(*) ") + join).c_str());
+        if (result)
+        {
+            check.invalidRows = (*result)[0].GetUInt32();
+            delete result;
+        }
+        else
+        {
+            check.failed = true;
+        }
+    }
+
+    if (!check.failed && !dryRun && check.invalidRows)
+    {
+        if (check.itemColumn)
+        {
+            // the item instances of deleted rows would be left without owner
+            char itemJoin[640];
+            snprintf(itemJoin, sizeof(itemJoin), "DELETE c, i FROM `%s` c LEFT JOIN `%s` p ON c.`%s` = p.`%s` LEFT JOIN `item_instance` i ON c.`%s` = i.`guid` WHERE p.`%s` IS NULL",
+                     check.table, parentTable, check.column, parentColumn, check.itemColumn, parentColumn);
+            check.failed = !conn->Execute(itemJoin);
+        }
+        else
+        {
+            check.failed = !conn->Execute((std::string("DELETE c ") + join).c_str());
+        }
+    }
+
+    if (check.validIds)
+    {
+        conn->Execute("DROP TEMPORARY TABLE IF EXISTS `cleaner_valid_ids`");
+    }
 }
 
-void CharacterDatabaseCleaner::CleanCharacterSkills()
+void CharacterDatabaseCleaner::SkillIds(std::vector<uint32>& ids)
 {
-    CheckUnique("skill", "character_skills", &SkillCheck);
+    for (uint32 i = 0; i < sSkillLineStore.GetNumRows(); ++i)
+    {
+        if (sSkillLineStore.LookupEntry(i))
+        {
+            ids.push_back(i);
+        }
+    }
 }
 
-bool CharacterDatabaseCleaner::SpellCheck(uint32 spell_id)
+void CharacterDatabaseCleaner::SpellIds(std::vector<uint32>& ids)
 {
-    return sSpellStore.LookupEntry(spell_id);
+    for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
+    {
+        if (sSpellStore.LookupEntry(i))
+        {
+            ids.push_back(i);
+        }
+    }
 }
 
-void CharacterDatabaseCleaner::CleanCharacterSpell()
+void CharacterDatabaseCleaner::ItemIds(std::vector<uint32>& ids)
 {
-    CheckUnique("spell", "character_spell", &SpellCheck);
+    for (uint32 i = 0; i < sItemStorage.GetMaxEntry(); ++i)
+    {
+        if (sItemStorage.LookupEntry<ItemPrototype>(i))
+        {
+            ids.push_back(i);
+        }
+    }
+}
+
+void CharacterDatabaseCleaner::QuestIds(std::vector<uint32>& ids)
+{
+    ObjectMgr::QuestMap const& quests = sObjectMgr.GetQuestTemplates();
+    for (ObjectMgr::QuestMap::const_iterator itr = quests.begin(); itr != quests.end(); ++itr)
+    {
+        ids.push_back(itr->first);
+    }
+}
+
+void CharacterDatabaseCleaner::CreatureIds(std::vector<uint32>& ids)
+{
+    for (uint32 i = 0; i < sCreatureStorage.GetMaxEntry(); ++i)
+    {
+        if (sCreatureStorage.LookupEntry<CreatureInfo>(i))
+        {
+            ids.push_back(i);
+        }
+    }
 }
@@ -25,26 +25,61 @@
 #ifndef CHARACTERDATABASECLEANER_H
 #define CHARACTERDATABASECLEANER_H
 
+#include <vector>
+
+class SqlConnection;
+
+#define CLEANER_THREADS 4                                   // checks running at the same time, each on its own connection
+
+/**
+ * Removes character data referring to things the server doesn't know (anymore), e.g. after DBC or
+ * world DB updates. Which checks run is selected by saved_variables.cleaning_flags.
+ */
 namespace CharacterDatabaseCleaner
 {
     enum CleaningFlags
     {
         // reserved for next version          0x1
         CLEANING_FLAG_SKILLS                = 0x2,
-        CLEANING_FLAG_SPELLS                = 0x4,
+        CLEANING_FLAG_SPELLS                = 0x4,          // spells, auras and cooldowns of characters and pets
         // reserved for next version          0x8
+        CLEANING_FLAG_ITEMS                 = 0x10,         // item templates in inventory and mail, inventory without item, mail has_items
+        CLEANING_FLAG_QUESTS                = 0x20,
+        CLEANING_FLAG_PETS                  = 0x40,         // pet creature templates, pet data without pet
+        CLEANING_FLAG_MAIL                  = 0x80,         // mail items without mail
     };
 
+    typedef void (*ValidIdsFn)(std::vector<uint32>& ids);
 
-    void CleanDatabase();
+    /**
+     * One column checked with set based statements: either against the ids the server knows
+     * (loaded into a temporary table) or against the key of a parent table.
+     */
+    struct CleanupCheck
+    {
+        uint32 flag;
+        char const* table;
+        char const* column;
+        ValidIdsFn validIds;                                // NULL for parent table checks
+        char const* parentTable;
+        char const* parentColumn;
+        char const* itemColumn;                             // item guid column, its item_instance rows are deleted too
 
-    void CheckUnique(const char* column, const char* table, bool (*check)(uint32));
+        uint32 invalidRows;                                 // result, rows found (and deleted unless dry run)
+        bool failed;
+    };
+
+    void CleanDatabase();
 
-    bool SkillCheck(uint32 skill);
-    bool SpellCheck(uint32 spell_id);
+    /// run the checks on CLEANER_THREADS threads
+    void RunChecks(std::vector<CleanupCheck>& checks, bool dryRun);
+    void RunCheck(SqlConnection* conn, CleanupCheck& check, bool dryRun);
 
-    void CleanCharacterSkills();
-    void CleanCharacterSpell();
+    void SkillIds(std::vector<uint32>& ids);
+    void SpellIds(std::vector<uint32>& ids);
+    void ItemIds(std::vector<uint32>& ids);
+    void QuestIds(std::vector<uint32>& ids);
+    void CreatureIds(std::vector<uint32>& ids);
 }
 
 #endif
@@ -27,9 +27,13 @@
 #include "Database/DatabaseEnv.h"
 #include "SQLStorages.h"
 #include "UpdateFields.h"
+#include "UpdateFieldBlob.h"
 #include "ObjectMgr.h"
 #include "AccountMgr.h"
 
+#include <ace/Dirent.h>
+#include <fstream>
+
 // Character Dump tables
 struct DumpTable
 {
@@ -67,110 +71,105 @@ static DumpTable dumpTables[] =
     { NULL,                               DTT_CHAR_TABLE }, // end marker
 };
 
-// Low level functions
-static bool findtoknth(std::string& str, int n, std::string::size_type& s, std::string::size_type& e)
+// Column lists and select statements of the dump tables, loaded once and shared by all dump threads
+struct DumpTableColumns
 {
-    int i; s = e = 0;
-    std::string::size_type size = str.size();
-    for (i = 1; s < size && i < n; ++s) if (str[s] == ' ')
-    {
-        ++i;
-    }
-    if (i < n)
-    {
-        return false;
-    }
-
-    e = str.find(' ', s);
+    std::vector<std::string> names;
+    std::string list;                                       // "`guid`,`name`,..."
+    std::string select;                                     // prepared select by owner, unused for tables selected by guid sets
+    SqlStatementID selectStmt;
+};
 
-    return e != std::string::npos;
-}
+static DumpTableColumns dumpTableColumns[countof(dumpTables)];
+static ACE_Thread_Mutex dumpTableColumnsLock;
+static bool dumpTableColumnsLoaded = false;
 
-std::string gettoknth(std::string& str, int n)
+// field the rows of a table are selected by, guids is set for tables selected by the guids collected before
+static char const* GetDumpTableKey(DumpTableType type, bool& byGuidSet)
 {
-    std::string::size_type s = 0, e = 0;
-    if (!findtoknth(str, n, s, e))
+    byGuidSet = false;
+    switch (type)
     {
-        return "";
+        case DTT_ITEM:      byGuidSet = true; return "guid";
+        case DTT_ITEM_GIFT: byGuidSet = true; return "item_guid";
+        case DTT_ITEM_LOOT: byGuidSet = true; return "guid";
+        case DTT_PET:                         return "owner";
+        case DTT_PET_TABLE: byGuidSet = true; return "guid";
+        case DTT_PET_DECL:                    return "id";
+        case DTT_MAIL:                        return "receiver";
+        case DTT_MAIL_ITEM: byGuidSet = true; return "mail_id";
+        default:                              return "guid";
     }
-
-    return str.substr(s, e - s);
 }
 
-bool findnth(std::string& str, int n, std::string::size_type& s, std::string::size_type& e)
+static void LoadDumpTableColumns()
 {
-    s = str.find("VALUES ('") + 9;
-    if (s == std::string::npos)
+    ACE_GUARD(ACE_Thread_Mutex, guard, dumpTableColumnsLock);
+    if (dumpTableColumnsLoaded)
     {
-        return false;
+        return;
     }
 
-    do
+    for (uint32 i = 0; dumpTables[i].isValid(); ++i)
     {
-        e = str.find("'", s);
-        if (e == std::string::npos)
+        DumpTableColumns& columns = dumpTableColumns[i];
+
+        QueryResult* result = CharacterDatabase.PQuery("SHOW COLUMNS FROM `%s`", dumpTables[i].name);
+        if (!result)
         {
-            return false;
+            sLog.outError("PlayerDump: Can't get the columns of table `%s`, it will not be dumped", dumpTables[i].name);
+            continue;
         }
-    }
-    while (str[e - 1] == '\\');
 
-    for (int i = 1; i < n; ++i)
-    {
         do
         {
-            s = e + 4;
-            e = str.find("'", s);
-            if (e == std::string::npos)
+            std::string name = result->Fetch()[0].GetCppString();
+            if (!columns.list.empty())
             {
-                return false;
+                columns.list += ",";
             }
+            columns.list += "`" + name + "`";
+            columns.names.push_back(name);
         }
-        while (str[e - 1] == '\\');
-    }
-    return true;
-}
+        while (result->NextRow());
 
-std::string gettablename(std::string& str)
-{
-    std::string::size_type s = 13;
-    std::string::size_type e = str.find('`', s);
-    if (e == std::string::npos)
-    {
-        return "";
+        delete result;
+
+        bool byGuidSet;
+        char const* key = GetDumpTableKey(dumpTables[i].type, byGuidSet);
+        if (!byGuidSet)
+        {
+            columns.select = "SELECT " + columns.list + " FROM `" + dumpTables[i].name + "` WHERE `" + key + "` = ?";
+            CharacterDatabase.CreateStatement(columns.selectStmt, columns.select.c_str());
+        }
     }
 
-    return str.substr(s, e - s);
+    dumpTableColumnsLoaded = true;
 }
 
-bool changenth(std::string& str, int n, const char* with, bool insert = false, bool nonzero = false)
+// Low level functions
+static bool findtoknth(std::string& str, int n, std::string::size_type& s, std::string::size_type& e)
 {
-    std::string::size_type s, e;
-    if (!findnth(str, n, s, e))
-    {
-        return false;
-    }
-
-    if (nonzero && str.substr(s, e - s) == "0")
-    {
-        return true;                                         // not an error
-    }
-    if (!insert)
+    int i; s = e = 0;
+    std::string::size_type size = str.size();
+    for (i = 1; s < size && i < n; ++s) if (str[s] == ' ')
     {
-        str.replace(s, e - s, with);
+        ++i;
     }
-    else
+    if (i < n)
     {
-        str.insert(s, with);
+        return false;
     }
 
-    return true;
+    e = str.find(' ', s);
+
+    return e != std::string::npos;
 }
 
-std::string getnth(std::string& str, int n)
+std::string gettoknth(std::string& str, int n)
 {
-    std::string::size_type s, e;
-    if (!findnth(str, n, s, e))
+    std::string::size_type s = 0, e = 0;
+    if (!findtoknth(str, n, s, e))
     {
         return "";
     }
@@ -201,9 +200,10 @@ bool changetoknth(std::string& str, int n, const char* with, bool insert = false
     return true;
 }
 
-uint32 registerNewGuid(uint32 oldGuid, std::map<uint32, uint32>& guidMap, uint32 hiGuid)
+template<class GuidMap>
+uint32 registerNewGuid(uint32 oldGuid, GuidMap& guidMap, uint32 hiGuid)
 {
-    std::map<uint32, uint32>::const_iterator itr = guidMap.find(oldGuid);
+    typename GuidMap::const_iterator itr = guidMap.find(oldGuid);
     if (itr != guidMap.end())
     {
         return itr->second;
@@ -214,10 +214,11 @@ uint32 registerNewGuid(uint32 oldGuid, std::map<uint32, uint32>& guidMap, uint32
     return newguid;
 }
 
-bool changeGuid(std::string& str, int n, std::map<uint32, uint32>& guidMap, uint32 hiGuid, bool nonzero = false)
+template<class GuidMap>
+bool changetokGuid(std::string& str, int n, GuidMap& guidMap, uint32 hiGuid, bool nonzero = false)
 {
     char chritem[20];
-    uint32 oldGuid = atoi(getnth(str, n).c_str());
+    uint32 oldGuid = atoi(gettoknth(str, n).c_str());
     if (nonzero && oldGuid == 0)
     {
         return true;                                         // not an error
@@ -226,55 +227,111 @@ bool changeGuid(std::string& str, int n, std::map<uint32, uint32>& guidMap, uint
     uint32 newGuid = registerNewGuid(oldGuid, guidMap, hiGuid);
     snprintf(chritem, 20, "%u", newGuid);
 
-    return changenth(str, n, chritem, false, nonzero);
+    return changetoknth(str, n, chritem, false, nonzero);
 }
 
-bool changetokGuid(std::string& str, int n, std::map<uint32, uint32>& guidMap, uint32 hiGuid, bool nonzero = false)
+// n-th (1 based) value of a dumped row
+static bool changenth(DumpRow& row, uint32 n, std::string const& with)
 {
-    char chritem[20];
-    uint32 oldGuid = atoi(gettoknth(str, n).c_str());
-    if (nonzero && oldGuid == 0)
+    if (n == 0 || n > row.size())
     {
-        return true;                                         // not an error
+        return false;
     }
 
-    uint32 newGuid = registerNewGuid(oldGuid, guidMap, hiGuid);
-    snprintf(chritem, 20, "%u", newGuid);
+    row[n - 1].str = with;
+    row[n - 1].isNull = false;
+    return true;
+}
 
-    return changetoknth(str, n, chritem, false, nonzero);
+static std::string getnth(DumpRow const& row, uint32 n)
+{
+    return n && n <= row.size() ? row[n - 1].str : std::string();
 }
 
-std::string CreateDumpString(char const* tableName, char const* tableColumnNamesAsChars, QueryResult* result)
+template<class GuidMap>
+bool changeGuid(DumpRow& row, uint32 n, GuidMap& guidMap, uint32 hiGuid, bool nonzero = false)
 {
-    if (!tableName || !result)
+    uint32 oldGuid = atoi(getnth(row, n).c_str());
+    if (nonzero && oldGuid == 0)
     {
-        return "";
+        return n <= row.size();                             // not an error
     }
 
-    std::ostringstream ss;
-    ss << "INSERT INTO `" << tableName << "` ("<< tableColumnNamesAsChars  <<") VALUES (";
-    Field* fields = result->Fetch();
-    for (uint32 i = 0; i < result->GetFieldCount(); ++i)
+    return changenth(row, n, std::to_string(registerNewGuid(oldGuid, guidMap, hiGuid)));
+}
+
+// Dump format: tab separated, "\N" is NULL, backslash escapes tab, newline and itself
+static void AppendDumpValue(std::string& dump, Field const& field)
+{
+    if (field.IsNULL())
     {
-        if (i != 0)
+        dump += "\\N";
+        return;
+    }
+
+    std::string str = field.GetCppString();
+    for (std::string::const_iterator itr = str.begin(); itr != str.end(); ++itr)
+    {
+        switch (*itr)
         {
-            ss << ", ";
+            case '\\': dump += "\\\\"; break;
+            case '\t': dump += "\\t";  break;
+            case '\n': dump += "\\n";  break;
+            case '\r': dump += "\\r";  break;
+            default:   dump += *itr;   break;
         }
+    }
+}
 
-        if (fields[i].IsNULL())
+static void SplitDumpLine(std::string const& line, DumpRow& values)
+{
+    DumpValue value;
+    for (std::string::size_type i = 0; i <= line.size(); ++i)
+    {
+        if (i == line.size() || line[i] == '\t')
         {
-            ss << "NULL";
+            values.push_back(value);
+            value = DumpValue();
+            continue;
         }
-        else
+
+        if (line[i] != '\\' || i + 1 == line.size())
         {
-            std::string s =  fields[i].GetCppString();
-            CharacterDatabase.escape_string(s);
+            value.str += line[i];
+            continue;
+        }
 
-            ss << "'" << s << "'";
+        switch (line[++i])
+        {
+            case 't': value.str += '\t'; break;
+            case 'n': value.str += '\n'; break;
+            case 'r': value.str += '\r'; break;
+            case 'N': value.isNull = true; break;
+            default:  value.str += line[i]; break;
         }
     }
-    ss << ");";
-    return ss.str();
+}
+
+static std::string GetCharacterDBVersion(std::string* description = NULL)
+{
+    QueryResult* result = CharacterDatabase.Query("SELECT `version`, `structure`, `description`, `comment` FROM `db_version` ORDER BY `version` DESC, `structure` DESC, `content` ASC LIMIT 1");
+    if (!result)
+    {
+        sLog.outError("Character DB not have 'db_version' table");
+        return "";
+    }
+
+    Field* fields = result->Fetch();
+
+    // Only version / structure is needed
+    std::string version = std::to_string(fields[0].GetInt16()) + "." + std::to_string(fields[1].GetInt16()) + ".X";
+    if (description)
+    {
+        *description = fields[2].GetCppString() + " / " + fields[3].GetCppString();
+    }
+
+    delete result;
+    return version;
 }
 
 std::string PlayerDumpWriter::GenerateWhereStr(char const* field, uint32 guid)
@@ -318,40 +375,34 @@ void StoreGUID(QueryResult* result, uint32 field, std::set<uint32>& guids)
     }
 }
 
-void StoreGUID(QueryResult* result, uint32 data, uint32 field, std::set<uint32>& guids)
+// Writing - High-level functions
+void PlayerDumpWriter::DumpTableContent(std::string& dump, uint32 guid, uint32 tableIdx)
 {
-    Field* fields = result->Fetch();
-    std::string dataStr = fields[data].GetCppString();
-    uint32 guid = atoi(gettoknth(dataStr, field).c_str());
-    if (guid)
+    DumpTable const& table = dumpTables[tableIdx];
+    DumpTableColumns& columns = dumpTableColumns[tableIdx];
+    if (columns.names.empty())
     {
-        guids.insert(guid);
+        return;                                             // table missing, reported at load
     }
-}
 
-// Writing - High-level functions
-void PlayerDumpWriter::DumpTableContent(std::string& dump, uint32 guid, char const* tableFrom, char const* tableTo, DumpTableType type)
-{
-    GUIDs const* guids = NULL;
-    char const* fieldname = NULL;
+    bool byGuidSet;
+    char const* fieldname = GetDumpTableKey(table.type, byGuidSet);
 
-    switch (type)
+    GUIDs const* guids = NULL;
+    if (byGuidSet)
     {
-        case DTT_ITEM:      fieldname = "guid";      guids = &items; break;
-        case DTT_ITEM_GIFT: fieldname = "item_guid"; guids = &items; break;
-        case DTT_ITEM_LOOT: fieldname = "guid";      guids = &items; break;
-        case DTT_PET:       fieldname = "owner";                     break;
-        case DTT_PET_TABLE: fieldname = "guid";      guids = &pets;  break;
-        case DTT_PET_DECL:  fieldname = "id";                        break;
-        case DTT_MAIL:      fieldname = "receiver";                  break;
-        case DTT_MAIL_ITEM: fieldname = "mail_id";   guids = &mails; break;
-        default:            fieldname = "guid";                      break;
-    }
+        switch (table.type)
+        {
+            case DTT_PET_TABLE: guids = &pets;  break;
+            case DTT_MAIL_ITEM: guids = &mails; break;
+            default:            guids = &items; break;
+        }
 
-    // for guid set stop if set is empty
-    if (guids && guids->empty())
-    {
-        return;                                              // nothing to do
+        // for guid set stop if set is empty
+        if (guids->empty())
+        {
+            return;                                          // nothing to do
+        }
     }
 
     // setup for guids case start position
@@ -361,53 +412,41 @@ void PlayerDumpWriter::DumpTableContent(std::string& dump, uint32 guid, char con
         guids_itr = guids->begin();
     }
 
+    bool header = false;
     do
     {
-        std::string wherestr;
-
-        if (guids)                                          // set case, get next guids string
+        QueryResult* result;
+        if (guids)                                          // set case, the guid list differs per call
         {
-            wherestr = GenerateWhereStr(fieldname, *guids, guids_itr);
+            result = CharacterDatabase.PQuery("SELECT %s FROM `%s` WHERE %s", columns.list.c_str(), table.name, GenerateWhereStr(fieldname, *guids, guids_itr).c_str());
         }
-        else                                                // not set case, get single guid string
+        else                                                // not set case, same statement for every character
         {
-            wherestr = GenerateWhereStr(fieldname, guid);
+            SqlStatement stmt = CharacterDatabase.CreateStatement(columns.selectStmt, columns.select.c_str());
+            result = stmt.PQuery(guid);
         }
 
-        // fetch table columns
-        std::string tableColumnNamesStr = "";
-        QueryNamedResult* resNames = CharacterDatabase.PQueryNamed("SELECT * FROM `%s` LIMIT 1", tableFrom);
-        if (!resNames)
-        {
-            return;
-        }
-        // There will be a result since if not the code does not hit lines before... so no check needed
-        QueryFieldNames const& namesMap = resNames->GetFieldNames();
-
-        for (QueryFieldNames::const_iterator itr = namesMap.begin(); itr != namesMap.end(); ++itr)
+        if (!result)
         {
-            tableColumnNamesStr += "`" + *itr  +"`,";
+            continue;
         }
-        // remove last character of tableColumnNamesStr = ","
-        tableColumnNamesStr.pop_back();
-
-        // Create a non-const copy of namesMap to clear it
-        QueryFieldNames nonConstNamesMap = namesMap;
-        nonConstNamesMap.clear(); // Clear the contents of the vector
 
-        // fetch results of the table
-        QueryResult* result = CharacterDatabase.PQuery("SELECT %s FROM `%s` WHERE %s", tableColumnNamesStr.c_str(), tableFrom, wherestr.c_str());
-        if (!result)
+        if (!header)
         {
-            return;
+            dump += "T\t";
+            dump += table.name;
+            for (std::vector<std::string>::const_iterator itr = columns.names.begin(); itr != columns.names.end(); ++itr)
+            {
+                dump += "\t" + *itr;
+            }
+            dump += "\n";
+            header = true;
         }
 
-
-
         do
         {
             // collect guids
-            switch (type)
+            switch (table.type)
             {
                 case DTT_INVENTORY:
                     StoreGUID(result, 3, items); break;     // item guid collection
@@ -420,7 +459,13 @@ void PlayerDumpWriter::DumpTableContent(std::string& dump, uint32 guid, char con
                 default:                       break;
             }
 
-            dump += CreateDumpString(tableTo, tableColumnNamesStr.c_str(), result);
+            dump += "R";
+            Field* fields = result->Fetch();
+            for (uint32 i = 0; i < result->GetFieldCount(); ++i)
+            {
+                dump += "\t";
+                AppendDumpValue(dump, fields[i]);
+            }
             dump += "\n";
         }
         while (result->NextRow());
@@ -432,37 +477,29 @@ void PlayerDumpWriter::DumpTableContent(std::string& dump, uint32 guid, char con
 
 std::string PlayerDumpWriter::GetDump(uint32 guid)
 {
+    LoadDumpTableColumns();
+
     std::string dump;
 
-    dump += "IMPORTANT NOTE: This sql queries not created for apply directly, use '.pdump load' command in console or client chat instead.\n";
-    dump += "IMPORTANT NOTE: NOT APPLY ITS DIRECTLY to character DB or you will DAMAGE and CORRUPT character DB\n";
+    dump += "# Player dump, load it with the '.pdump load' command in console or client chat, it is not SQL.\n";
+    dump += "PDUMP\t" + std::to_string(PLAYER_DUMP_VERSION) + "\n";
 
     // revision check guard
-    // Check the revision of character DB which will be the first  line of the whole version/structure set
-    QueryResult* result = CharacterDatabase.Query("SELECT `version`, `structure`, `description`, `comment` FROM `db_version` ORDER BY `version` DESC, `structure` DESC, `content` ASC LIMIT 1");
-
-    if (result)
-    {
-        Field* fields = result->Fetch();
-
-        dump += "DUMPED_WITH:"+std::to_string(fields[0].GetInt16())
-        + "." + std::to_string(fields[1].GetInt16()) + ".X "
-        +" CHAR. DB VERSION ( "
-        + fields[2].GetCppString() + " / "
-        + fields[3].GetCppString()  +
-         ")\n\n"
-        ;
-
-        delete result;
-    }
-    else
+    std::string description;
+    std::string version = GetCharacterDBVersion(&description);
+    if (!version.empty())
     {
-        sLog.outError("Character DB not have 'db_version' table");
+        dump += "DB\t" + version + "\t";
+        for (std::string::const_iterator itr = description.begin(); itr != description.end(); ++itr)
+        {
+            dump += *itr == '\t' || *itr == '\n' ? ' ' : *itr;
+        }
+        dump += "\n";
     }
 
-    for (DumpTable* itr = &dumpTables[0]; itr->isValid(); ++itr)
+    for (uint32 i = 0; dumpTables[i].isValid(); ++i)
     {
-        DumpTableContent(dump, guid, itr->name, itr->name, itr->type);
+        DumpTableContent(dump, guid, i);
     }
 
     // TODO: Add instance/group..
@@ -486,421 +523,588 @@ DumpReturn PlayerDumpWriter::WriteDump(const std::string& file, uint32 guid)
     return DUMP_SUCCESS;
 }
 
-// Reading - High-level functions
-#define ROLLBACK(DR) {CharacterDatabase.RollbackTransaction(); fclose(fin); return (DR);}
-
-DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, std::string name, uint32 guid)
+// Reading - Low-level functions
+DumpTableRows* PlayerDumpReader::AddTable(std::string const& name, std::string const& columns)
 {
-    bool nameInvalidated = false;                           // set when name changed or will requested changed at next login
+    // old dumps have one INSERT per row
+    if (!m_tables.empty() && m_tables.back().name == name && m_tables.back().columns == columns)
+    {
+        return &m_tables.back();
+    }
 
-    // check character count
-    uint32 charcount = sAccountMgr.GetCharactersCount(account);
-    if (charcount >= 10)
+    DumpTable* dTable = &dumpTables[0];
+    for (; dTable->isValid(); ++dTable)
     {
-        return DUMP_TOO_MANY_CHARS;
+        if (name == dTable->name)
+        {
+            break;
+        }
     }
 
-    FILE* fin = fopen(file.c_str(), "r");
-    if (!fin)
+    if (!dTable->isValid())
     {
-        return DUMP_FILE_OPEN_ERROR;
+        sLog.outError("LoadPlayerDump: Unknown table: '%s'!", name.c_str());
+        return NULL;
     }
 
-    QueryResult* result = NULL;
-    char newguid[20], chraccount[20], newpetid[20], currpetid[20], lastpetid[20];
+    m_tables.push_back(DumpTableRows());
+    DumpTableRows& table = m_tables.back();
+    table.name = name;
+    table.columns = columns;
+    table.columnCount = 0;
+    table.type = dTable->type;
+    return &table;
+}
 
-    // make sure the same guid doesn't already exist and is safe to use
-    bool incHighest = true;
-    if (guid != 0 && guid < sObjectMgr.m_CharGuids.GetNextAfterMaxUsed())
+bool PlayerDumpReader::ReadLine(std::string const& line)
+{
+    DumpRow values;
+    SplitDumpLine(line, values);
+
+    std::string const& tag = values[0].str;
+    if (tag == "DB")
     {
-        result = CharacterDatabase.PQuery("SELECT * FROM `characters` WHERE `guid` = '%u'", guid);
-        if (result)
+        m_dbVersion = values.size() > 1 ? values[1].str : "";
+        return true;
+    }
+
+    if (tag == "T")
+    {
+        if (values.size() < 3)
         {
-            guid = sObjectMgr.m_CharGuids.GetNextAfterMaxUsed();
-            delete result;
+            return false;
         }
-        else
+
+        std::string columns;
+        for (size_t i = 2; i < values.size(); ++i)
         {
-            incHighest = false;
+            columns += (i > 2 ? ",`" : "`") + values[i].str + "`";
         }
-    }
-    else
-    {
-        guid = sObjectMgr.m_CharGuids.GetNextAfterMaxUsed();
-    }
 
-    // normalize the name if specified and check if it exists
-    if (!normalizePlayerName(name))
-    {
-        name.clear();
+        DumpTableRows* table = AddTable(values[1].str, columns);
+        if (!table)
+        {
+            return false;
+        }
+
+        table->columnCount = values.size() - 2;
+        return true;
     }
 
-    if (ObjectMgr::CheckPlayerName(name, true) == CHAR_NAME_SUCCESS)
+    if (tag == "R")
     {
-        CharacterDatabase.escape_string(name);              // for safe, we use name only for sql quearies anyway
-        result = CharacterDatabase.PQuery("SELECT * FROM `characters` WHERE `name` = '%s'", name.c_str());
-        if (result)
+        if (m_tables.empty() || values.size() != m_tables.back().columnCount + 1)
         {
-            name.clear();                                      // use the one from the dump
-            delete result;
+            sLog.outError("LoadPlayerDump: Row without table or with wrong column count: '%s'!", line.c_str());
+            return false;
         }
+
+        values.erase(values.begin());
+        m_tables.back().rows.push_back(values);
+        return true;
     }
-    else
+
+    sLog.outError("LoadPlayerDump: Unknown line: '%s'!", line.c_str());
+    return false;
+}
+
+// INSERT INTO `table` (`column`, ...) VALUES ('value', NULL, ...);
+bool PlayerDumpReader::ReadLegacyLine(std::string const& line)
+{
+    // skip NOTE
+    if (line.compare(0, 15, "IMPORTANT NOTE:") == 0)
     {
-        name.clear();
+        return true;
     }
 
-    // name encoded or empty
+    if (line.compare(0, 12, "DUMPED_WITH:") == 0)
+    {
+        m_dbVersion = line.substr(12, line.find(' ', 12) - 12);
+        return true;
+    }
 
-    snprintf(newguid, 20, "%u", guid);
-    snprintf(chraccount, 20, "%u", account);
-    snprintf(newpetid, 20, "%u", sObjectMgr.GeneratePetNumber());
-    snprintf(lastpetid, 20, "%s", "");
+    std::string::size_type pos = line.find('`', 13);
+    if (line.compare(0, 13, "INSERT INTO `") != 0 || pos == std::string::npos)
+    {
+        sLog.outError("LoadPlayerDump: Can't extract table name from line: '%s'!", line.c_str());
+        return false;
+    }
 
-    std::map<uint32, uint32> items;
-    std::map<uint32, uint32> mails;
-    std::map<uint32, uint32> itemTexts;
-    char buf[32000] = "";
+    std::string name = line.substr(13, pos - 13);
 
-    typedef std::map<uint32, uint32> PetIds;                // old->new petid relation
-    typedef PetIds::value_type PetIdsPair;
-    PetIds petids;
+    std::string::size_type values = line.find("VALUES (", pos);
+    if (values == std::string::npos)
+    {
+        return false;
+    }
 
-    CharacterDatabase.BeginTransaction();
-    while (!feof(fin))
+    std::string columns;
+    std::string::size_type open = line.find('(', pos);
+    if (open < values)
     {
-        if (!fgets(buf, 32000, fin))
+        std::string::size_type close = line.find(')', open);
+        if (close > values)
         {
-            if (feof(fin))
-            {
-                break;
-            }
-            ROLLBACK(DUMP_FILE_BROKEN);
+            return false;
         }
 
-        std::string line; line.assign(buf);
+        columns = line.substr(open + 1, close - open - 1);
+    }
+
+    DumpTableRows* table = AddTable(name, columns);
+    if (!table)
+    {
+        return false;
+    }
 
-        // skip empty strings
-        size_t nw_pos = line.find_first_not_of(" \t\n\r\7");
-        if (nw_pos == std::string::npos)
+    DumpRow row;
+    pos = values + 8;
+    while (true)
+    {
+        pos = line.find_first_not_of(' ', pos);
+        if (pos == std::string::npos)
         {
-            continue;
+            return false;
         }
 
-        // skip NOTE
-        if (line.substr(nw_pos, 15) == "IMPORTANT NOTE:")
+        DumpValue value;
+        if (line.compare(pos, 4, "NULL") == 0)
         {
-            continue;
+            value.isNull = true;
+            pos += 4;
         }
-
-        // Check db version corresp.
-        std::string dbVersionLinePrefix = line.substr(nw_pos, 12);
-
-        if (dbVersionLinePrefix =="DUMPED_WITH:")
+        else if (line[pos] == '\'')
         {
-            QueryResult* result = CharacterDatabase.Query("SELECT `version`, `structure`, `description`, `comment` FROM `db_version` ORDER BY `version` DESC, `structure` DESC, `content` ASC LIMIT 1");
-
-            if (result)
+            // undo Database::escape_string
+            for (++pos; pos < line.size() && line[pos] != '\''; ++pos)
             {
-                Field* fields = result->Fetch();
-                // Only version / structure is needed
-                std::string dbversion = std::to_string(fields[0].GetInt16()) + "." + std::to_string(fields[1].GetInt16())+".X";
-                size_t dbversionLen = dbversion.size();
-
-                std::string dbversionInDumpFile = line.substr(nw_pos+12, dbversionLen);
-
-               delete result;
-
-                if (dbversionInDumpFile != dbversion)
+                if (line[pos] != '\\' || pos + 1 == line.size())
                 {
-                    sLog.outError("LoadPlayerDump: Cannot load player dump - file version is %s, DB needs %s", dbversionInDumpFile.c_str(), dbversion.c_str());
-                    ROLLBACK(DUMP_DB_VERSION_MISMATCH);
+                    value.str += line[pos];
+                    continue;
                 }
-                else
+
+                switch (line[++pos])
                 {
-                    continue;
+                    case '0': value.str += '\0';   break;
+                    case 'n': value.str += '\n';   break;
+                    case 'r': value.str += '\r';   break;
+                    case 'Z': value.str += '\x1a'; break;
+                    default:  value.str += line[pos]; break;
                 }
             }
-        }
-
-        // determine table name and load type
-        std::string tn = gettablename(line);
-        if (tn.empty())
-        {
-            sLog.outError("LoadPlayerDump: Can't extract table name from line: '%s'!", line.c_str());
-            ROLLBACK(DUMP_FILE_BROKEN);
-        }
 
-        DumpTableType type = DTT_CHARACTER;                 // Fixed: Using uninitialized memory 'type'
-        DumpTable* dTable = &dumpTables[0];
-        for (; dTable->isValid(); ++dTable)
-        {
-            if (tn == dTable->name)
+            if (pos >= line.size())
             {
-                type = dTable->type;
-                break;
+                return false;
             }
-        }
 
-        if (!dTable->isValid())
+            ++pos;                                          // closing quote
+        }
+        else
         {
-            sLog.outError("LoadPlayerDump: Unknown table: '%s'!", tn.c_str());
-            ROLLBACK(DUMP_FILE_BROKEN);
+            return false;
         }
 
-        bool execute_ok = true;                             // false, if need skip soem query
+        row.push_back(value);
 
-        // change the data to server values
-        switch (type)
+        pos = line.find_first_not_of(' ', pos);
+        if (pos == std::string::npos)
         {
-            case DTT_CHAR_TABLE:
-                if (!changenth(line, 1, newguid))           // character_*.guid update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                break;
-
-            case DTT_CHAR_NAME_TABLE:
-                if (nameInvalidated)                        // ignore declined names if name will changed in some way
-                {
-                    execute_ok = false;
-                    break;
-                }
-
-                if (!changenth(line, 1, newguid))           // character_*.guid update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                break;
+            return false;
+        }
 
-            case DTT_CHARACTER:
-            {
-                if (!changenth(line, 1, newguid))           // characters.guid update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
+        if (line[pos] == ')')
+        {
+            break;
+        }
 
-                if (!changenth(line, 2, chraccount))        // characters.account update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
+        if (line[pos] != ',')
+        {
+            return false;
+        }
 
-                if (name.empty())
-                {
-                    // check if the original name already exists
-                    name = getnth(line, 3);                 // characters.name
-                    CharacterDatabase.escape_string(name);
+        ++pos;
+    }
 
-                    result = CharacterDatabase.PQuery("SELECT * FROM `characters` WHERE `name` = '%s'", name.c_str());
-                    if (result)
-                    {
-                        delete result;
+    table->rows.push_back(row);
+    return true;
+}
 
-                        if (!changenth(line, 36, "1"))      // characters.at_login set to "rename on login"
-                        {
-                            ROLLBACK(DUMP_FILE_BROKEN);
-                        }
+DumpRow* PlayerDumpReader::FindCharacterRow()
+{
+    for (std::vector<DumpTableRows>::iterator itr = m_tables.begin(); itr != m_tables.end(); ++itr)
+    {
+        if (itr->type == DTT_CHARACTER && !itr->rows.empty())
+        {
+            return &itr->rows.front();
+        }
+    }
 
-                        nameInvalidated = true;
-                    }
-                }
-                else
-                {
-                    if (!changenth(line, 3, name.c_str()))  // characters.name update
-                    {
-                        ROLLBACK(DUMP_FILE_BROKEN);
-                    }
+    return NULL;
+}
 
-                    nameInvalidated = true;
-                }
+// one multi-row INSERT per MAX_QUERY_LEN
+static bool InsertDumpRows(DumpTableRows const& table)
+{
+    std::string head = "INSERT INTO `" + table.name + "`";
+    if (!table.columns.empty())
+    {
+        head += " (" + table.columns + ")";
+    }
+    head += " VALUES ";
 
-                break;
-            }
-            case DTT_INVENTORY:
+    std::string sql;
+    for (std::vector<DumpRow>::const_iterator row = table.rows.begin(); row != table.rows.end(); ++row)
+    {
+        std::string values = "(";
+        for (DumpRow::const_iterator itr = row->begin(); itr != row->end(); ++itr)
+        {
+            if (itr != row->begin())
             {
-                if (!changenth(line, 1, newguid))           // character_inventory.guid update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-
-                if (!changeGuid(line, 2, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed(), true))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // character_inventory.bag update
-                }
-                if (!changeGuid(line, 4, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed()))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // character_inventory.item update
-                }
-                break;
+                values += ", ";
             }
-            case DTT_ITEM:
+
+            if (itr->isNull)
             {
-                // item, owner, data field:item, owner guid
-                if (!changeGuid(line, 1, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed()))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // item_instance.guid update
-                }
-                if (!changenth(line, 2, newguid))           // item_instance.owner_guid update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                std::string vals = getnth(line, 3);         // item_instance.data get
-                if (!changetokGuid(vals, OBJECT_FIELD_GUID + 1, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed()))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // item_instance.data.OBJECT_FIELD_GUID update
-                }
-                if (!changetoknth(vals, ITEM_FIELD_OWNER + 1, newguid))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // item_instance.data.ITEM_FIELD_OWNER update
-                }
-                if (!changenth(line, 3, vals.c_str()))      // item_instance.data update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                break;
+                values += "NULL";
             }
-            case DTT_ITEM_GIFT:
+            else
             {
-                if (!changenth(line, 1, newguid))           // character_gifts.guid update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                if (!changeGuid(line, 2, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed()))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // character_gifts.item_guid update
-                }
-                break;
+                std::string s = itr->str;
+                CharacterDatabase.escape_string(s);
+                values += "'" + s + "'";
             }
-            case DTT_ITEM_LOOT:
+        }
+        values += ")";
+
+        if (!sql.empty() && sql.size() + values.size() + 2 > MAX_QUERY_LEN)
+        {
+            if (!CharacterDatabase.Execute(sql.c_str()))
             {
-                // item, owner
-                if (!changeGuid(line, 1, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed()))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // item_loot.guid update
-                }
-                if (!changenth(line, 2, newguid))           // item_Loot.owner_guid update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                break;
+                return false;
             }
-            case DTT_PET:
-            {
-                // store a map of old pet id to new inserted pet id for use by type 5 tables
-                snprintf(currpetid, 20, "%s", getnth(line, 1).c_str());
-                if (strlen(lastpetid) == 0)
-                {
-                    snprintf(lastpetid, 20, "%s", currpetid);
-                }
+            sql.clear();
+        }
 
-                if (strcmp(lastpetid, currpetid) != 0)
-                {
-                    snprintf(newpetid, 20, "%d", sObjectMgr.GeneratePetNumber());
-                    snprintf(lastpetid, 20, "%s", currpetid);
-                }
+        sql += sql.empty() ? head : ", ";
+        sql += values;
+    }
 
-                std::map<uint32, uint32> :: const_iterator petids_iter = petids.find(atoi(currpetid));
+    return sql.empty() || CharacterDatabase.Execute(sql.c_str());
+}
 
-                if (petids_iter == petids.end())
-                {
-                    petids.insert(PetIdsPair(atoi(currpetid), atoi(newpetid)));
-                }
+// Reading - High-level functions
+DumpReturn PlayerDumpReader::ReadDump(const std::string& file)
+{
+    std::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+    if (!fin)
+    {
+        return DUMP_FILE_OPEN_ERROR;
+    }
 
-                if (!changenth(line, 1, newpetid))          // character_pet.id update
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                if (!changenth(line, 3, newguid))           // character_pet.owner update
+    m_dbVersion.clear();
+    m_tables.clear();
+    m_legacy = true;
+
+    bool header = true;
+    std::string line;
+    while (std::getline(fin, line))
+    {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+        {
+            line.erase(line.size() - 1);
+        }
+
+        // skip empty strings and comments
+        size_t nw_pos = line.find_first_not_of(" \t\n\r\7");
+        if (nw_pos == std::string::npos || line[nw_pos] == '#')
+        {
+            continue;
+        }
+
+        // dumps without header are the SQL dumps of older versions
+        if (header)
+        {
+            header = false;
+            if (line.compare(0, 6, "PDUMP\t") == 0)
+            {
+                uint32 version = atoi(line.c_str() + 6);
+                if (version < 2 || version > PLAYER_DUMP_VERSION)
                 {
-                    ROLLBACK(DUMP_FILE_BROKEN);
+                    sLog.outError("LoadPlayerDump: Unsupported dump version %u", version);
+                    return DUMP_FILE_BROKEN;
                 }
 
-                break;
+                m_legacy = false;
+                continue;
             }
-            case DTT_PET_TABLE:                             // pet_aura, pet_spell, pet_spell_cooldown
-            {
-                snprintf(currpetid, 20, "%s", getnth(line, 1).c_str());
+        }
 
-                // lookup currpetid and match to new inserted pet id
-                std::map<uint32, uint32> :: const_iterator petids_iter = petids.find(atoi(currpetid));
-                if (petids_iter == petids.end())            // couldn't find new inserted id
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
+        if (!(m_legacy ? ReadLegacyLine(line.substr(nw_pos)) : ReadLine(line)))
+        {
+            return DUMP_FILE_BROKEN;
+        }
+    }
 
-                snprintf(newpetid, 20, "%d", petids_iter->second);
+    return fin.bad() ? DUMP_FILE_BROKEN : DUMP_SUCCESS;
+}
 
-                if (!changenth(line, 1, newpetid))          // pet_*.guid -> petid in fact
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
+DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, std::string name, uint32 guid)
+{
+    DumpReturn result = ReadDump(file);
+    return result == DUMP_SUCCESS ? ImportDump(account, name, guid) : result;
+}
 
-                break;
-            }
-            case DTT_PET_DECL:                              // character_pet_declinedname
+DumpReturn PlayerDumpReader::ImportDump(uint32 account, std::string name, uint32 guid)
+{
+    // Check db version corresp.
+    if (!m_dbVersion.empty())
+    {
+        std::string dbversion = GetCharacterDBVersion();
+        if (!dbversion.empty() && dbversion != m_dbVersion)
+        {
+            sLog.outError("LoadPlayerDump: Cannot load player dump - file version is %s, DB needs %s", m_dbVersion.c_str(), dbversion.c_str());
+            return DUMP_DB_VERSION_MISMATCH;
+        }
+    }
+
+    DumpRow* charRow = FindCharacterRow();
+    if (!charRow)
+    {
+        sLog.outError("LoadPlayerDump: Dump has no character");
+        return DUMP_FILE_BROKEN;
+    }
+
+    // restore to the dumped account
+    if (!account)
+    {
+        std::string accountName;
+        account = atoi(getnth(*charRow, 2).c_str());
+        if (!sAccountMgr.GetName(account, accountName))
+        {
+            sLog.outError("LoadPlayerDump: Account %u of the dump does not exist", account);
+            return DUMP_FILE_BROKEN;
+        }
+    }
+
+    // check character count
+    uint32 charcount = sAccountMgr.GetCharactersCount(account);
+    if (charcount >= 10)
+    {
+        return DUMP_TOO_MANY_CHARS;
+    }
+
+    bool nameInvalidated = false;                           // set when name changed or will requested changed at next login
+    QueryResult* result = NULL;
+
+    // make sure the same guid doesn't already exist and is safe to use
+    bool incHighest = true;
+    if (guid != 0 && guid < sObjectMgr.m_CharGuids.GetNextAfterMaxUsed())
+    {
+        result = CharacterDatabase.PQuery("SELECT * FROM `characters` WHERE `guid` = '%u'", guid);
+        if (result)
+        {
+            guid = sObjectMgr.m_CharGuids.GetNextAfterMaxUsed();
+            delete result;
+        }
+        else
+        {
+            incHighest = false;
+        }
+    }
+    else
+    {
+        guid = sObjectMgr.m_CharGuids.GetNextAfterMaxUsed();
+    }
+
+    // normalize the name if specified and check if it exists
+    if (!normalizePlayerName(name))
+    {
+        name.clear();
+    }
+
+    if (ObjectMgr::CheckPlayerName(name, true) == CHAR_NAME_SUCCESS)
+    {
+        std::string safeName = name;
+        CharacterDatabase.escape_string(safeName);
+        result = CharacterDatabase.PQuery("SELECT * FROM `characters` WHERE `name` = '%s'", safeName.c_str());
+        if (result)
+        {
+            name.clear();                                   // use the one from the dump
+            delete result;
+        }
+    }
+    else
+    {
+        name.clear();
+    }
+
+    std::string newguid = std::to_string(guid);
+    std::string chraccount = std::to_string(account);
+
+    uint32 itemBase = sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed();
+    uint32 mailBase = sObjectMgr.m_MailIds.GetNextAfterMaxUsed();
+
+    GuidMap items;
+    GuidMap mails;
+    GuidMap petids;                                         // old->new petid relation
+
+    // change the data to server values
+    for (std::vector<DumpTableRows>::iterator table = m_tables.begin(); table != m_tables.end(); ++table)
+    {
+        for (std::vector<DumpRow>::iterator row = table->rows.begin(); row != table->rows.end(); ++row)
+        {
+            DumpRow& line = *row;
+            bool ok = true;
+
+            switch (table->type)
             {
-                snprintf(currpetid, 20, "%s", getnth(line, 1).c_str());
+                case DTT_CHAR_TABLE:
+                case DTT_CHAR_NAME_TABLE:
+                    ok = changenth(line, 1, newguid);       // character_*.guid update
+                    break;
 
-                // lookup currpetid and match to new inserted pet id
-                std::map<uint32, uint32> :: const_iterator petids_iter = petids.find(atoi(currpetid));
-                if (petids_iter == petids.end())            // couldn't find new inserted id
+                case DTT_CHARACTER:
                 {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
+                    ok = changenth(line, 1, newguid) &&     // characters.guid update
+                         changenth(line, 2, chraccount);    // characters.account update
 
-                snprintf(newpetid, 20, "%d", petids_iter->second);
+                    if (name.empty())
+                    {
+                        // check if the original name already exists
+                        std::string safeName = getnth(line, 3); // characters.name
+                        CharacterDatabase.escape_string(safeName);
 
-                if (!changenth(line, 1, newpetid))          // character_pet_declinedname.id
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
+                        result = CharacterDatabase.PQuery("SELECT * FROM `characters` WHERE `name` = '%s'", safeName.c_str());
+                        if (result)
+                        {
+                            delete result;
+
+                            ok = ok && changenth(line, 36, "1"); // characters.at_login set to "rename on login"
+                            nameInvalidated = true;
+                        }
+                    }
+                    else
+                    {
+                        ok = ok && changenth(line, 3, name); // characters.name update
+                        nameInvalidated = true;
+                    }
+
+                    break;
                 }
+                case DTT_INVENTORY:
+                    ok = changenth(line, 1, newguid) &&     // character_inventory.guid update
+                         changeGuid(line, 2, items, itemBase, true) && // character_inventory.bag update
+                         changeGuid(line, 4, items, itemBase); // character_inventory.item update
+                    break;
 
-                if (!changenth(line, 2, newguid))           // character_pet_declinedname.owner update
+                case DTT_ITEM:
                 {
-                    ROLLBACK(DUMP_FILE_BROKEN);
+                    // item, owner, data field:item, owner guid
+                    ok = changeGuid(line, 1, items, itemBase) && // item_instance.guid update
+                         changenth(line, 2, newguid);       // item_instance.owner_guid update
+                    if (!ok)
+                    {
+                        break;
+                    }
+
+                    std::string vals = getnth(line, 3);     // item_instance.data get
+                    if (UpdateFieldBlob::IsCompact(vals.c_str()))
+                    {
+                        std::string text;                   // token based guid remapping works on text form only
+                        if (!UpdateFieldBlob::Convert(vals.c_str(), text, false))
+                        {
+                            ok = false;
+                            break;
+                        }
+                        vals = text;
+                    }
+
+                    ok = changetokGuid(vals, OBJECT_FIELD_GUID + 1, items, itemBase) && // item_instance.data.OBJECT_FIELD_GUID update
+                         changetoknth(vals, ITEM_FIELD_OWNER + 1, newguid.c_str()) && // item_instance.data.ITEM_FIELD_OWNER update
+                         changenth(line, 3, vals);          // item_instance.data update
+                    break;
                 }
+                case DTT_ITEM_GIFT:
+                    ok = changenth(line, 1, newguid) &&     // character_gifts.guid update
+                         changeGuid(line, 2, items, itemBase); // character_gifts.item_guid update
+                    break;
 
-                break;
-            }
-            case DTT_MAIL:                                  // mail
-            {
-                if (!changeGuid(line, 1, mails, sObjectMgr.m_MailIds.GetNextAfterMaxUsed()))
+                case DTT_ITEM_LOOT:
+                    // item, owner
+                    ok = changeGuid(line, 1, items, itemBase) && // item_loot.guid update
+                         changenth(line, 2, newguid);       // item_Loot.owner_guid update
+                    break;
+
+                case DTT_PET:
                 {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // mail.id update
+                    // store a map of old pet id to new inserted pet id for use by pet tables
+                    uint32 oldId = atoi(getnth(line, 1).c_str());
+                    GuidMap::const_iterator petids_iter = petids.find(oldId);
+                    uint32 newId = petids_iter != petids.end() ? petids_iter->second : (petids[oldId] = sObjectMgr.GeneratePetNumber());
+
+                    ok = changenth(line, 1, std::to_string(newId)) && // character_pet.id update
+                         changenth(line, 3, newguid);       // character_pet.owner update
+                    break;
                 }
-                if (!changenth(line, 6, newguid))           // mail.receiver update
+                case DTT_PET_TABLE:                         // pet_aura, pet_spell, pet_spell_cooldown
+                case DTT_PET_DECL:                          // character_pet_declinedname
                 {
-                    ROLLBACK(DUMP_FILE_BROKEN);
+                    // lookup currpetid and match to new inserted pet id
+                    GuidMap::const_iterator petids_iter = petids.find(atoi(getnth(line, 1).c_str()));
+                    if (petids_iter == petids.end())        // couldn't find new inserted id
+                    {
+                        ok = false;
+                        break;
+                    }
+
+                    ok = changenth(line, 1, std::to_string(petids_iter->second)); // pet_*.guid -> petid in fact
+                    if (table->type == DTT_PET_DECL)
+                    {
+                        ok = ok && changenth(line, 2, newguid); // character_pet_declinedname.owner update
+                    }
+                    break;
                 }
-                break;
+                case DTT_MAIL:                              // mail
+                    ok = changeGuid(line, 1, mails, mailBase) && // mail.id update
+                         changenth(line, 6, newguid);       // mail.receiver update
+                    break;
+
+                case DTT_MAIL_ITEM:                         // mail_items
+                    ok = changeGuid(line, 1, mails, mailBase) && // mail_items.id
+                         changeGuid(line, 2, items, itemBase) && // mail_items.item_guid
+                         changenth(line, 4, newguid);       // mail_items.receiver
+                    break;
+
+                default:
+                    sLog.outError("Unknown dump table type: %u", table->type);
+                    break;
             }
-            case DTT_MAIL_ITEM:                             // mail_items
+
+            if (!ok)
             {
-                if (!changeGuid(line, 1, mails, sObjectMgr.m_MailIds.GetNextAfterMaxUsed()))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // mail_items.id
-                }
-                if (!changeGuid(line, 2, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed()))
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);              // mail_items.item_guid
-                }
-                if (!changenth(line, 4, newguid))           // mail_items.receiver
-                {
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                }
-                break;
+                sLog.outError("LoadPlayerDump: Can't convert a row of table '%s'", table->name.c_str());
+                return DUMP_FILE_BROKEN;
             }
-            default:
-                sLog.outError("Unknown dump table type: %u", type);
-                break;
         }
+    }
 
-        if (execute_ok && !CharacterDatabase.Execute(line.c_str()))
+    CharacterDatabase.BeginTransaction();
+    for (std::vector<DumpTableRows>::const_iterator table = m_tables.begin(); table != m_tables.end(); ++table)
+    {
+        // ignore declined names if name will changed in some way
+        if (table->type == DTT_CHAR_NAME_TABLE && nameInvalidated)
         {
-            ROLLBACK(DUMP_FILE_BROKEN);
+            continue;
         }
-    }
 
+        if (!InsertDumpRows(*table))
+        {
+            CharacterDatabase.RollbackTransaction();
+            return DUMP_FILE_BROKEN;
+        }
+    }
     CharacterDatabase.CommitTransaction();
 
     // FIXME: current code with post-updating guids not safe for future per-map threads
@@ -912,7 +1116,140 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
         sObjectMgr.m_CharGuids.Set(sObjectMgr.m_CharGuids.GetNextAfterMaxUsed() + 1);
     }
 
-    fclose(fin);
-
     return DUMP_SUCCESS;
 }
+
+// Bulk dumps
+struct PlayerDumpJob
+{
+    PlayerDumpJob() : guid(0), result(DUMP_FILE_BROKEN) {}
+
+    std::string file;
+    uint32 guid;                                            // write: character to dump
+    PlayerDumpReader reader;                                // read: parsed file
+    DumpReturn result;
+};
+
+typedef std::vector<PlayerDumpJob> PlayerDumpJobs;
+
+class PlayerDumpWorker : public ACE_Based::Runnable
+{
+    public:
+        PlayerDumpWorker(PlayerDumpJobs& jobs, ACE_Atomic_Op<ACE_Thread_Mutex, long>& next, bool write)
+            : m_jobs(jobs), m_next(next), m_write(write) {}
+
+        void run() override
+        {
+            CharacterDatabase.ThreadStart();
+
+            for (long i = ++m_next - 1; i < long(m_jobs.size()); i = ++m_next - 1)
+            {
+                PlayerDumpJob& job = m_jobs[i];
+                job.result = m_write ? PlayerDumpWriter().WriteDump(job.file, job.guid) : job.reader.ReadDump(job.file);
+            }
+
+            CharacterDatabase.ThreadEnd();
+        }
+
+    private:
+        PlayerDumpJobs& m_jobs;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long>& m_next;
+        bool m_write;
+};
+
+static void RunPlayerDumpJobs(PlayerDumpJobs& jobs, bool write)
+{
+    // shared statements are prepared before the threads use them
+    LoadDumpTableColumns();
+
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> next(0);
+    std::vector<ACE_Based::Thread*> threads;
+    for (size_t i = 0; i < PLAYER_DUMP_BULK_THREADS && i < jobs.size(); ++i)
+    {
+        threads.push_back(new ACE_Based::Thread(new PlayerDumpWorker(jobs, next, write)));
+    }
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];                                  // This also deletes the worker
+    }
+}
+
+uint32 PlayerDumpBulk::WriteDumps(std::string const& dir, std::vector<uint32> const& guids)
+{
+    PlayerDumpJobs jobs(guids.size());
+    for (size_t i = 0; i < guids.size(); ++i)
+    {
+        jobs[i].guid = guids[i];
+        jobs[i].file = dir + "/" + std::to_string(guids[i]) + ".pdump";
+    }
+
+    RunPlayerDumpJobs(jobs, true);
+
+    uint32 written = 0;
+    for (PlayerDumpJobs::const_iterator itr = jobs.begin(); itr != jobs.end(); ++itr)
+    {
+        if (itr->result == DUMP_SUCCESS)
+        {
+            ++written;
+        }
+        else
+        {
+            sLog.outError("PlayerDumpBulk: Can't write dump of character %u to %s", itr->guid, itr->file.c_str());
+        }
+    }
+
+    return written;
+}
+
+uint32 PlayerDumpBulk::LoadDumps(std::string const& dir, uint32 account, uint32& total)
+{
+    std::vector<std::string> files;
+
+    ACE_Dirent dirent;
+    if (dirent.open(dir.c_str()) != -1)
+    {
+        while (ACE_DIRENT* entry = dirent.read())
+        {
+            std::string name = entry->d_name;
+            if (name.size() > 6 && name.compare(name.size() - 6, 6, ".pdump") == 0)
+            {
+                files.push_back(dir + "/" + name);
+            }
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+
+    PlayerDumpJobs jobs(files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        jobs[i].file = files[i];
+    }
+
+    total = jobs.size();
+
+    RunPlayerDumpJobs(jobs, false);
+
+    // new guids are handed out by the world thread only
+    uint32 loaded = 0;
+    for (PlayerDumpJobs::iterator itr = jobs.begin(); itr != jobs.end(); ++itr)
+    {
+        if (itr->result == DUMP_SUCCESS)
+        {
+            itr->result = itr->reader.ImportDump(account, "", 0);
+        }
+
+        if (itr->result == DUMP_SUCCESS)
+        {
+            ++loaded;
+        }
+        else
+        {
+            sLog.outError("PlayerDumpBulk: Can't load %s (error %u)", itr->file.c_str(), itr->result);
+        }
+    }
+
+    return loaded;
+}
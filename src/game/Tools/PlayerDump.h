@@ -25,7 +25,14 @@
 #ifndef MANGOS_H_PLAYER_DUMP
 #define MANGOS_H_PLAYER_DUMP
 
+#include "Common.h"
+#include "Utilities/UnorderedMapSet.h"
+
 #include <set>
+#include <vector>
+
+#define PLAYER_DUMP_VERSION         2                       // written into the "PDUMP" header line
+#define PLAYER_DUMP_BULK_THREADS    4                       // threads doing the file and select work of bulk dumps
 
 enum DumpTableType
 {
@@ -68,6 +75,27 @@ enum DumpReturn
     DUMP_DB_VERSION_MISMATCH
 };
 
+/// one value of a dumped row, NULL is kept apart from an empty string
+struct DumpValue
+{
+    DumpValue() : isNull(false) {}
+
+    std::string str;
+    bool isNull;
+};
+
+typedef std::vector<DumpValue> DumpRow;
+
+/// rows of one table, in dump order
+struct DumpTableRows
+{
+    std::string name;
+    std::string columns;                                    // "`guid`,`name`,...", empty for old dumps written without column list
+    uint32 columnCount;                                     // 0 if the dump has no column list
+    DumpTableType type;
+    std::vector<DumpRow> rows;
+};
+
 class PlayerDump
 {
     protected:
@@ -84,7 +112,7 @@ class PlayerDumpWriter : public PlayerDump
     private:
         typedef std::set<uint32> GUIDs;
 
-        void DumpTableContent(std::string& dump, uint32 guid, char const* tableFrom, char const* tableTo, DumpTableType type);
+        void DumpTableContent(std::string& dump, uint32 guid, uint32 tableIdx);
         std::string GenerateWhereStr(char const* field, GUIDs const& guids, GUIDs::const_iterator& itr);
         std::string GenerateWhereStr(char const* field, uint32 guid);
 
@@ -96,9 +124,52 @@ class PlayerDumpWriter : public PlayerDump
 class PlayerDumpReader : public PlayerDump
 {
     public:
-        PlayerDumpReader() {}
+        PlayerDumpReader() : m_legacy(true) {}
 
+        /// ReadDump() and ImportDump() in one go
         DumpReturn LoadDump(const std::string& file, uint32 account, std::string name, uint32 guid);
+
+        /// parse a dump file, current or old SQL format, touches no global state
+        DumpReturn ReadDump(const std::string& file);
+        /**
+         * Insert the parsed dump as a new character, world thread only (allocates guids).
+         *
+         * @param account   target account, 0 for the account stored in the dump
+         * @param name      new name, empty for the dumped one
+         * @param guid      wanted character guid, 0 for a new one
+         */
+        DumpReturn ImportDump(uint32 account, std::string name, uint32 guid);
+
+    private:
+        typedef UNORDERED_MAP<uint32, uint32> GuidMap;      // old -> new guid
+
+        bool ReadLine(std::string const& line);
+        bool ReadLegacyLine(std::string const& line);
+        DumpTableRows* AddTable(std::string const& name, std::string const& columns);
+        DumpRow* FindCharacterRow();
+
+        std::string m_dbVersion;                            // "version.structure.X" the dump was written with, empty if unknown
+        std::vector<DumpTableRows> m_tables;
+        bool m_legacy;
+};
+
+/**
+ * Dumps or restores many characters at once. The selects, file writing and parsing
+ * run on PLAYER_DUMP_BULK_THREADS threads, the imports on the calling (world) thread.
+ */
+class PlayerDumpBulk
+{
+    public:
+        /// write <dir>/<guid>.pdump for all guids, returns the number of dumps written
+        static uint32 WriteDumps(std::string const& dir, std::vector<uint32> const& guids);
+        /**
+         * Load all *.pdump files of a directory.
+         *
+         * @param account   target account, 0 to restore each character to its dumped account
+         * @param total     set to the number of files found
+         * @returns the number of characters loaded
+         */
+        static uint32 LoadDumps(std::string const& dir, uint32 account, uint32& total);
 };
 
 #endif
@@ -0,0 +1,131 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "Common.h"
+#include "UpdateFieldConverter.h"
+#include "UpdateFieldBlob.h"
+#include "World.h"
+#include "Database/DatabaseEnv.h"
+#include "ProgressBar.h"
+
+void UpdateFieldConverter::ConvertDatabase()
+{
+    // config to enable, the conversion only has to be done once
+    if (!sWorld.getConfig(CONFIG_BOOL_CONVERT_UPDATE_FIELDS))
+    {
+        return;
+    }
+
+    bool compact = sWorld.getConfig(CONFIG_BOOL_COMPACT_UPDATE_FIELDS);
+
+    sLog.outString("Converting update field data to %s format...", compact ? "compact" : "text");
+
+    uint32 startTime = getMSTime();
+
+    static const char* const itemColumns[] = { "data" };
+    uint32 items = ConvertColumns("item_instance", "guid", itemColumns, countof(itemColumns), compact);
+
+    static const char* const characterColumns[] = { "taximask", "exploredZones", "knownTitles" };
+    uint32 characters = ConvertColumns("characters", "guid", characterColumns, countof(characterColumns), compact);
+
+    sLog.outString(">> Converted %u items and %u characters in %u ms", items, characters, GetMSTimeDiffToNow(startTime));
+    sLog.outString("Set ConvertUpdateFields = 0 to skip this step at next start up.");
+}
+
+uint32 UpdateFieldConverter::ConvertColumns(const char* table, const char* key, const char* const* columns, uint32 columnCount, bool compact)
+{
+    std::ostringstream select;
+    std::ostringstream update;
+    select << "SELECT `" << key << "`";
+    update << "UPDATE `" << table << "` SET ";
+    for (uint32 i = 0; i < columnCount; ++i)
+    {
+        select << ", `" << columns[i] << "`";
+        update << (i ? ", `" : "`") << columns[i] << "` = ?";
+    }
+    select << " FROM `" << table << "`";
+    update << " WHERE `" << key << "` = ?";
+
+    QueryResult* result = CharacterDatabase.Query(select.str().c_str());
+    if (!result)
+    {
+        sLog.outString("Table %s is empty.", table);
+        return 0;
+    }
+
+    SqlStatementID updateId;
+    uint32 converted = 0;
+
+    CharacterDatabase.BeginTransaction();
+
+    BarGoLink bar(result->GetRowCount());
+    do
+    {
+        bar.step();
+
+        Field* fields = result->Fetch();
+
+        bool changed = false;
+        std::vector<std::string> values(columnCount);
+        for (uint32 i = 0; i < columnCount; ++i)
+        {
+            const char* data = fields[i + 1].GetString();
+            if (!data || UpdateFieldBlob::IsCompact(data) == compact)
+            {
+                values[i] = data ? data : "";
+                continue;
+            }
+
+            if (!UpdateFieldBlob::Convert(data, values[i], compact))
+            {
+                sLog.outError("Table %s row %u has broken `%s` data, left unchanged.", table, fields[0].GetUInt32(), columns[i]);
+                values[i] = data;
+                continue;
+            }
+
+            changed = true;
+        }
+
+        if (!changed)
+        {
+            continue;
+        }
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updateId, update.str().c_str());
+        for (uint32 i = 0; i < columnCount; ++i)
+        {
+            stmt.addString(values[i]);
+        }
+        stmt.addUInt32(fields[0].GetUInt32());
+        stmt.Execute();
+
+        ++converted;
+    }
+    while (result->NextRow());
+
+    CharacterDatabase.CommitTransaction();
+
+    delete result;
+    return converted;
+}
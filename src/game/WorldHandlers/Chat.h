@@ -412,7 +412,9 @@ class ChatHandler
         //----------------------------------------------------------
 
         bool HandlePDumpLoadCommand(char* args);
+        bool HandlePDumpLoadAllCommand(char* args);
         bool HandlePDumpWriteCommand(char* args);
+        bool HandlePDumpWriteAllCommand(char* args);
 
         bool HandlePoolListCommand(char* args);
         bool HandlePoolSpawnsCommand(char* args);
@@ -535,11 +537,13 @@ class ChatHandler
         bool HandleSendMassMoneyCommand(char* args);
 
         bool HandleServerCorpsesCommand(char* args);
+        bool HandleServerDbStatsCommand(char* args);
         bool HandleServerExitCommand(char* args);
         bool HandleServerIdleRestartCommand(char* args);
         bool HandleServerIdleShutDownCommand(char* args);
         bool HandleServerInfoCommand(char* args);
         bool HandleServerLogFilterCommand(char* args);
+        bool HandleServerNetStatsCommand(char* args);
         bool HandleServerLogLevelCommand(char* args);
         bool HandleServerMotdCommand(char* args);
         bool HandleServerPLimitCommand(char* args);
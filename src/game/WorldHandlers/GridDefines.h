@@ -69,12 +69,12 @@ template <typename...Ts> struct TypeList;
 using GridTypeMapContainer  = TypeMapContainer<TypeList<GameObject, Creature/*except pets*/, DynamicObject, Corpse/*bones*/>>;
 using WorldTypeMapContainer = TypeMapContainer<TypeList<Player, Creature/*pets*/, Corpse/*resurrectable*/, Camera>>;
 
-typedef GridRefManager<Camera>          CameraMapType;
-typedef GridRefManager<Corpse>          CorpseMapType;
-typedef GridRefManager<Creature>        CreatureMapType;
-typedef GridRefManager<DynamicObject>   DynamicObjectMapType;
-typedef GridRefManager<GameObject>      GameObjectMapType;
-typedef GridRefManager<Player>          PlayerMapType;
+typedef GridObjectList<Camera>          CameraMapType;
+typedef GridObjectList<Corpse>          CorpseMapType;
+typedef GridObjectList<Creature>        CreatureMapType;
+typedef GridObjectList<DynamicObject>   DynamicObjectMapType;
+typedef GridObjectList<GameObject>      GameObjectMapType;
+typedef GridObjectList<Player>          PlayerMapType;
 
 typedef Grid<Player, WorldTypeMapContainer, GridTypeMapContainer> GridType;
 typedef NGrid<MAX_NUMBER_OF_CELLS, Player, WorldTypeMapContainer, GridTypeMapContainer> NGridType;
@@ -54,6 +54,7 @@ GridMap::GridMap()
     // Height level data
     m_gridHeight = INVALID_HEIGHT_VALUE;
     m_gridGetHeight = &GridMap::getHeightFromFlat;
+    m_gridGetHeights = &GridMap::getHeightsFromFlat;
     m_V9 = NULL;
     m_V8 = NULL;
     memset(m_holes, 0, sizeof(m_holes));
@@ -150,6 +151,7 @@ void GridMap::unloadData()
     m_liquidFlags = NULL;
     m_liquid_map  = NULL;
     m_gridGetHeight = &GridMap::getHeightFromFlat;
+    m_gridGetHeights = &GridMap::getHeightsFromFlat;
 }
 
 bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
@@ -213,6 +215,7 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
             }
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
+            m_gridGetHeights = &GridMap::getHeightsFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
@@ -230,6 +233,7 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
             }
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
+            m_gridGetHeights = &GridMap::getHeightsFromUint8;
         }
         else
         {
@@ -246,11 +250,13 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
                 return false;
             }
             m_gridGetHeight = &GridMap::getHeightFromFloat;
+            m_gridGetHeights = &GridMap::getHeightsFromFloat;
         }
     }
     else
     {
         m_gridGetHeight = &GridMap::getHeightFromFlat;
+        m_gridGetHeights = &GridMap::getHeightsFromFlat;
     }
 
     return true;
@@ -581,6 +587,99 @@ float GridMap::getHeightFromUint16(float x, float y) const
     return (float)((a * x) + (b * y) + c) * m_gridIntHeightMultiplier + m_gridHeight;
 }
 
+// Solves the triangle selected by the fractional position inside a V8 square, same math and layout
+// as getHeightFromFloat
+template<typename H>
+inline float InterpolateGridHeight(float x, float y, H h1, H h2, H h3, H h4, H h5)
+{
+    bool top = x + y < 1;
+    bool right = x > y;
+
+    H a = top ? (right ? h2 - h1 : h5 - h1 - h3) : (right ? h2 + h4 - h5 : h4 - h3);
+    H b = top ? (right ? h5 - h1 - h2 : h3 - h1) : (right ? h4 - h2 : h3 + h4 - h5);
+    H c = top ? h1 : h5 - h4;
+
+    return (a * x) + (b * y) + c;
+}
+
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    (this->*m_gridGetHeights)(x, y, heights, count);
+}
+
+void GridMap::getHeightsFromFlat(float const* /*x*/, float const* /*y*/, float* heights, uint32 count) const
+{
+    std::fill(heights, heights + count, m_gridHeight);
+}
+
+void GridMap::getHeightsFromFloat(float const* x, float const* y, float* heights, uint32 count) const
+{
+    if (!m_V8 || !m_V9)
+    {
+        std::fill(heights, heights + count, INVALID_HEIGHT_VALUE);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float fx = MAP_RESOLUTION * (32 - x[i] / SIZE_OF_GRIDS);
+        float fy = MAP_RESOLUTION * (32 - y[i] / SIZE_OF_GRIDS);
+
+        int x_int = (int)fx;
+        int y_int = (int)fy;
+        fx -= x_int;
+        fy -= y_int;
+        x_int &= (MAP_RESOLUTION - 1);
+        y_int &= (MAP_RESOLUTION - 1);
+
+        if (isHole(x_int, y_int))
+        {
+            heights[i] = INVALID_HEIGHT_VALUE;
+            continue;
+        }
+
+        float const* V9_h1_ptr = &m_V9[x_int * 129 + y_int];
+        heights[i] = InterpolateGridHeight(fx, fy, V9_h1_ptr[0], V9_h1_ptr[129], V9_h1_ptr[1], V9_h1_ptr[130], 2 * m_V8[x_int * 128 + y_int]);
+    }
+}
+
+template<typename T>
+void GridMap::getHeightsFromInt(T const* V9, T const* V8, float const* x, float const* y, float* heights, uint32 count) const
+{
+    if (!V8 || !V9)
+    {
+        std::fill(heights, heights + count, m_gridHeight);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float fx = MAP_RESOLUTION * (32 - x[i] / SIZE_OF_GRIDS);
+        float fy = MAP_RESOLUTION * (32 - y[i] / SIZE_OF_GRIDS);
+
+        int x_int = (int)fx;
+        int y_int = (int)fy;
+        fx -= x_int;
+        fy -= y_int;
+        x_int &= (MAP_RESOLUTION - 1);
+        y_int &= (MAP_RESOLUTION - 1);
+
+        T const* V9_h1_ptr = &V9[x_int * 128 + x_int + y_int];
+        int32 h5 = 2 * V8[x_int * 128 + y_int];
+        heights[i] = InterpolateGridHeight<int32>(fx, fy, V9_h1_ptr[0], V9_h1_ptr[129], V9_h1_ptr[1], V9_h1_ptr[130], h5) * m_gridIntHeightMultiplier + m_gridHeight;
+    }
+}
+
+void GridMap::getHeightsFromUint8(float const* x, float const* y, float* heights, uint32 count) const
+{
+    getHeightsFromInt(m_uint8_V9, m_uint8_V8, x, y, heights, count);
+}
+
+void GridMap::getHeightsFromUint16(float const* x, float const* y, float* heights, uint32 count) const
+{
+    getHeightsFromInt(m_uint16_V9, m_uint16_V8, x, y, heights, count);
+}
+
 float GridMap::getLiquidLevel(float x, float y)
 {
     if (!m_liquid_map)
@@ -933,9 +1032,6 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
-
-    float z2 = z + 2.f;
 
     // find raw .map surface under Z coordinates (or well-defined above)
     if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x, y))
@@ -943,6 +1039,48 @@ float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=tr
         mapHeight = gmap->getHeight(x, y);
     }
 
+    return SelectStaticHeight(x, y, z, mapHeight, useVmaps, maxSearchDist);
+}
+
+void TerrainInfo::GetHeightStatic(uint32 count, float const* x, float const* y, float const* z, float* heights, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    // consecutive points on the same grid share the tile lookup and one batched .map query
+    uint32 first = 0;
+    while (first < count)
+    {
+        int gx = (int)(32 - x[first] / SIZE_OF_GRIDS);
+        int gy = (int)(32 - y[first] / SIZE_OF_GRIDS);
+
+        uint32 last = first + 1;
+        while (last < count && (int)(32 - x[last] / SIZE_OF_GRIDS) == gx && (int)(32 - y[last] / SIZE_OF_GRIDS) == gy)
+        {
+            ++last;
+        }
+
+        if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x[first], y[first]))
+        {
+            gmap->getHeights(x + first, y + first, heights + first, last - first);
+        }
+        else
+        {
+            std::fill(heights + first, heights + last, VMAP_INVALID_HEIGHT_VALUE);
+        }
+
+        first = last;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        heights[i] = SelectStaticHeight(x[i], y[i], z[i], heights[i], useVmaps, maxSearchDist);
+    }
+}
+
+float TerrainInfo::SelectStaticHeight(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const
+{
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
+
+    float z2 = z + 2.f;
+
     if (useVmaps)
     {
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
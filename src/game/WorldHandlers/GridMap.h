@@ -172,6 +172,16 @@ class GridMap
         float getHeightFromUint8(float x, float y) const;
         float getHeightFromFlat(float x, float y) const;
 
+        // Batched variants, one dispatch for all points of a grid
+        typedef void(GridMap::*pGetHeightsPtr)(float const* x, float const* y, float* heights, uint32 count) const;
+        pGetHeightsPtr m_gridGetHeights;
+        void getHeightsFromFloat(float const* x, float const* y, float* heights, uint32 count) const;
+        void getHeightsFromUint16(float const* x, float const* y, float* heights, uint32 count) const;
+        void getHeightsFromUint8(float const* x, float const* y, float* heights, uint32 count) const;
+        void getHeightsFromFlat(float const* x, float const* y, float* heights, uint32 count) const;
+        template<typename T>
+        void getHeightsFromInt(T const* V9, T const* V8, float const* x, float const* y, float* heights, uint32 count) const;
+
     public:
 
         GridMap();
@@ -185,6 +195,8 @@ class GridMap
 
         uint16 getArea(float x, float y);
         float getHeight(float x, float y) { return (this->*m_gridGetHeight)(x, y); }
+        // heights of count points, all of them must lie on this grid
+        void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
         float getLiquidLevel(float x, float y);
         uint8 getTerrainType(float x, float y);
         GridMapLiquidStatus getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, GridMapLiquidData* data = 0);
@@ -228,6 +240,8 @@ class TerrainInfo : public Referencable<AtomicLong>
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
         float GetHeightStatic(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // batched GetHeightStatic, points should be ordered so that neighbours share a grid
+        void GetHeightStatic(uint32 count, float const* x, float const* y, float const* z, float* heights, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = NULL) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float* pGround = NULL, bool swim = false) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData* data = 0) const;
@@ -263,6 +277,7 @@ class TerrainInfo : public Referencable<AtomicLong>
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y);
+        float SelectStaticHeight(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const;
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y);
 
         int RefGrid(const uint32& x, const uint32& y);
@@ -44,7 +44,7 @@ namespace MaNGOS
         std::set<WorldObject*> i_visibleNow;
 
         explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
-        template<class T> void Visit(GridRefManager<T>& m);
+        template<class T> void Visit(GridObjectList<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
     };
@@ -54,7 +54,7 @@ namespace MaNGOS
         WorldObject& i_object;
 
         explicit VisibleChangesNotifier(WorldObject& object) : i_object(object) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
+        template<class T> void Visit(GridObjectList<T>&) {}
         void Visit(CameraMapType&);
     };
 
@@ -65,7 +65,7 @@ namespace MaNGOS
         bool i_toSelf;
         MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
     };
 
     struct MessageDelivererExcept
@@ -77,7 +77,7 @@ namespace MaNGOS
             : i_message(msg), i_skipped_receiver(skipped) {}
 
         void Visit(CameraMapType& m);
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
     };
 
     struct ObjectMessageDeliverer
@@ -85,7 +85,7 @@ namespace MaNGOS
         WorldPacket* i_message;
         explicit ObjectMessageDeliverer(WorldPacket* msg) : i_message(msg) {}
         void Visit(CameraMapType& m);
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
     };
 
     struct MessageDistDeliverer
@@ -99,7 +99,7 @@ namespace MaNGOS
         MessageDistDeliverer(Player const& pl, WorldPacket* msg, float dist, bool to_self, bool ownTeamOnly)
             : i_player(pl), i_message(msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
         void Visit(CameraMapType& m);
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
     };
 
     struct ObjectMessageDistDeliverer
@@ -109,25 +109,31 @@ namespace MaNGOS
         float i_dist;
         ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
     };
 
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
         explicit ObjectUpdater(const uint32& diff) : i_timeDiff(diff) {}
-        template<class T> void Visit(GridRefManager<T>& m);
+        template<class T> void Visit(GridObjectList<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
         void Visit(CameraMapType&) {}
         void Visit(CreatureMapType&);
     };
 
+    struct StaleSplinePositionUpdater
+    {
+        template<class T> void Visit(GridObjectList<T>&) {}
+        void Visit(CreatureMapType&);
+    };
+
     struct PlayerRelocationNotifier
     {
         Player& i_player;
         PlayerRelocationNotifier(Player& pl) : i_player(pl) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
+        template<class T> void Visit(GridObjectList<T>&) {}
         void Visit(CreatureMapType&);
     };
 
@@ -135,7 +141,7 @@ namespace MaNGOS
     {
         Creature& i_creature;
         CreatureRelocationNotifier(Creature& c) : i_creature(c) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
+        template<class T> void Visit(GridObjectList<T>&) {}
 #ifdef WIN32
         template<> void Visit(PlayerMapType&);
 #endif
@@ -156,7 +162,7 @@ namespace MaNGOS
             }
         }
 
-        template<class T> inline void Visit(GridRefManager<T>&) {}
+        template<class T> inline void Visit(GridObjectList<T>&) {}
 #ifdef WIN32
         template<> inline void Visit<Player>(PlayerMapType&);
         template<> inline void Visit<Creature>(CreatureMapType&);
@@ -197,10 +203,54 @@ namespace MaNGOS
             }
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED> &) {}
     };
     */
 
+    /* Mirror prefilter for the unit searchers:
+     * a check accepting only units within GetSearchRange() of its focus object (tested as IsWithinDistInMap does)
+     * and, with GetSearchMirrorFlags(), only units having all these GridObjectMirrorFlags, lets the searcher reject
+     * candidates from the cell list mirrors without touching the units. The 2d test uses the same float operations
+     * as WorldObject::_IsWithinDist, so it never rejects a unit the check would accept.
+     */
+    struct SearchFocus
+    {
+        explicit SearchFocus(WorldObject const& focus)
+            : x(focus.GetPositionX()), y(focus.GetPositionY()), radius(focus.GetObjectBoundingRadius()) {}
+
+        float x;
+        float y;
+        float radius;
+    };
+
+    template<class Check, class Iterator>
+    inline auto IsOutOfSearchRange(Check const& check, SearchFocus const& focus, Iterator const& itr, int) -> decltype(check.GetSearchRange(), bool())
+    {
+        float dx = focus.x - itr->getMirrorX();
+        float dy = focus.y - itr->getMirrorY();
+        float sizefactor = focus.radius + itr->getMirrorRadius();
+        float maxdist = check.GetSearchRange() + sizefactor;
+        return dx * dx + dy * dy >= maxdist * maxdist;
+    }
+
+    template<class Check, class Iterator>
+    inline bool IsOutOfSearchRange(Check const& /*check*/, SearchFocus const& /*focus*/, Iterator const& /*itr*/, long) { return false; }
+
+    template<class Check, class Iterator>
+    inline auto LacksSearchMirrorFlags(Check const& check, Iterator const& itr, int) -> decltype(check.GetSearchMirrorFlags(), bool())
+    {
+        return (itr->getMirrorFlags() & check.GetSearchMirrorFlags()) != check.GetSearchMirrorFlags();
+    }
+
+    template<class Check, class Iterator>
+    inline bool LacksSearchMirrorFlags(Check const& /*check*/, Iterator const& /*itr*/, long) { return false; }
+
+    template<class Check, class Iterator>
+    inline bool IsRejectedByMirror(Check const& check, SearchFocus const& focus, Iterator const& itr)
+    {
+        return LacksSearchMirrorFlags(check, itr, 0) || IsOutOfSearchRange(check, focus, itr, 0);
+    }
+
     // WorldObject searchers & workers
 
     template<class Check>
@@ -217,7 +267,7 @@ namespace MaNGOS
         void Visit(CorpseMapType& m);
         void Visit(DynamicObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -234,7 +284,7 @@ namespace MaNGOS
         void Visit(GameObjectMapType& m);
         void Visit(DynamicObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -251,7 +301,7 @@ namespace MaNGOS
         void Visit(GameObjectMapType& m);
         void Visit(DynamicObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -300,7 +350,7 @@ namespace MaNGOS
             }
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Gameobject searchers
@@ -315,7 +365,7 @@ namespace MaNGOS
 
         void Visit(GameObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Last accepted by Check GO if any (Check can change requirements at each call)
@@ -329,7 +379,7 @@ namespace MaNGOS
 
         void Visit(GameObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -342,7 +392,7 @@ namespace MaNGOS
 
         void Visit(GameObjectMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Unit searchers
@@ -359,7 +409,7 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Last accepted by Check Unit if any (Check can change requirements at each call)
@@ -374,7 +424,7 @@ namespace MaNGOS
         void Visit(CreatureMapType& m);
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // All accepted by Check units if any
@@ -389,7 +439,7 @@ namespace MaNGOS
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Creature searchers
@@ -404,7 +454,7 @@ namespace MaNGOS
 
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Last accepted by Check Creature if any (Check can change requirements at each call)
@@ -418,7 +468,7 @@ namespace MaNGOS
 
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -431,7 +481,7 @@ namespace MaNGOS
 
         void Visit(CreatureMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -449,7 +499,7 @@ namespace MaNGOS
             }
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // Player searchers
@@ -464,7 +514,7 @@ namespace MaNGOS
 
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Check>
@@ -478,7 +528,7 @@ namespace MaNGOS
 
         void Visit(PlayerMapType& m);
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -496,7 +546,7 @@ namespace MaNGOS
             }
         }
 
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     template<class Do>
@@ -520,7 +570,7 @@ namespace MaNGOS
                 }
             }
         }
-        template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
+        template<class NOT_INTERESTED> void Visit(GridObjectList<NOT_INTERESTED>&) {}
     };
 
     // CHECKS && DO classes
@@ -735,6 +785,8 @@ namespace MaNGOS
         public:
             MostHPMissingInRangeCheck(Unit const* obj, float range, uint32 hp) : i_obj(obj), i_range(range), i_hp(hp) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 if (u->IsAlive() && u->IsInCombat() && !i_obj->IsHostileTo(u) && i_obj->IsWithinDistInMap(u, i_range) && u->GetMaxHealth() - u->GetHealth() > i_hp)
@@ -755,6 +807,8 @@ namespace MaNGOS
         public:
             FriendlyCCedInRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 if (u->IsAlive() && u->IsInCombat() && !i_obj->IsHostileTo(u) && i_obj->IsWithinDistInMap(u, i_range) &&
@@ -774,6 +828,8 @@ namespace MaNGOS
         public:
             FriendlyMissingBuffInRangeCheck(WorldObject const* obj, float range, uint32 spellid) : i_obj(obj), i_range(range), i_spell(spellid) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 if (u->IsAlive() && u->IsInCombat() && !i_obj->IsHostileTo(u) && i_obj->IsWithinDistInMap(u, i_range) &&
@@ -797,6 +853,8 @@ namespace MaNGOS
                 i_controlledByPlayer = obj->IsControlledByPlayer();
             }
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 if (u->IsAlive() && (i_controlledByPlayer ? !i_obj->IsFriendlyTo(u) : i_obj->IsHostileTo(u))
@@ -821,6 +879,8 @@ namespace MaNGOS
             AnyUnfriendlyVisibleUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range)
                 : i_obj(obj), i_funit(funit), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 return u->IsAlive()
@@ -839,6 +899,8 @@ namespace MaNGOS
         public:
             AnyFriendlyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 if (u->IsAlive() && i_obj->IsWithinDistInMap(u, i_range) && i_obj->IsFriendlyTo(u))
@@ -860,6 +922,8 @@ namespace MaNGOS
         public:
             AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 if (u->IsAlive() && i_obj->IsWithinDistInMap(u, i_range))
@@ -880,6 +944,8 @@ namespace MaNGOS
         public:
             NearestAttackableUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 if (u->IsTargetableForAttack() && i_obj->IsWithinDistInMap(u, i_range) &&
@@ -910,6 +976,8 @@ namespace MaNGOS
                 i_targetForPlayer = (i_originalCaster->GetTypeId() == TYPEID_PLAYER);
             }
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 // Check contains checks for: live, non-selectable, non-attackable flags, flight check and GM check, ignore totems
@@ -954,6 +1022,8 @@ namespace MaNGOS
                 i_targetForPlayer = i_obj->IsControlledByPlayer();
             }
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
+            uint32 GetSearchMirrorFlags() const { return GRID_MIRROR_ALIVE; }
             bool operator()(Unit* u)
             {
                 // Check contains checks for: live, non-selectable, non-attackable flags, flight check and GM check, ignore totems
@@ -1058,6 +1128,7 @@ namespace MaNGOS
             NearestAssistCreatureInCreatureRangeCheck(Creature* obj, Unit* enemy, float range)
                 : i_obj(obj), i_enemy(enemy), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            float GetSearchRange() const { return i_range; }
             bool operator()(Creature* u)
             {
                 if (u == i_obj)
@@ -1099,6 +1170,7 @@ namespace MaNGOS
             NearestCreatureEntryWithLiveStateInObjectRangeCheck(WorldObject const& obj, uint32 entry, bool onlyAlive, bool onlyDead, float range, bool excludeSelf = false)
                 : i_obj(obj), i_entry(entry), i_onlyAlive(onlyAlive), i_onlyDead(onlyDead), i_excludeSelf(excludeSelf), i_range(range) {}
             WorldObject const& GetFocusObject() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
             bool operator()(Creature* u)
             {
                 if (u->GetEntry() == i_entry && ((i_onlyAlive && u->IsAlive()) || (i_onlyDead && u->IsCorpse()) || (!i_onlyAlive && !i_onlyDead))
@@ -35,9 +35,9 @@
 #include "DBCStores.h"
 
 template<class T>
-inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
+inline void MaNGOS::VisibleNotifier::Visit(GridObjectList<T>& m)
 {
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (typename GridObjectList<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
         i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
@@ -53,6 +53,14 @@ inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType& m)
     }
 }
 
+inline void MaNGOS::StaleSplinePositionUpdater::Visit(CreatureMapType& m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        iter->getSource()->UpdateStaleSplinePosition();
+    }
+}
+
 inline void PlayerCreatureRelocationWorker(Player* pl, Creature* c)
 {
     // Creature AI reaction
@@ -93,6 +101,12 @@ inline void MaNGOS::PlayerRelocationNotifier::Visit(CreatureMapType& m)
 
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
+        // dead ones are skipped on the mirrored flag, without touching the creature
+        if (!(iter->getMirrorFlags() & GRID_MIRROR_ALIVE))
+        {
+            continue;
+        }
+
         Creature* c = iter->getSource();
         if (c->IsAlive())
         {
@@ -111,6 +125,11 @@ inline void MaNGOS::CreatureRelocationNotifier::Visit(PlayerMapType& m)
 
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
+        if (!(iter->getMirrorFlags() & GRID_MIRROR_ALIVE))
+        {
+            continue;
+        }
+
         Player* player = iter->getSource();
         if (player->IsAlive() && !player->IsTaxiFlying())
         {
@@ -129,6 +148,11 @@ inline void MaNGOS::CreatureRelocationNotifier::Visit(CreatureMapType& m)
 
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
+        if (!(iter->getMirrorFlags() & GRID_MIRROR_ALIVE))
+        {
+            continue;
+        }
+
         Creature* c = iter->getSource();
         if (c != &i_creature && c->IsAlive())
         {
@@ -520,8 +544,14 @@ void MaNGOS::UnitSearcher<Check>::Visit(CreatureMapType& m)
         return;
     }
 
+    SearchFocus focus(i_check.GetFocusObject());
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_object = itr->getSource();
@@ -539,8 +569,14 @@ void MaNGOS::UnitSearcher<Check>::Visit(PlayerMapType& m)
         return;
     }
 
+    SearchFocus focus(i_check.GetFocusObject());
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_object = itr->getSource();
@@ -552,8 +588,14 @@ void MaNGOS::UnitSearcher<Check>::Visit(PlayerMapType& m)
 template<class Check>
 void MaNGOS::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 {
+    SearchFocus focus(i_check.GetFocusObject());
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_object = itr->getSource();
@@ -564,8 +606,14 @@ void MaNGOS::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 template<class Check>
 void MaNGOS::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 {
+    SearchFocus focus(i_check.GetFocusObject());
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_object = itr->getSource();
@@ -576,21 +624,37 @@ void MaNGOS::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
+    SearchFocus focus(i_check.GetFocusObject());
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_objects.push_back(itr->getSource());
         }
+    }
 }
 
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(CreatureMapType& m)
 {
+    SearchFocus focus(i_check.GetFocusObject());
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_objects.push_back(itr->getSource());
         }
+    }
 }
 
 // Creature searchers
@@ -604,8 +668,14 @@ void MaNGOS::CreatureSearcher<Check>::Visit(CreatureMapType& m)
         return;
     }
 
+    SearchFocus focus(i_check.GetFocusObject());
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_object = itr->getSource();
@@ -617,8 +687,14 @@ void MaNGOS::CreatureSearcher<Check>::Visit(CreatureMapType& m)
 template<class Check>
 void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 {
+    SearchFocus focus(i_check.GetFocusObject());
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_object = itr->getSource();
@@ -629,11 +705,19 @@ void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 template<class Check>
 void MaNGOS::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
+    SearchFocus focus(i_check.GetFocusObject());
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_objects.push_back(itr->getSource());
         }
+    }
 }
 
 template<class Check>
@@ -645,8 +729,14 @@ void MaNGOS::PlayerSearcher<Check>::Visit(PlayerMapType& m)
         return;
     }
 
+    SearchFocus focus(i_check.GetFocusObject());
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
     {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_object = itr->getSource();
@@ -658,11 +748,19 @@ void MaNGOS::PlayerSearcher<Check>::Visit(PlayerMapType& m)
 template<class Check>
 void MaNGOS::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
 {
+    SearchFocus focus(i_check.GetFocusObject());
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    {
+        if (IsRejectedByMirror(i_check, focus, itr))
+        {
+            continue;
+        }
+
         if (i_check(itr->getSource()))
         {
             i_objects.push_back(itr->getSource());
         }
+    }
 }
 
 template<class Builder>
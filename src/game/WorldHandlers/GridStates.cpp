@@ -72,11 +72,15 @@ RemovalState::Update(Map& m, NGridType& grid, GridInfo& info, const uint32& x, c
         info.UpdateTimeTracker(t_diff);
         if (info.getTimeTracker().Passed())
         {
-            if (!m.UnloadGrid(x, y, false))
+            if (m.ActiveObjectsNearGrid(x, y))
             {
                 DEBUG_LOG("Grid[%u,%u] for map %u differed unloading due to players or active objects nearby", x, y, m.GetId());
                 m.ResetGridExpiry(grid);
             }
+            else
+            {
+                m.QueueGridUnload(x, y);                    // unloaded at the end of the map update, within the time budget
+            }
         }
     }
 }
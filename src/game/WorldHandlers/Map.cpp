@@ -109,6 +109,8 @@ void Map::LoadMapAndVMap(int gx, int gy)
     if (m_TerrainData->Load(gx, gy))
     {
         m_bLoadedGrids[gx][gy] = true;
+        // queries into this grid were answered without its vmap
+        m_queryCache.Invalidate();
     }
 }
 
@@ -118,6 +120,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+      m_gridsUnloadedLastTick(0), m_gridUnloadTimeLastTick(0), m_gridUnloadTimeMax(0),
       i_data(NULL)
 {
 #ifdef ENABLE_ELUNA
@@ -353,6 +356,16 @@ void Map::ForceLoadGrid(float x, float y)
     }
 }
 
+void Map::PreloadGrid(float x, float y)
+{
+    if (!IsLoaded(x, y))
+    {
+        CellPair p = MaNGOS::ComputeCellPair(x, y);
+        Cell cell(p);
+        EnsureGridLoaded(cell);
+    }
+}
+
 bool Map::Add(Player* player)
 {
     player->GetMapRef().link(this, player);
@@ -530,6 +543,7 @@ bool Map::loaded(const GridPair& p) const
 
 void Map::Update(const uint32& t_diff)
 {
+    m_queryCache.Invalidate();
     m_dyn_tree.update(t_diff);
 
     /// update worldsessions for existing players
@@ -592,13 +606,16 @@ void Map::Update(const uint32& t_diff)
                     CellPair pair(x, y);
                     Cell cell(pair);
                     cell.SetNoCreate();
-                    Visit(cell, grid_object_update);
-                    Visit(cell, world_object_update);
+                    Visit(cell, grid_object_update, false);
+                    Visit(cell, world_object_update, false);
                 }
             }
         }
     }
 
+    // creatures on splines outside of these cells only relocate when crossing a cell border
+    m_observedCells = marked_cells;
+
     // non-player active objects
     if (!m_activeNonPlayers.empty())
     {
@@ -632,14 +649,21 @@ void Map::Update(const uint32& t_diff)
                         CellPair pair(x, y);
                         Cell cell(pair);
                         cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
+                        Visit(cell, grid_object_update, false);
+                        Visit(cell, world_object_update, false);
                     }
                 }
             }
         }
     }
 
+    // transports move within this map here, leaving it is done by MapManager after all map updates
+    for (std::set<Transport*>::const_iterator itr = m_transports.begin(); itr != m_transports.end(); ++itr)
+    {
+        WorldObject::UpdateHelper helper(*itr);
+        helper.Update(t_diff);
+    }
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -655,6 +679,8 @@ void Map::Update(const uint32& t_diff)
             MANGOS_ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
             sMapMgr.UpdateGridState(grid->GetGridState(), *this, *grid, *info, grid->getX(), grid->getY(), t_diff);
         }
+
+        ProcessGridUnloadQueue();
     }
 
     ///- Process necessary scripts
@@ -971,8 +997,76 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
     return true;
 }
 
+void Map::QueueGridUnload(uint32 x, uint32 y)
+{
+    uint32 idx = x * MAX_NUMBER_OF_GRIDS + y;
+    if (m_gridUnloadQueued.test(idx))
+    {
+        return;
+    }
+
+    m_gridUnloadQueued.set(idx);
+    m_gridUnloadQueue.push_back(GridPair(x, y));
+}
+
+void Map::ProcessGridUnloadQueue()
+{
+    m_gridsUnloadedLastTick = 0;
+    m_gridUnloadTimeLastTick = 0;
+
+    if (m_gridUnloadQueue.empty())
+    {
+        return;
+    }
+
+    // at least one grid per tick, so the queue can not grow forever
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_GRID_UNLOAD_TIME_BUDGET);
+    uint32 startTime = getMSTime();
+
+    while (!m_gridUnloadQueue.empty())
+    {
+        if (budget && m_gridsUnloadedLastTick && GetMSTimeDiffToNow(startTime) >= budget)
+        {
+            break;
+        }
+
+        GridPair p = m_gridUnloadQueue.front();
+        m_gridUnloadQueue.pop_front();
+        m_gridUnloadQueued.reset(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord);
+
+        // the grid may have been unloaded or activated again while waiting,
+        // a grid back in removal state has a fresh timer and gets queued again
+        NGridType* grid = getNGrid(p.x_coord, p.y_coord);
+        if (!grid || grid->GetGridState() != GRID_STATE_REMOVAL || grid->getUnloadLock() || !grid->getTimeTracker().Passed())
+        {
+            continue;
+        }
+
+        if (!UnloadGrid(p.x_coord, p.y_coord, false))
+        {
+            DEBUG_LOG("Grid[%u,%u] for map %u differed unloading due to players or active objects nearby", p.x_coord, p.y_coord, GetId());
+            ResetGridExpiry(*grid);
+            continue;
+        }
+
+        ++m_gridsUnloadedLastTick;
+    }
+
+    m_gridUnloadTimeLastTick = GetMSTimeDiffToNow(startTime);
+    if (m_gridUnloadTimeLastTick > m_gridUnloadTimeMax)
+    {
+        m_gridUnloadTimeMax = m_gridUnloadTimeLastTick;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Map %u: %u grids unloaded in %u ms, %u still queued",
+                     GetId(), m_gridsUnloadedLastTick, m_gridUnloadTimeLastTick, uint32(m_gridUnloadQueue.size()));
+}
+
 void Map::UnloadAll(bool pForce)
 {
+    m_gridUnloadQueue.clear();
+    m_gridUnloadQueued.reset();
+
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
     {
         NGridType& grid(*i->getSource());
@@ -1235,6 +1329,15 @@ bool Map::SendToPlayersInZone(WorldPacket const* data, uint32 zoneId) const
     return foundPlayer;
 }
 
+void Map::UpdateStaleSplinePositions(const Cell& cell)
+{
+    m_staleSplineCells.reset(GetCellId(cell));
+
+    MaNGOS::StaleSplinePositionUpdater updater;
+    TypeContainerVisitor<MaNGOS::StaleSplinePositionUpdater, GridTypeMapContainer> visitor(updater);
+    getNGrid(cell.GridX(), cell.GridY())->Visit(cell.CellX(), cell.CellY(), visitor);
+}
+
 bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 {
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
@@ -2233,8 +2336,23 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ);
+    bool useCache = sWorld.getConfig(CONFIG_BOOL_MAP_QUERY_CACHE);
+
+    bool result;
+    if (useCache && m_queryCache.GetLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, result))
+    {
+        return result;
+    }
+
+    result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
+             && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ);
+
+    if (useCache)
+    {
+        m_queryCache.SetLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, result);
+    }
+
+    return result;
 }
 
 /**
@@ -2333,21 +2451,96 @@ bool Map::GetHeightInRange(float x, float y, float& z, float maxSearchDist /*= 4
 
 float Map::GetHeight(float x, float y, float z) const
 {
+    bool useCache = sWorld.getConfig(CONFIG_BOOL_MAP_QUERY_CACHE);
+
+    float height;
+    if (useCache && m_queryCache.GetHeight(x, y, z, height))
+    {
+        return height;
+    }
+
     float staticHeight = m_TerrainData->GetHeightStatic(x, y, z);
 
     // Get Dynamic Height around static Height (if valid)
     float dynSearchHeight = 2.0f + (z < staticHeight ? staticHeight : z);
-    return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight));
+    height = std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight));
+
+    if (useCache)
+    {
+        m_queryCache.SetHeight(x, y, z, height);
+    }
+
+    return height;
+}
+
+void Map::GetHeights(uint32 count, float const* x, float const* y, float const* z, float* heights) const
+{
+    bool useCache = sWorld.getConfig(CONFIG_BOOL_MAP_QUERY_CACHE);
+
+    for (uint32 block = 0; block < count; block += MAP_HEIGHT_BATCH)
+    {
+        uint32 blockEnd = std::min<uint32>(count, block + MAP_HEIGHT_BATCH);
+
+        // cached points are answered directly, the others share one batched static query
+        uint32 index[MAP_HEIGHT_BATCH];
+        float mx[MAP_HEIGHT_BATCH];
+        float my[MAP_HEIGHT_BATCH];
+        float mz[MAP_HEIGHT_BATCH];
+        float staticHeight[MAP_HEIGHT_BATCH];
+        uint32 misses = 0;
+
+        for (uint32 i = block; i < blockEnd; ++i)
+        {
+            if (useCache && m_queryCache.GetHeight(x[i], y[i], z[i], heights[i]))
+            {
+                continue;
+            }
+
+            index[misses] = i;
+            mx[misses] = x[i];
+            my[misses] = y[i];
+            mz[misses] = z[i];
+            ++misses;
+        }
+
+        if (!misses)
+        {
+            continue;
+        }
+
+        m_TerrainData->GetHeightStatic(misses, mx, my, mz, staticHeight);
+
+        for (uint32 m = 0; m < misses; ++m)
+        {
+            // Get Dynamic Height around static Height (if valid)
+            float dynSearchHeight = 2.0f + (mz[m] < staticHeight[m] ? staticHeight[m] : mz[m]);
+            float height = std::max<float>(staticHeight[m], m_dyn_tree.getHeight(mx[m], my[m], dynSearchHeight, dynSearchHeight - staticHeight[m]));
+            heights[index[m]] = height;
+
+            if (useCache)
+            {
+                m_queryCache.SetHeight(mx[m], my[m], mz[m], height);
+            }
+        }
+    }
 }
 
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
+    m_queryCache.Invalidate();
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.remove(mdl);
+    m_queryCache.Invalidate();
+}
+
+void Map::RelocateGameObjectModel(const GameObjectModel& mdl)
+{
+    m_dyn_tree.relocate(mdl);
+    m_queryCache.Invalidate();
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
@@ -2358,37 +2551,61 @@ bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
 // This will generate a random point to all directions in water for the provided point in radius range.
 bool Map::GetRandomPointUnderWater(float& x, float& y, float& z, float radius, GridMapLiquidData& liquid_status)
 {
-    const float angle = rand_norm_f() * (M_PI_F * 2.0f);
-    const float range = rand_norm_f() * radius;
+    float c_x[RANDOM_POINT_CANDIDATES];
+    float c_y[RANDOM_POINT_CANDIDATES];
+    float c_z[RANDOM_POINT_CANDIDATES];
+    float ground[RANDOM_POINT_CANDIDATES];
 
-    float i_x = x + range * cos(angle);
-    float i_y = y + range * sin(angle);
+    float liquidLevel = liquid_status.level - 2.0f; // just to make the generated point is in water and not on surface or a bit above
 
-    // get real ground of new point
+    // the first candidate is tried alone, the others are only drawn and queried together if it does not fit
     // the code consider cylinder instead of sphere for possible z
-    float ground = GetHeight(i_x, i_y, z);
-    if (ground > INVALID_HEIGHT) // GetHeight can fail
+    uint32 begin = 0;
+    uint32 end = 1;
+    while (begin < RANDOM_POINT_CANDIDATES)
     {
-        float min_z = z - 0.7f * radius; // 0.7 to have a bit a "flat" cylinder, TODO which value looks nicest
-        if (min_z < ground)
+        for (uint32 i = begin; i < end; ++i)
         {
-            min_z = ground + 0.5f; // Get some space to prevent under map
+            const float angle = rand_norm_f() * (M_PI_F * 2.0f);
+            const float range = rand_norm_f() * radius;
+
+            c_x[i] = x + range * cos(angle);
+            c_y[i] = y + range * sin(angle);
+            c_z[i] = z;
         }
 
-        float liquidLevel = liquid_status.level - 2.0f; // just to make the generated point is in water and not on surface or a bit above
+        // get real ground of the new points
+        GetHeights(end - begin, c_x + begin, c_y + begin, c_z + begin, ground + begin);
 
-        // if not enough space to fit the creature better is to return from here
-        if (min_z > liquidLevel)
+        for (uint32 i = begin; i < end; ++i)
         {
-            return false;
+            if (ground[i] <= INVALID_HEIGHT) // GetHeight can fail
+            {
+                continue;
+            }
+
+            float min_z = z - 0.7f * radius; // 0.7 to have a bit a "flat" cylinder, TODO which value looks nicest
+            if (min_z < ground[i])
+            {
+                min_z = ground[i] + 0.5f; // Get some space to prevent under map
+            }
+
+            // if not enough space to fit the creature try the next candidate
+            if (min_z > liquidLevel)
+            {
+                continue;
+            }
+
+            float max_z = std::max(z + 0.7f * radius, min_z);
+            max_z = std::min(max_z, liquidLevel);
+            x = c_x[i];
+            y = c_y[i];
+            z = min_z + rand_norm_f() * (max_z - min_z);
+            return true;
         }
 
-        float max_z = std::max(z + 0.7f * radius, min_z);
-        max_z = std::min(max_z, liquidLevel);
-        x = i_x;
-        y = i_y;
-        z = min_z + rand_norm_f() * (max_z - min_z);
-        return true;
+        begin = end;
+        end = RANDOM_POINT_CANDIDATES;
     }
     return false;
 }
@@ -2396,27 +2613,51 @@ bool Map::GetRandomPointUnderWater(float& x, float& y, float& z, float radius, G
 // This will generate a random point to all directions in air for the provided point in radius range.
 bool Map::GetRandomPointInTheAir(float& x, float& y, float& z, float radius)
 {
-    const float angle = rand_norm_f() * (M_PI_F * 2.0f);
-    const float range = rand_norm_f() * radius;
-
-    float i_x = x + range * cos(angle);
-    float i_y = y + range * sin(angle);
+    float c_x[RANDOM_POINT_CANDIDATES];
+    float c_y[RANDOM_POINT_CANDIDATES];
+    float c_z[RANDOM_POINT_CANDIDATES];
+    float ground[RANDOM_POINT_CANDIDATES];
 
-    // get real ground of new point
+    // the first candidate is tried alone, the others are only drawn and queried together if it does not fit
     // the code consider cylinder instead of sphere for possible z
-    float ground = GetHeight(i_x, i_y, z);
-    if (ground > INVALID_HEIGHT) // GetHeight can fail
+    uint32 begin = 0;
+    uint32 end = 1;
+    while (begin < RANDOM_POINT_CANDIDATES)
     {
-        float min_z = z - 0.7f * radius; // 0.7 to have a bit a "flat" cylinder, TODO which value looks nicest
-        if (min_z < ground)
+        for (uint32 i = begin; i < end; ++i)
         {
-            min_z = ground + 2.5f; // Get some space to prevent landing
+            const float angle = rand_norm_f() * (M_PI_F * 2.0f);
+            const float range = rand_norm_f() * radius;
+
+            c_x[i] = x + range * cos(angle);
+            c_y[i] = y + range * sin(angle);
+            c_z[i] = z;
         }
-        float max_z = std::max(z + 0.7f * radius, min_z);
-        x = i_x;
-        y = i_y;
-        z = min_z + rand_norm_f() * (max_z - min_z);
-        return true;
+
+        // get real ground of the new points
+        GetHeights(end - begin, c_x + begin, c_y + begin, c_z + begin, ground + begin);
+
+        for (uint32 i = begin; i < end; ++i)
+        {
+            if (ground[i] <= INVALID_HEIGHT) // GetHeight can fail
+            {
+                continue;
+            }
+
+            float min_z = z - 0.7f * radius; // 0.7 to have a bit a "flat" cylinder, TODO which value looks nicest
+            if (min_z < ground[i])
+            {
+                min_z = ground[i] + 2.5f; // Get some space to prevent landing
+            }
+            float max_z = std::max(z + 0.7f * radius, min_z);
+            x = c_x[i];
+            y = c_y[i];
+            z = min_z + rand_norm_f() * (max_z - min_z);
+            return true;
+        }
+
+        begin = end;
+        end = RANDOM_POINT_CANDIDATES;
     }
     return false;
 }
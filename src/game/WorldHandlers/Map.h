@@ -42,11 +42,13 @@
 #include "ScriptMgr.h"
 #include "CreatureLinkingMgr.h"
 #include "DynamicTree.h"
+#include "MapQueryCache.h"
 #ifdef ENABLE_ELUNA
 #include "LuaValue.h"
 #endif /* ENABLE_ELUNA */
 
 #include <bitset>
+#include <deque>
 
 struct CreatureInfo;
 class Creature;
@@ -66,6 +68,7 @@ class BattleGround;
 class GridMap;
 class GameObjectModel;
 class WeatherSystem;
+class Transport;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -104,6 +107,8 @@ enum LevelRequirementVsMode
 #endif
 
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define MAP_HEIGHT_BATCH      16                            // points per batched terrain query in Map::GetHeights
+#define RANDOM_POINT_CANDIDATES 4                           // candidates tried at once by the random point helpers
 
 class Map : public GridRefManager<NGridType>
 {
@@ -153,7 +158,9 @@ class Map : public GridRefManager<NGridType>
         void PlayerRelocation(Player*, float x, float y, float z, float angl);
         void CreatureRelocation(Creature* creature, float x, float y, float z, float orientation);
 
-        template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
+        // updateStaleSplines: bring lazily relocated spline positions of the cell up to date first, only the
+        // object update itself works without them
+        template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor, bool updateStaleSplines = true);
 
         bool IsRemovalGrid(float x, float y) const
         {
@@ -170,9 +177,22 @@ class Map : public GridRefManager<NGridType>
         bool GetUnloadLock(const GridPair& p) const { return getNGrid(p.x_coord, p.y_coord)->getUnloadLock(); }
         void SetUnloadLock(const GridPair& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadExplicitLock(on); }
         void ForceLoadGrid(float x, float y);
+        // load a grid ahead of an expected arrival, it expires normally if nobody comes
+        void PreloadGrid(float x, float y);
         bool UnloadGrid(const uint32& x, const uint32& y, bool pForce);
+        // expired grid, unloaded by Map::Update within GridUnloadTimeBudget ms per tick
+        void QueueGridUnload(uint32 x, uint32 y);
         virtual void UnloadAll(bool pForce);
 
+        uint32 GetGridUnloadQueueSize() const { return m_gridUnloadQueue.size(); }
+
+        // transports currently on this map, moved by Update(); changed by MapManager between map updates only
+        void AddTransport(Transport* transport) { m_transports.insert(transport); }
+        void RemoveTransport(Transport* transport) { m_transports.erase(transport); }
+        uint32 GetGridsUnloadedLastTick() const { return m_gridsUnloadedLastTick; }
+        uint32 GetGridUnloadTimeLastTick() const { return m_gridUnloadTimeLastTick; }
+        uint32 GetGridUnloadTimeMax() const { return m_gridUnloadTimeMax; }
+
         void ResetGridExpiry(NGridType& grid, float factor = 1) const
         {
             grid.ResetTimeTracker((time_t)((float)i_gridExpiry * factor));
@@ -224,6 +244,11 @@ class Map : public GridRefManager<NGridType>
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
+        // cells in visibility range of a player at the last update
+        bool IsCellObserved(const Cell& cell) const { return m_observedCells.test(GetCellId(cell)); }
+        // a creature of the cell has a spline position that is only computed when the cell is visited
+        void MarkStaleSplineCell(const Cell& cell) { m_staleSplineCells.set(GetCellId(cell)); }
+
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(uint32 x, uint32 y) const;
@@ -265,6 +290,15 @@ class Map : public GridRefManager<NGridType>
         using MapStoredObjectTypesContainer = TypeUnorderedMapContainer<ObjectGuid, TypeList<Creature, Pet, GameObject, DynamicObject>> ;
         MapStoredObjectTypesContainer& GetObjectsStore() { return m_objectsStore; }
 
+        // objects in world at this map by handle, see WorldObject::GetMapHandle()
+        MapObjectSlotTable& GetObjectSlots() { return m_objectSlots; }
+        // guid is checked too: handle can be stale or issued by another map
+        WorldObject* GetWorldObject(MapObjectHandle const& handle, ObjectGuid guid) const
+        {
+            WorldObject* obj = m_objectSlots.Find(handle);
+            return obj && obj->GetObjectGuid() == guid ? obj : NULL;
+        }
+
         void AddUpdateObject(Object* obj)
         {
             i_objectsToClientUpdate.insert(obj);
@@ -291,6 +325,8 @@ class Map : public GridRefManager<NGridType>
 
         // Dynamic VMaps
         float GetHeight(float x, float y, float z) const;
+        // GetHeight for count points at once, neighbouring points should be close to each other
+        void GetHeights(uint32 count, float const* x, float const* y, float const* z, float* heights) const;
         bool GetHeightInRange(float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, float modifyDist) const;
@@ -298,7 +334,11 @@ class Map : public GridRefManager<NGridType>
         // Object Model insertion/remove/test for dynamic vmaps use
         void InsertGameObjectModel(const GameObjectModel& mdl);
         void RemoveGameObjectModel(const GameObjectModel& mdl);
+        void RelocateGameObjectModel(const GameObjectModel& mdl);
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
+        // collision of a model in the tree was toggled (doors)
+        void InvalidateQueryCache() { m_queryCache.Invalidate(); }
+        MapQueryCache const& GetQueryCache() const { return m_queryCache; }
 
         // Get Holder for Creature Linking
         CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
@@ -358,6 +398,7 @@ class Map : public GridRefManager<NGridType>
         void setGridObjectDataLoaded(bool pLoaded, uint32 x, uint32 y) { getNGrid(x, y)->setGridObjectDataLoaded(pLoaded); }
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
+        void ProcessGridUnloadQueue();
         void ScriptsProcess();
 
         void SendObjectUpdates();
@@ -379,6 +420,7 @@ class Map : public GridRefManager<NGridType>
         ActiveNonPlayers m_activeNonPlayers;
         ActiveNonPlayers::iterator m_activeNonPlayersIter;
         MapStoredObjectTypesContainer m_objectsStore;
+        MapObjectSlotTable m_objectSlots;
 
     private:
         time_t i_gridExpiry;
@@ -390,8 +432,25 @@ class Map : public GridRefManager<NGridType>
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> m_observedCells;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> m_staleSplineCells;
+
+        static uint32 GetCellId(const Cell& cell)
+        {
+            CellPair p = cell.cellPair();
+            return p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord;
+        }
+        void UpdateStaleSplinePositions(const Cell& cell);
+
+        // expired grids waiting for unload, oldest first
+        std::deque<GridPair> m_gridUnloadQueue;
+        std::bitset<MAX_NUMBER_OF_GRIDS* MAX_NUMBER_OF_GRIDS> m_gridUnloadQueued;
+        uint32 m_gridsUnloadedLastTick;
+        uint32 m_gridUnloadTimeLastTick;                    // ms
+        uint32 m_gridUnloadTimeMax;                         // ms, longest tick spent unloading
 
         std::set<WorldObject*> i_objectsToRemove;
+        std::set<Transport*> m_transports;
 
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
@@ -416,6 +475,9 @@ class Map : public GridRefManager<NGridType>
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
 
+        // LoS/height results of the current tick
+        mutable MapQueryCache m_queryCache;
+
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 
@@ -493,7 +555,7 @@ class BattleGroundMap : public Map
 
 template<class T, class CONTAINER>
 inline void
-Map::Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor)
+Map::Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor, bool updateStaleSplines)
 {
     const uint32 x = cell.GridX();
     const uint32 y = cell.GridY();
@@ -503,6 +565,12 @@ Map::Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor)
     if (!cell.NoCreate() || loaded(GridPair(x, y)))
     {
         EnsureGridLoaded(cell);
+
+        if (updateStaleSplines && m_staleSplineCells.test(GetCellId(cell)))
+        {
+            UpdateStaleSplinePositions(cell);
+        }
+
         getNGrid(x, y)->Visit(cell_x, cell_y, visitor);
     }
 }
@@ -229,11 +229,7 @@ void MapManager::Update(uint32 diff)
         m_updater.wait();
     }
 
-    for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
-    {
-        WorldObject::UpdateHelper helper((*iter));
-        helper.Update((uint32)i_timer.GetCurrent());
-    }
+    ProcessTransportQueues();
 
     // remove all maps which can be unloaded
     MapMapType::iterator iter = i_maps.begin();
@@ -257,6 +253,50 @@ void MapManager::Update(uint32 diff)
     i_timer.SetCurrent(0);
 }
 
+void MapManager::QueueTransportHandoff(Transport* transport)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_transportQueueLock);
+    m_transportHandoffs.push_back(transport);
+}
+
+void MapManager::QueueTransportPreload(uint32 mapId, float x, float y)
+{
+    TransportPreload preload;
+    preload.mapId = mapId;
+    preload.x = x;
+    preload.y = y;
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_transportQueueLock);
+    m_transportPreloads.push_back(preload);
+}
+
+void MapManager::ProcessTransportQueues()
+{
+    // the map workers are done, no lock needed anymore
+    for (std::vector<TransportPreload>::const_iterator itr = m_transportPreloads.begin(); itr != m_transportPreloads.end(); ++itr)
+    {
+        MapEntry const* entry = sMapStore.LookupEntry(itr->mapId);
+        if (!entry || entry->Instanceable())
+        {
+            continue;
+        }
+
+        if (Map* map = CreateMap(itr->mapId, NULL))
+        {
+            map->PreloadGrid(itr->x, itr->y);
+        }
+    }
+
+    m_transportPreloads.clear();
+
+    for (std::vector<Transport*>::const_iterator itr = m_transportHandoffs.begin(); itr != m_transportHandoffs.end(); ++itr)
+    {
+        (*itr)->Handoff();
+    }
+
+    m_transportHandoffs.clear();
+}
+
 void MapManager::RemoveAllObjectsInRemoveList()
 {
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
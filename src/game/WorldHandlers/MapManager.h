@@ -149,6 +149,11 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         typedef std::map<uint32, TransportSet> TransportMap;
         TransportMap m_TransportsByMap;
 
+        // called by map workers: transports leaving their map (or teleporting) and grids to load before
+        // a transport arrives are handled by Update() after all maps are updated
+        void QueueTransportHandoff(Transport* transport);
+        void QueueTransportPreload(uint32 mapId, float x, float y);
+
         uint32 GenerateInstanceId() { return ++i_MaxInstanceId; }
         void InitMaxInstanceId();
         void InitializeVisibilityDistanceInfo();
@@ -190,6 +195,8 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void InitStateMachine();
         void DeleteStateMachine();
 
+        void ProcessTransportQueues();
+
         Map* CreateInstance(uint32 id, Player* player);
         DungeonMap* CreateDungeonMap(uint32 id, uint32 InstanceId, Difficulty difficulty, DungeonPersistentState* save = NULL);
         BattleGroundMap* CreateBattleGroundMap(uint32 id, uint32 InstanceId, BattleGround* bg);
@@ -198,6 +205,17 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         MapMapType i_maps;
         IntervalTimer i_timer;
         MapUpdater m_updater;
+
+        struct TransportPreload
+        {
+            uint32 mapId;
+            float x;
+            float y;
+        };
+
+        std::vector<Transport*> m_transportHandoffs;
+        std::vector<TransportPreload> m_transportPreloads;
+        ACE_Thread_Mutex m_transportQueueLock;              // map workers queue concurrently
         uint32 i_MaxInstanceId;
 
         typedef ACE_Recursive_Thread_Mutex LOCK_TYPE;
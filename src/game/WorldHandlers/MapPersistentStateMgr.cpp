@@ -77,56 +77,109 @@ bool MapPersistentState::UnloadIfEmpty()
 
 void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
 {
-    SetCreatureRespawnTime(loguid, t);
-
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
-    if (GetMapEntry()->IsBattleGroundOrArena())
+    if (!GetMapEntry()->IsBattleGroundOrArena())
     {
-        return;
+        m_dirtyCreatureRespawns.insert(loguid);
     }
 
-    CharacterDatabase.BeginTransaction();
+    // last, state can be unloaded at call (pending respawn times are written before that)
+    SetCreatureRespawnTime(loguid, t);
+}
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+{
+    // BGs/Arenas always reset at server restart/unload, so no reason store in DB
+    if (!GetMapEntry()->IsBattleGroundOrArena())
+    {
+        m_dirtyGORespawns.insert(loguid);
+    }
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM `creature_respawn` WHERE `guid` = ? AND `instance` = ?");
-    stmt.PExecute(loguid, m_instanceid);
+    // last, state can be unloaded at call (pending respawn times are written before that)
+    SetGORespawnTime(loguid, t);
+}
 
-    if (t > sWorld.GetGameTime())
+void MapPersistentState::SaveRespawnTimesToDB()
+{
+    if (m_dirtyCreatureRespawns.empty() && m_dirtyGORespawns.empty())
     {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO `creature_respawn` VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
+        return;
     }
 
+    CharacterDatabase.BeginTransaction();
+    SaveRespawnTimesToDB("creature_respawn", m_creatureRespawnTimes, m_dirtyCreatureRespawns);
+    SaveRespawnTimesToDB("gameobject_respawn", m_goRespawnTimes, m_dirtyGORespawns);
     CharacterDatabase.CommitTransaction();
 }
 
-void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+void MapPersistentState::SaveRespawnTimesToDB(char const* table, RespawnTimes const& times, RespawnGuids& dirty)
 {
-    SetGORespawnTime(loguid, t);
+    // rows per statement, keeps single statements well below max_allowed_packet
+    static const uint32 RESPAWN_SAVE_BATCH_SIZE = 500;
 
-    // BGs/Arenas always reset at server restart/unload, so no reason store in DB
-    if (GetMapEntry()->IsBattleGroundOrArena())
+    time_t now = sWorld.GetGameTime();
+
+    std::ostringstream replaceSql;
+    std::ostringstream deleteSql;
+    uint32 replaceCount = 0;
+    uint32 deleteCount = 0;
+
+    for (RespawnGuids::const_iterator itr = dirty.begin(); itr != dirty.end(); ++itr)
     {
-        return;
-    }
+        RespawnTimes::const_iterator timeItr = times.find(*itr);
+        if (timeItr != times.end() && timeItr->second > now)
+        {
+            if (!replaceCount)
+            {
+                replaceSql << "REPLACE INTO `" << table << "` (`guid`, `respawntime`, `instance`) VALUES ";
+            }
+            else
+            {
+                replaceSql << ", ";
+            }
+            replaceSql << "(" << *itr << ", " << uint64(timeItr->second) << ", " << m_instanceid << ")";
 
-    CharacterDatabase.BeginTransaction();
+            if (++replaceCount == RESPAWN_SAVE_BATCH_SIZE)
+            {
+                CharacterDatabase.Execute(replaceSql.str().c_str());
+                replaceSql.str("");
+                replaceCount = 0;
+            }
+        }
+        else
+        {
+            if (!deleteCount)
+            {
+                deleteSql << "DELETE FROM `" << table << "` WHERE `instance` = " << m_instanceid << " AND `guid` IN (";
+            }
+            else
+            {
+                deleteSql << ", ";
+            }
+            deleteSql << *itr;
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+            if (++deleteCount == RESPAWN_SAVE_BATCH_SIZE)
+            {
+                deleteSql << ")";
+                CharacterDatabase.Execute(deleteSql.str().c_str());
+                deleteSql.str("");
+                deleteCount = 0;
+            }
+        }
+    }
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM `gameobject_respawn` WHERE `guid` = ? AND `instance` = ?");
-    stmt.PExecute(loguid, m_instanceid);
+    if (replaceCount)
+    {
+        CharacterDatabase.Execute(replaceSql.str().c_str());
+    }
 
-    if (t > sWorld.GetGameTime())
+    if (deleteCount)
     {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO `gameobject_respawn` VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
+        deleteSql << ")";
+        CharacterDatabase.Execute(deleteSql.str().c_str());
     }
 
-    CharacterDatabase.CommitTransaction();
+    dirty.clear();
 }
 
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
@@ -280,11 +333,13 @@ void DungeonPersistentState::DeleteRespawnTimes()
     CharacterDatabase.PExecute("DELETE FROM `gameobject_respawn` WHERE `instance` = '%u'", GetInstanceId());
     CharacterDatabase.CommitTransaction();
 
+    ForgetUnsavedRespawnTimes();                            // all rows of the instance are gone already
     ClearRespawnTimes();                                    // state can be deleted at call if only respawn data prevent unload
 }
 
 void DungeonPersistentState::DeleteFromDB()
 {
+    ForgetUnsavedRespawnTimes();
     MapPersistentStateManager::DeleteInstanceFromDB(GetInstanceId());
 }
 
@@ -748,6 +803,7 @@ void MapPersistentStateManager::RemovePersistentState(uint32 mapId, uint32 insta
                     CharacterDatabase.PExecute("UPDATE `instance` SET `resettime` = '" UI64FMTD "' WHERE `id` = '%u'", (uint64)resettime, instanceId);
                 }
 
+            itr->second->SaveRespawnTimesToDB();
             _ResetSave(m_instanceSaveByInstanceId, itr);
         }
     }
@@ -756,11 +812,24 @@ void MapPersistentStateManager::RemovePersistentState(uint32 mapId, uint32 insta
         PersistentStateMap::iterator itr = m_instanceSaveByMapId.find(mapId);
         if (itr != m_instanceSaveByMapId.end())
         {
+            itr->second->SaveRespawnTimesToDB();
             _ResetSave(m_instanceSaveByMapId, itr);
         }
     }
 }
 
+void MapPersistentStateManager::SaveRespawnTimes()
+{
+    for (PersistentStateMap::const_iterator itr = m_instanceSaveByInstanceId.begin(); itr != m_instanceSaveByInstanceId.end(); ++itr)
+    {
+        itr->second->SaveRespawnTimesToDB();
+    }
+    for (PersistentStateMap::const_iterator itr = m_instanceSaveByMapId.begin(); itr != m_instanceSaveByMapId.end(); ++itr)
+    {
+        itr->second->SaveRespawnTimesToDB();
+    }
+}
+
 void MapPersistentStateManager::_DelHelper(DatabaseType& db, const char* fields, const char* table, const char* queryTail, ...)
 {
     Tokens fieldTokens = StrSplit(fields, ", ");
@@ -90,6 +90,7 @@ class MapPersistentState
             m_usedByMap = map;
             if (!map)
             {
+                SaveRespawnTimesToDB();                     // instance unload, write pending respawn times
                 UnloadIfEmpty();
             }
         }
@@ -106,6 +107,8 @@ class MapPersistentState
             return itr != m_goRespawnTimes.end() ? itr->second : 0;
         }
         void SaveGORespawnTime(uint32 loguid, time_t t);
+        // write respawn times changed since last call, in batched statements (called periodically, at unload and shutdown)
+        void SaveRespawnTimesToDB();
 
         // pool system
         void InitPools();
@@ -126,6 +129,7 @@ class MapPersistentState
         bool UnloadIfEmpty();
         void ClearRespawnTimes();
         bool HasRespawnTimes() const { return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty(); }
+        void ForgetUnsavedRespawnTimes() { m_dirtyCreatureRespawns.clear(); m_dirtyGORespawns.clear(); }
 
     private:
         void SetCreatureRespawnTime(uint32 loguid, time_t t);
@@ -133,6 +137,9 @@ class MapPersistentState
 
     private:
         typedef UNORDERED_MAP<uint32, time_t> RespawnTimes;
+        typedef std::set<uint32> RespawnGuids;
+
+        void SaveRespawnTimesToDB(char const* table, RespawnTimes const& times, RespawnGuids& dirty);
 
         uint32 m_instanceid;
         uint32 m_mapid;
@@ -143,6 +150,10 @@ class MapPersistentState
         RespawnTimes m_creatureRespawnTimes;                // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         RespawnTimes m_goRespawnTimes;                      // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         MapCellObjectGuidsMap m_gridObjectGuids;            // Single map copy specific grid spawn data, like pool spawns
+
+        // respawn times changed in memory but not written to DB yet
+        RespawnGuids m_dirtyCreatureRespawns;
+        RespawnGuids m_dirtyGORespawns;
 };
 
 inline bool MapPersistentState::CanBeUnload() const
@@ -351,6 +362,9 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
 
         void RemovePersistentState(uint32 mapId, uint32 instanceId);
 
+        // write pending respawn times of all states
+        void SaveRespawnTimes();
+
         template<typename Do>
         void DoForAllStatesWithMapId(uint32 mapId, Do& _do);
 
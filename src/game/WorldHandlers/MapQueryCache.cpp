@@ -0,0 +1,128 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "MapQueryCache.h"
+
+// 1/32 yard, far below anything the client can tell apart
+static const float QUANTIZE_SCALE = 32.0f;
+// keeps the int32 conversion defined for MAX_HEIGHT and invalid height markers
+static const float QUANTIZE_LIMIT = 60000000.0f;
+
+MapQueryCache::MapQueryCache() : m_generation(1),
+    m_losHits(0), m_losMisses(0), m_heightHits(0), m_heightMisses(0)
+{
+    memset(m_los, 0, sizeof(m_los));
+    memset(m_height, 0, sizeof(m_height));
+}
+
+void MapQueryCache::Invalidate()
+{
+    if (++m_generation == 0)
+    {
+        // wrapped, old entries could look current again
+        memset(m_los, 0, sizeof(m_los));
+        memset(m_height, 0, sizeof(m_height));
+        m_generation = 1;
+    }
+}
+
+void MapQueryCache::Quantize(int32* key, float const* coords, uint32 count)
+{
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float value = coords[i] * QUANTIZE_SCALE;
+        key[i] = int32(floor(value > QUANTIZE_LIMIT ? QUANTIZE_LIMIT : (value < -QUANTIZE_LIMIT ? -QUANTIZE_LIMIT : value)));
+    }
+}
+
+uint32 MapQueryCache::Hash(int32 const* key, uint32 count)
+{
+    // FNV-1a over the quantized coordinates
+    uint32 hash = 2166136261u;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        hash = (hash ^ uint32(key[i])) * 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+bool MapQueryCache::GetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool& result)
+{
+    float const coords[6] = { x1, y1, z1, x2, y2, z2 };
+    int32 key[6];
+    Quantize(key, coords, 6);
+
+    LineOfSightEntry const& entry = m_los[Hash(key, 6) & (LOS_CACHE_SIZE - 1)];
+    if (entry.generation != m_generation || memcmp(entry.key, key, sizeof(key)) != 0)
+    {
+        ++m_losMisses;
+        return false;
+    }
+
+    ++m_losHits;
+    result = entry.result;
+    return true;
+}
+
+void MapQueryCache::SetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool result)
+{
+    float const coords[6] = { x1, y1, z1, x2, y2, z2 };
+    int32 key[6];
+    Quantize(key, coords, 6);
+
+    LineOfSightEntry& entry = m_los[Hash(key, 6) & (LOS_CACHE_SIZE - 1)];
+    memcpy(entry.key, key, sizeof(key));
+    entry.generation = m_generation;
+    entry.result = result;
+}
+
+bool MapQueryCache::GetHeight(float x, float y, float z, float& height)
+{
+    float const coords[3] = { x, y, z };
+    int32 key[3];
+    Quantize(key, coords, 3);
+
+    HeightEntry const& entry = m_height[Hash(key, 3) & (HEIGHT_CACHE_SIZE - 1)];
+    if (entry.generation != m_generation || memcmp(entry.key, key, sizeof(key)) != 0)
+    {
+        ++m_heightMisses;
+        return false;
+    }
+
+    ++m_heightHits;
+    height = entry.height;
+    return true;
+}
+
+void MapQueryCache::SetHeight(float x, float y, float z, float height)
+{
+    float const coords[3] = { x, y, z };
+    int32 key[3];
+    Quantize(key, coords, 3);
+
+    HeightEntry& entry = m_height[Hash(key, 3) & (HEIGHT_CACHE_SIZE - 1)];
+    memcpy(entry.key, key, sizeof(key));
+    entry.generation = m_generation;
+    entry.height = height;
+}
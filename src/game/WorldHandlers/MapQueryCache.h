@@ -0,0 +1,91 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_MAPQUERYCACHE
+#define MANGOS_H_MAPQUERYCACHE
+
+#include "Common.h"
+
+/**
+ * @brief memo of line of sight and height queries made during one map tick
+ *
+ * Direct mapped tables keyed by positions quantized to QUANTIZE_STEP yards.
+ * All entries are dropped in O(1) by bumping the generation: once per map
+ * tick and whenever the dynamic gameobject tree changes. Like the dynamic
+ * tree itself, the cache is only used from the thread updating the map.
+ */
+class MapQueryCache
+{
+    public:
+        MapQueryCache();
+
+        /// drop all cached results
+        void Invalidate();
+
+        bool GetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool& result);
+        void SetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool result);
+
+        bool GetHeight(float x, float y, float z, float& height);
+        void SetHeight(float x, float y, float z, float height);
+
+        uint32 GetLineOfSightHits() const { return m_losHits; }
+        uint32 GetLineOfSightMisses() const { return m_losMisses; }
+        uint32 GetHeightHits() const { return m_heightHits; }
+        uint32 GetHeightMisses() const { return m_heightMisses; }
+
+    private:
+        enum
+        {
+            LOS_CACHE_SIZE      = 1024,                     // power of 2
+            HEIGHT_CACHE_SIZE   = 1024                      // power of 2
+        };
+
+        struct LineOfSightEntry
+        {
+            int32 key[6];
+            uint32 generation;
+            bool result;
+        };
+
+        struct HeightEntry
+        {
+            int32 key[3];
+            uint32 generation;
+            float height;
+        };
+
+        static void Quantize(int32* key, float const* coords, uint32 count);
+        static uint32 Hash(int32 const* key, uint32 count);
+
+        LineOfSightEntry m_los[LOS_CACHE_SIZE];
+        HeightEntry m_height[HEIGHT_CACHE_SIZE];
+        uint32 m_generation;                                // 0 marks unused entries
+
+        uint32 m_losHits;
+        uint32 m_losMisses;
+        uint32 m_heightHits;
+        uint32 m_heightMisses;
+};
+
+#endif
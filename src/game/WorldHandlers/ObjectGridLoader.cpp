@@ -40,7 +40,7 @@ class ObjectGridRespawnMover
 
         void Move(GridType& grid);
 
-        template<class T> void Visit(GridRefManager<T>&) {}
+        template<class T> void Visit(GridObjectList<T>&) {}
         void Visit(CreatureMapType& m);
 };
 
@@ -90,7 +90,7 @@ class ObjectWorldLoader
 
         void Visit(CorpseMapType& m);
 
-        template<class T> void Visit(GridRefManager<T>&) { }
+        template<class T> void Visit(GridObjectList<T>&) { }
 
     private:
         Cell i_cell;
@@ -112,7 +112,7 @@ template<> void addUnitState(Creature* obj, CellPair const& cell_pair)
 }
 
 template <class T>
-void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>& /*m*/, uint32& count, Map* map, GridType& grid)
+void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridObjectList<T>& /*m*/, uint32& count, Map* map, GridType& grid)
 {
     BattleGround* bg = map->IsBattleGroundOrArena() ? ((BattleGroundMap*)map)->GetBG() : NULL;
 
@@ -284,17 +284,18 @@ ObjectGridUnloader::Unload(GridType& grid)
 
 template<class T>
 void
-ObjectGridUnloader::Visit(GridRefManager<T>& m)
+ObjectGridUnloader::Visit(GridObjectList<T>& m)
 {
     // remove all cross-reference before deleting
-    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (typename GridObjectList<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         iter->getSource()->CleanupsBeforeDelete();
     }
 
-    while (!m.isEmpty())
+    // deleting unlinks the object, the list keeps indices stable until the visit ends
+    for (typename GridObjectList<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        T* obj = m.getFirst()->getSource();
+        T* obj = iter->getSource();
         // if option set then object already saved at this moment
         if (!sWorld.getConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY))
         {
@@ -302,7 +303,7 @@ ObjectGridUnloader::Visit(GridRefManager<T>& m)
         }
         ///- object must be out of world before delete
         obj->RemoveFromWorld();
-        ///- object will get delinked from the manager when deleted
+        ///- object will get delinked from the list when deleted
         delete obj;
     }
 }
@@ -81,7 +81,7 @@ class ObjectGridUnloader
         }
 
         void Unload(GridType& grid);
-        template<class T> void Visit(GridRefManager<T>& m);
+        template<class T> void Visit(GridObjectList<T>& m);
     private:
         NGridType& i_grid;
 };
@@ -107,7 +107,7 @@ class ObjectGridStoper
         void Stop(GridType& grid);
         void Visit(CreatureMapType& m);
 
-        template<class NONACTIVE> void Visit(GridRefManager<NONACTIVE>&) {}
+        template<class NONACTIVE> void Visit(GridObjectList<NONACTIVE>&) {}
     private:
         NGridType& i_grid;
 };
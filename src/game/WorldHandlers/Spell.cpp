@@ -97,6 +97,7 @@ void SpellCastTargets::setUnitTarget(Unit* target)
     m_destZ = target->GetPositionZ();
     m_unitTarget = target;
     m_unitTargetGUID = target->GetObjectGuid();
+    m_unitTargetHandle = target->GetMapHandle();
     m_targetMask |= TARGET_FLAG_UNIT;
 }
 
@@ -120,6 +121,7 @@ void SpellCastTargets::setGOTarget(GameObject* target)
 {
     m_GOTarget = target;
     m_GOTargetGUID = target->GetObjectGuid();
+    m_GOTargetHandle = target->GetMapHandle();
     //    m_targetMask |= TARGET_FLAG_OBJECT;
 }
 
@@ -152,10 +154,34 @@ void SpellCastTargets::setCorpseTarget(Corpse* corpse)
 
 void SpellCastTargets::Update(Unit* caster)
 {
-    m_GOTarget   = m_GOTargetGUID ? caster->GetMap()->GetGameObject(m_GOTargetGUID) : NULL;
-    m_unitTarget = m_unitTargetGUID ?
-                   (m_unitTargetGUID == caster->GetObjectGuid() ? caster : sObjectAccessor.GetUnit(*caster, m_unitTargetGUID)) :
-                       NULL;
+    Map* map = caster->GetMap();
+
+    m_GOTarget = NULL;
+    if (m_GOTargetGUID)
+    {
+        // slot lookup first, the guid check makes a stale handle or one of another map miss
+        m_GOTarget = (GameObject*)map->GetWorldObject(m_GOTargetHandle, m_GOTargetGUID);
+        if (!m_GOTarget)
+        {
+            m_GOTarget = map->GetGameObject(m_GOTargetGUID);
+            m_GOTargetHandle = m_GOTarget ? m_GOTarget->GetMapHandle() : MapObjectHandle();
+        }
+    }
+
+    m_unitTarget = NULL;
+    if (m_unitTargetGUID == caster->GetObjectGuid())
+    {
+        m_unitTarget = caster;
+    }
+    else if (m_unitTargetGUID)
+    {
+        m_unitTarget = (Unit*)map->GetWorldObject(m_unitTargetHandle, m_unitTargetGUID);
+        if (!m_unitTarget)
+        {
+            m_unitTarget = sObjectAccessor.GetUnit(*caster, m_unitTargetGUID);
+            m_unitTargetHandle = m_unitTarget ? m_unitTarget->GetMapHandle() : MapObjectHandle();
+        }
+    }
 
     m_itemTarget = NULL;
     if (caster->GetTypeId() == TYPEID_PLAYER)
@@ -7578,7 +7604,13 @@ void Spell::UpdateOriginalCasterPointer()
     }
     else
     {
-        Unit* unit = sObjectAccessor.GetUnit(*m_caster, m_originalCasterGUID);
+        Unit* unit = m_caster->IsInWorld() ? (Unit*)m_caster->GetMap()->GetWorldObject(m_originalCasterHandle, m_originalCasterGUID) : NULL;
+        if (!unit)
+        {
+            unit = sObjectAccessor.GetUnit(*m_caster, m_originalCasterGUID);
+            m_originalCasterHandle = unit ? unit->GetMapHandle() : MapObjectHandle();
+        }
+
         m_originalCaster = unit && unit->IsInWorld() ? unit : NULL;
     }
 }
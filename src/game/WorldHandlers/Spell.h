@@ -107,6 +107,9 @@ class SpellCastTargets
             m_CorpseTargetGUID  = target.m_CorpseTargetGUID;
             m_itemTargetGUID    = target.m_itemTargetGUID;
 
+            m_unitTargetHandle  = target.m_unitTargetHandle;
+            m_GOTargetHandle    = target.m_GOTargetHandle;
+
             m_itemTargetEntry  = target.m_itemTargetEntry;
 
             m_srcX = target.m_srcX;
@@ -178,6 +181,10 @@ class SpellCastTargets
         ObjectGuid m_CorpseTargetGUID;
         ObjectGuid m_itemTargetGUID;
         uint32 m_itemTargetEntry;
+
+        // caster map slots of the targets, resolved before falling back to guid lookup at Update
+        MapObjectHandle m_unitTargetHandle;
+        MapObjectHandle m_GOTargetHandle;
 };
 
 inline ByteBuffer& operator<< (ByteBuffer& buf, SpellCastTargets const& targets)
@@ -475,6 +482,7 @@ class Spell
         ObjectGuid m_originalCasterGUID;                    // real source of cast (aura caster/etc), used for spell targets selection
         // e.g. damage around area spell trigered by victim aura and da,age emeies of aura caster
         Unit* m_originalCaster;                             // cached pointer for m_originalCaster, updated at Spell::UpdatePointers()
+        MapObjectHandle m_originalCasterHandle;             // caster map slot of m_originalCaster, tried first at Spell::UpdatePointers()
 
         Spell** m_selfContainer;                            // pointer to our spell container (if applicable)
 
@@ -668,7 +676,7 @@ namespace MaNGOS
                 }
             }
         }
-        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+        template<class SKIP> void Visit(GridObjectList<SKIP>&) {}
     };
 
     struct SpellNotifierCreatureAndPlayer
@@ -734,7 +742,7 @@ namespace MaNGOS
             }
         }
 
-        template<class T> inline void Visit(GridRefManager<T>&  m)
+        template<class T> inline void Visit(GridObjectList<T>&  m)
         {
             MANGOS_ASSERT(i_data);
 
@@ -743,7 +751,7 @@ namespace MaNGOS
                 return;
             }
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            for (typename GridObjectList<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
             {
                 // there are still more spells which can be casted on dead, but
                 // they are no AOE and don't have such a nice SPELL_ATTR flag
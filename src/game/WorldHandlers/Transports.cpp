@@ -120,7 +120,9 @@ void MapManager::LoadTransports()
         }
 
         // If we someday decide to use the grid to track transports, here:
-        t->SetMap(sMapMgr.CreateMap(mapid, t));
+        Map* map = sMapMgr.CreateMap(mapid, t);
+        t->SetMap(map);
+        map->AddTransport(t);
 
         // t->GetMap()->Add<GameObject>((GameObject *)t);
         ++count;
@@ -150,7 +152,7 @@ void MapManager::LoadTransports()
     sLog.outString();
 }
 
-Transport::Transport() : GameObject()
+Transport::Transport() : GameObject(), m_pathTime(0), m_timer(0), m_handoffPending(false), m_nextNodeTime(0), m_period(0)
 {
     // 2.3.2 - 0x5A
     m_updateFlag = (UPDATEFLAG_TRANSPORT | UPDATEFLAG_LOWGUID | UPDATEFLAG_HIGHGUID | UPDATEFLAG_HAS_POSITION);
@@ -459,6 +461,19 @@ bool Transport::GenerateWaypoints(uint32 pathid, std::set<uint32>& mapids)
 
     m_nextNodeTime = m_curr->first;
 
+    uint32 lastMapId = m_WayPoints.rbegin()->second.mapid;
+    for (WayPointMap::const_iterator itr = m_WayPoints.begin(); itr != m_WayPoints.end(); ++itr)
+    {
+        if (itr->second.teleport || itr->second.mapid != lastMapId)
+        {
+            m_handoffNodes.push_back(itr);
+        }
+
+        lastMapId = itr->second.mapid;
+    }
+
+    m_preloaded = m_WayPoints.end();
+
     return true;
 }
 
@@ -475,7 +490,7 @@ void Transport::MoveToNextWayPoint()
 
 void Transport::TeleportTransport(uint32 newMapid, float x, float y, float z)
 {
-    Map const* oldMap = GetMap();
+    Map* oldMap = GetMap();
     Relocate(x, y, z);
 
     for (PlayerSet::iterator itr = m_passengers.begin(); itr != m_passengers.end();)
@@ -509,11 +524,52 @@ void Transport::TeleportTransport(uint32 newMapid, float x, float y, float z)
 
     if (oldMap != newMap)
     {
+        oldMap->RemoveTransport(this);
+        newMap->AddTransport(this);
+
         UpdateForMap(oldMap);
         UpdateForMap(newMap);
     }
 }
 
+void Transport::Handoff()
+{
+    m_handoffPending = false;
+    TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+}
+
+void Transport::PreloadNextHandoff()
+{
+    if (m_handoffNodes.empty())
+    {
+        return;
+    }
+
+    // first handoff node after the current one, the path is a loop
+    WayPointMap::const_iterator next = m_handoffNodes.front();
+    for (size_t i = 0; i < m_handoffNodes.size(); ++i)
+    {
+        if (m_handoffNodes[i]->first > m_curr->first)
+        {
+            next = m_handoffNodes[i];
+            break;
+        }
+    }
+
+    if (next == m_preloaded)
+    {
+        return;
+    }
+
+    uint32 now = m_timer % m_pathTime;
+    uint32 timeLeft = next->first >= now ? next->first - now : next->first + m_pathTime - now;
+    if (timeLeft <= TRANSPORT_PRELOAD_TIME)
+    {
+        m_preloaded = next;
+        sMapMgr.QueueTransportPreload(next->second.mapid, next->second.x, next->second.y);
+    }
+}
+
 bool Transport::AddPassenger(Player* passenger)
 {
     if (m_passengers.find(passenger) == m_passengers.end())
@@ -535,7 +591,7 @@ bool Transport::RemovePassenger(Player* passenger)
 
 void Transport::Update(uint32 /*update_diff*/, uint32 /*p_time*/)
 {
-    if (m_WayPoints.size() <= 1)
+    if (m_WayPoints.size() <= 1 || m_handoffPending)
     {
         return;
     }
@@ -549,25 +605,6 @@ void Transport::Update(uint32 /*update_diff*/, uint32 /*p_time*/)
 
         DoEventIfAny(*m_curr, false);
 
-        // first check help in case client-server transport coordinates de-synchronization
-        if (m_curr->second.mapid != GetMapId() || m_curr->second.teleport)
-        {
-            TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
-        }
-        else
-        {
-            Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z);
-        }
-
-        /*
-        for(PlayerSet::const_iterator itr = m_passengers.begin(); itr != m_passengers.end();)
-        {
-            PlayerSet::const_iterator it2 = itr;
-            ++itr;
-            //(*it2)->SetPosition( m_curr->second.x + (*it2)->GetTransOffsetX(), m_curr->second.y + (*it2)->GetTransOffsetY(), m_curr->second.z + (*it2)->GetTransOffsetZ(), (*it2)->GetTransOffsetO() );
-        }
-        */
-
         m_nextNodeTime = m_curr->first;
 
         if (m_curr == m_WayPoints.begin())
@@ -576,7 +613,20 @@ void Transport::Update(uint32 /*update_diff*/, uint32 /*p_time*/)
         }
 
         DETAIL_FILTER_LOG(LOG_FILTER_TRANSPORT_MOVES, "%s moved to %f %f %f %d", GetName(), m_curr->second.x, m_curr->second.y, m_curr->second.z, m_curr->second.mapid);
+
+        // first check help in case client-server transport coordinates de-synchronization
+        // teleports touch other maps and the passengers, MapManager does them after the map updates
+        if (m_curr->second.mapid != GetMapId() || m_curr->second.teleport)
+        {
+            m_handoffPending = true;
+            sMapMgr.QueueTransportHandoff(this);
+            return;
+        }
+
+        Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z);
     }
+
+    PreloadNextHandoff();
 }
 
 void Transport::UpdateForMap(Map const* targetMap)
@@ -30,6 +30,8 @@
 #include <map>
 #include <set>
 
+#define TRANSPORT_PRELOAD_TIME  (20 * IN_MILLISECONDS)      // grid at the next map change is loaded this long before arrival
+
 class Transport : public GameObject
 {
     public:
@@ -38,6 +40,8 @@ class Transport : public GameObject
         bool Create(uint32 guidlow, uint32 mapid, float x, float y, float z, float ang, uint32 animprogress);
         bool GenerateWaypoints(uint32 pathid, std::set<uint32>& mapids);
         void Update(uint32 update_diff, uint32 p_time) override;
+        // leave the map / teleport as queued by Update(), called by MapManager after the map updates
+        void Handoff();
         bool AddPassenger(Player* passenger);
         bool RemovePassenger(Player* passenger);
 
@@ -70,6 +74,10 @@ class Transport : public GameObject
         uint32 m_pathTime;
         uint32 m_timer;
 
+        std::vector<WayPointMap::const_iterator> m_handoffNodes; // nodes changing map or teleporting, path order
+        WayPointMap::const_iterator m_preloaded;            // handoff node whose grid was requested last
+        bool m_handoffPending;
+
         PlayerSet m_passengers;
 
     public:
@@ -82,5 +90,6 @@ class Transport : public GameObject
         void UpdateForMap(Map const* map);
         void DoEventIfAny(WayPointMap::value_type const& node, bool departure);
         void MoveToNextWayPoint();                          // move m_next/m_cur to next points
+        void PreloadNextHandoff();
 };
 #endif
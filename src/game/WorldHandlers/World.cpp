@@ -47,6 +47,7 @@
 #include "Chat.h"
 #include "DBCStores.h"
 #include "MassMailMgr.h"
+#include "WorldTaskMgr.h"
 #include "LootMgr.h"
 #include "ItemEnchantmentMgr.h"
 #include "MapManager.h"
@@ -69,6 +70,7 @@
 #include "Util.h"
 #include "AuctionHouseBot/AuctionHouseBot.h"
 #include "CharacterDatabaseCleaner.h"
+#include "UpdateFieldConverter.h"
 #include "CreatureLinkingMgr.h"
 #include "Weather.h"
 #include "DisableMgr.h"
@@ -519,7 +521,12 @@ void World::LoadConfigSettings(bool reload)
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
+    setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB_DRY_RUN, "CleanCharacterDB.DryRun", false);
+    setConfig(CONFIG_BOOL_COMPACT_UPDATE_FIELDS, "CompactUpdateFields", false);
+    setConfig(CONFIG_BOOL_CONVERT_UPDATE_FIELDS, "ConvertUpdateFields", false);
+    setConfig(CONFIG_BOOL_VALIDATE_SPELL_STACK_CACHE, "ValidateSpellStackCache", false);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
+    setConfig(CONFIG_UINT32_GRID_UNLOAD_TIME_BUDGET, "GridUnloadTimeBudget", 10);
 
     setConfig(CONFIG_UINT32_AUTOBROADCAST_INTERVAL, "AutoBroadcast", 600);
 
@@ -671,6 +678,10 @@ void World::LoadConfigSettings(bool reload)
 
     setConfigMin(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK, "MassMailer.SendPerTick", 10, 1);
 
+    setConfig(CONFIG_UINT32_TASK_BUDGET_OLD_MAILS, "TaskBudget.OldMails", 5);
+    setConfig(CONFIG_UINT32_TASK_BUDGET_OLD_CHARACTERS, "TaskBudget.OldCharacters", 5);
+    setConfig(CONFIG_UINT32_TASK_BUDGET_OLD_CORPSES, "TaskBudget.OldCorpses", 5);
+
     setConfig(CONFIG_UINT32_UPTIME_UPDATE, "UpdateUptimeInterval", 10);
     if (reload)
     {
@@ -705,6 +716,12 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY, "SaveRespawnTimeImmediately", true);
+    setConfig(CONFIG_UINT32_INTERVAL_RESPAWN_SAVE, "SaveRespawnTime.Interval", 10 * IN_MILLISECONDS);
+    if (reload)
+    {
+        m_timers[WUPDATE_RESPAWNS].SetInterval(getConfig(CONFIG_UINT32_INTERVAL_RESPAWN_SAVE));
+        m_timers[WUPDATE_RESPAWNS].Reset();
+    }
     setConfig(CONFIG_BOOL_WEATHER, "ActivateWeather", true);
 
     setConfig(CONFIG_BOOL_ALWAYS_MAX_SKILL_FOR_LEVEL, "AlwaysMaxSkillForLevel", false);
@@ -859,6 +876,7 @@ void World::LoadConfigSettings(bool reload)
 
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
     m_relocation_lower_limit_sq  = pow(sConfig.GetFloatDefault("Visibility.RelocationLowerLimit", 10), 2);
+    setConfig(CONFIG_BOOL_LAZY_SPLINE_RELOCATION, "Visibility.LazySplineRelocation", true);
 
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
     if (m_VisibleUnitGreyDistance >  MAX_VISIBILITY_DISTANCE)
@@ -961,6 +979,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
+    setConfig(CONFIG_BOOL_MAP_QUERY_CACHE, "vmap.enableQueryCache", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
     std::string ignoreSpellIds = sConfig.GetStringDefault("vmap.ignoreSpellIds", "");
@@ -1282,6 +1301,7 @@ void World::SetInitialWorldSettings()
     sObjectMgr.LoadPetNames();
 
     CharacterDatabaseCleaner::CleanDatabase();
+    UpdateFieldConverter::ConvertDatabase();
     sLog.outString();
 
     sLog.outString("Loading the max pet number...");
@@ -1466,6 +1486,9 @@ void World::SetInitialWorldSettings()
     // for AhBot
     m_timers[WUPDATE_AHBOT].SetInterval(20 * IN_MILLISECONDS); // every 20 sec
 
+    // batched respawn time writes
+    m_timers[WUPDATE_RESPAWNS].SetInterval(getConfig(CONFIG_UINT32_INTERVAL_RESPAWN_SAVE));
+
     // for AutoBroadcast
     sLog.outString("Starting AutoBroadcast System");
     if (m_broadcastEnable)
@@ -1743,6 +1766,9 @@ void World::Update(uint32 diff)
     ///-Update mass mailer tasks if any
     sMassMailMgr.Update();
 
+    ///- Next steps of long running tasks (expired mails, old characters, old corpses)
+    sWorldTaskMgr.Update();
+
     /// Handle daily quests reset time
     if (m_gameTime > m_NextDailyQuestReset)
     {
@@ -1772,6 +1798,7 @@ void World::Update(uint32 diff)
         sAuctionBot.Update();
         m_timers[WUPDATE_AHBOT].Reset();
     }
+    sAuctionBot.ApplyPlannedActions();
 
 #ifdef ENABLE_PLAYERBOTS
     sRandomPlayerbotMgr.UpdateAI(diff);
@@ -1797,6 +1824,13 @@ void World::Update(uint32 diff)
     sBattleGroundMgr.Update(diff);
     sOutdoorPvPMgr.Update(diff);
 
+    ///- Write respawn times changed by the map updates
+    if (m_timers[WUPDATE_RESPAWNS].Passed())
+    {
+        m_timers[WUPDATE_RESPAWNS].Reset();
+        sMapPersistentStateMgr.SaveRespawnTimes();
+    }
+
     ///- Used by Eluna
 #ifdef ENABLE_ELUNA
     if (Eluna* e = GetEluna())
@@ -1821,7 +1855,7 @@ void World::Update(uint32 diff)
     {
         m_timers[WUPDATE_CORPSES].Reset();
 
-        sObjectAccessor.RemoveOldCorpses();
+        sObjectAccessor.QueueRemoveOldCorpses();
     }
 
     ///- Process Game events when necessary
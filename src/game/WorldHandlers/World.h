@@ -82,6 +82,7 @@ enum WorldTimers
     WUPDATE_EVENTS,
     WUPDATE_DELETECHARS,
     WUPDATE_AHBOT,
+    WUPDATE_RESPAWNS,
     WUPDATE_COUNT
 };
 
@@ -91,8 +92,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_COMPRESSION = 0,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
+    CONFIG_UINT32_GRID_UNLOAD_TIME_BUDGET,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
+    CONFIG_UINT32_INTERVAL_RESPAWN_SAVE,
     CONFIG_UINT32_PORT_WORLD,
     CONFIG_UINT32_GAME_TYPE,
     CONFIG_UINT32_REALM_ZONE,
@@ -136,6 +139,9 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GROUP_VISIBILITY,
     CONFIG_UINT32_MAIL_DELIVERY_DELAY,
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
+    CONFIG_UINT32_TASK_BUDGET_OLD_MAILS,
+    CONFIG_UINT32_TASK_BUDGET_OLD_CHARACTERS,
+    CONFIG_UINT32_TASK_BUDGET_OLD_CORPSES,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_RATE_MINING_RARE,
@@ -358,7 +364,12 @@ enum eConfigBoolValues
     CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
+    CONFIG_BOOL_CLEAN_CHARACTER_DB_DRY_RUN,
+    CONFIG_BOOL_VALIDATE_SPELL_STACK_CACHE,
+    CONFIG_BOOL_COMPACT_UPDATE_FIELDS,
+    CONFIG_BOOL_CONVERT_UPDATE_FIELDS,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
+    CONFIG_BOOL_MAP_QUERY_CACHE,
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
     CONFIG_BOOL_MMAP_ENABLED,
     CONFIG_BOOL_PLAYER_COMMANDS,
@@ -385,6 +396,7 @@ enum eConfigBoolValues
     // Recommended Or New Flag
     CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW_ENABLED,
     CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW,
+    CONFIG_BOOL_LAZY_SPLINE_RELOCATION,
     CONFIG_BOOL_VALUE_COUNT
 };
 
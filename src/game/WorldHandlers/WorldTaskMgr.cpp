@@ -0,0 +1,106 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file WorldTaskMgr.cpp
+ * Time sliced processing of long running world thread jobs.
+ */
+
+#include "WorldTaskMgr.h"
+#include "Policies/Singleton.h"
+#include "Timer.h"
+#include "Log.h"
+
+INSTANTIATE_SINGLETON_1(WorldTaskMgr);
+
+WorldTaskMgr::~WorldTaskMgr()
+{
+    // not persistent, unfinished tasks are found again by their next run
+    for (WorldTaskList::iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+    {
+        delete *itr;
+    }
+}
+
+void WorldTaskMgr::Update()
+{
+    for (WorldTaskList::iterator itr = m_tasks.begin(); itr != m_tasks.end();)
+    {
+        WorldTask* task = *itr;
+
+        if (!task->m_updates && !task->Start())
+        {
+            DETAIL_LOG("WorldTaskMgr: %s, nothing to do", task->GetName());
+            delete task;
+            itr = m_tasks.erase(itr);
+            continue;
+        }
+
+        if (!task->m_updates)
+        {
+            sLog.outString("WorldTaskMgr: %s started, %u items", task->GetName(), task->GetTotal());
+        }
+
+        // at least one step per update, the task must always progress
+        uint32 startTime = getMSTime();
+        bool finished = false;
+        do
+        {
+            if (!task->Step())
+            {
+                finished = true;
+                break;
+            }
+            ++task->m_done;
+        }
+        while (!task->m_budget || GetMSTimeDiffToNow(startTime) < task->m_budget);
+
+        ++task->m_updates;
+        task->m_time += GetMSTimeDiffToNow(startTime);
+
+        if (!finished)
+        {
+            DEBUG_LOG("WorldTaskMgr: %s, %u/%u items done", task->GetName(), task->GetDone(), task->GetTotal());
+            ++itr;
+            continue;
+        }
+
+        sLog.outString("WorldTaskMgr: %s finished, %u items in %u updates (%u ms)", task->GetName(), task->GetDone(), task->m_updates, task->m_time);
+        delete task;
+        itr = m_tasks.erase(itr);
+    }
+}
+
+void WorldTaskMgr::GetStatistic(uint32& tasks, uint32& done, uint32& total) const
+{
+    tasks = m_tasks.size();
+    done = 0;
+    total = 0;
+
+    for (WorldTaskList::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+    {
+        done += (*itr)->GetDone();
+        total += (*itr)->GetTotal();
+    }
+}
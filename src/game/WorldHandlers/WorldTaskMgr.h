@@ -0,0 +1,119 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file WorldTaskMgr.h
+ * Long running world thread jobs (expired mails, old characters, old corpses), processed a few items
+ * per world update so they never stall a single update for long.
+ */
+
+#ifndef MANGOS_WORLD_TASK_MGR_H
+#define MANGOS_WORLD_TASK_MGR_H
+
+#include "Common.h"
+
+#include <list>
+
+/**
+ * A resumable job, WorldTaskMgr calls Step() until the per update time budget is used.
+ */
+class WorldTask
+{
+        friend class WorldTaskMgr;
+
+    public:
+        /**
+         * @param name      name used in the progress log
+         * @param budget    time (ms) the task may use per world update, 0 to finish it in one update
+         */
+        WorldTask(char const* name, uint32 budget)
+            : m_name(name), m_budget(budget), m_total(0), m_done(0), m_updates(0), m_time(0) {}
+        virtual ~WorldTask() {}
+
+        char const* GetName() const { return m_name; }
+        uint32 GetTotal() const { return m_total; }
+        uint32 GetDone() const { return m_done; }
+
+    protected:
+        /**
+         * Called once before the first step, e.g. to select the items to process.
+         *
+         * @returns false if there is nothing to do
+         */
+        virtual bool Start() = 0;
+
+        /**
+         * Process the next item.
+         *
+         * @returns false if no item was left
+         */
+        virtual bool Step() = 0;
+
+        /// number of items Start() found, for progress reporting (0 if unknown)
+        void SetTotal(uint32 total) { m_total = total; }
+
+    private:
+        char const* m_name;
+        uint32 m_budget;
+        uint32 m_total;
+        uint32 m_done;
+        uint32 m_updates;                                   // world updates the task ran in
+        uint32 m_time;                                      // ms spent in Step()
+};
+
+/**
+ * Runs the queued WorldTasks on the world thread, each within its own time budget per update.
+ */
+class WorldTaskMgr
+{
+    public:
+        WorldTaskMgr() {}
+        ~WorldTaskMgr();
+
+        /**
+         * Queue a task, it is started in the next Update().
+         *
+         * @param task  owned by the manager from now on
+         */
+        void AddTask(WorldTask* task) { m_tasks.push_back(task); }
+
+        /**
+         * Next step of all queued tasks, called every world update.
+         */
+        void Update();
+
+        /**
+         * Progress of the queued tasks, for GM commands.
+         */
+        void GetStatistic(uint32& tasks, uint32& done, uint32& total) const;
+
+    private:
+        typedef std::list<WorldTask*> WorldTaskList;
+
+        WorldTaskList m_tasks;
+};
+
+#define sWorldTaskMgr MaNGOS::Singleton<WorldTaskMgr>::Instance()
+
+#endif
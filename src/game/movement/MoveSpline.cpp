@@ -24,6 +24,7 @@
 
 #include "MoveSpline.h"
 #include <sstream>
+#include <algorithm>
 #include "Log.h"
 #include "Unit.h"
 
@@ -298,6 +299,48 @@ namespace Movement
         time_passed = Duration();
     }
 
+    int32 MoveSpline::timeToLeaveBox(float minX, float minY, float maxX, float maxY) const
+    {
+        for (int32 i = point_Idx; i < spline.last(); ++i)
+        {
+            const Vector3& from = spline.getPoint(i);
+            const Vector3& to = spline.getPoint(i + 1);
+
+            if (from.x < minX || from.x > maxX || from.y < minY || from.y > maxY)
+            {
+                return spline.length(i);
+            }
+
+            if (to.x >= minX && to.x <= maxX && to.y >= minY && to.y <= maxY)
+            {
+                continue;
+            }
+
+            // fraction of the segment at which the first border is crossed
+            float u = 1.f;
+            if (to.x < minX)
+            {
+                u = std::min(u, (minX - from.x) / (to.x - from.x));
+            }
+            else if (to.x > maxX)
+            {
+                u = std::min(u, (maxX - from.x) / (to.x - from.x));
+            }
+            if (to.y < minY)
+            {
+                u = std::min(u, (minY - from.y) / (to.y - from.y));
+            }
+            else if (to.y > maxY)
+            {
+                u = std::min(u, (maxY - from.y) / (to.y - from.y));
+            }
+
+            return spline.length(i) + int32(u * spline.length(i, i + 1));
+        }
+
+        return Duration();
+    }
+
     int32 MoveSpline::currentPathIdx() const
     {
         int32 point = point_Idx_offset + point_Idx - spline.first() + (int)Finalized();
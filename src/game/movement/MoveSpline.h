@@ -298,6 +298,20 @@ namespace Movement
              */
             int32 Duration() const { return spline.length();}
 
+            /**
+             * @brief time passed at which the path may first leave the box, Duration() if it stays inside
+             *
+             * The straight lines between the path points are checked, a smooth (catmullrom) path can
+             * bulge slightly out of them.
+             *
+             * @param minX
+             * @param minY
+             * @param maxX
+             * @param maxY
+             * @return int32
+             */
+            int32 timeToLeaveBox(float minX, float minY, float maxX, float maxY) const;
+
             /**
              * @brief
              *
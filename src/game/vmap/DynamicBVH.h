@@ -0,0 +1,640 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_DYNAMIC_BVH
+#define MANGOS_H_DYNAMIC_BVH
+
+#include <G3D/Ray.h>
+#include <G3D/AABox.h>
+#include <G3D/Table.h>
+#include <G3D/BoundsTrait.h>
+
+#include "Errors.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+using G3D::Vector3;
+using G3D::AABox;
+using G3D::Ray;
+
+template<class T, class BoundsFunc = BoundsTrait<T> >
+/**
+ * @brief incrementally maintained bounding volume hierarchy
+ *
+ * Leaves hold one object each with its bounds enlarged by a margin, so small
+ * movements don't touch the tree at all. Insert, remove and relocate are
+ * O(log n): a leaf is placed next to the sibling with the lowest surface
+ * area cost and its ancestors are refitted and rotated to keep the tree
+ * height balanced. Repeated edits still make the tree worse than a fresh
+ * build, rebuild() restores it and IsDegraded() tells when that's worth it.
+ */
+class DynamicBVH
+{
+    public:
+        enum
+        {
+            NULL_NODE       = -1,
+            MAX_STACK_SIZE  = 128                           // AVL height of 2^64 leaves is below 93
+        };
+
+        /**
+         * @brief
+         *
+         * @param margin added to each side of the leaf bounds
+         */
+        explicit DynamicBVH(float margin = 0.5f) :
+            m_root(NULL_NODE), m_freeList(NULL_NODE), m_margin(margin), m_builtCost(0.0f)
+        {
+        }
+
+        /**
+         * @brief
+         *
+         * @param obj
+         */
+        void insert(const T& obj)
+        {
+            int32 leaf = allocateNode();
+            m_nodes[leaf].object = &obj;
+            m_nodes[leaf].bounds = fatBounds(obj);
+            m_nodes[leaf].height = 0;
+            m_leaves.set(&obj, leaf);
+            insertLeaf(leaf);
+        }
+
+        /**
+         * @brief
+         *
+         * @param obj
+         */
+        void remove(const T& obj)
+        {
+            int32 leaf;
+            if (!m_leaves.get(&obj, leaf))
+            {
+                return;
+            }
+
+            m_leaves.remove(&obj);
+            removeLeaf(leaf);
+            freeNode(leaf);
+        }
+
+        /**
+         * @brief refit after the bounds of obj changed
+         *
+         * @param obj
+         * @return bool false if the new bounds still fit in the leaf
+         */
+        bool relocate(const T& obj)
+        {
+            int32 leaf;
+            if (!m_leaves.get(&obj, leaf))
+            {
+                return false;
+            }
+
+            AABox bounds;
+            BoundsFunc::getBounds(obj, bounds);
+            if (m_nodes[leaf].bounds.contains(bounds))
+            {
+                return false;
+            }
+
+            removeLeaf(leaf);
+            m_nodes[leaf].bounds = fatBounds(obj);
+            insertLeaf(leaf);
+            return true;
+        }
+
+        /**
+         * @brief
+         *
+         * @param obj
+         * @return bool
+         */
+        bool contains(const T& obj) const { return m_leaves.containsKey(&obj); }
+        /**
+         * @brief
+         *
+         * @return int
+         */
+        int size() const { return m_leaves.size(); }
+
+        /**
+         * @brief surface area heuristic of the tree, relative to the root bounds
+         *
+         * Sum of the internal node areas divided by the root area: the expected
+         * amount of internal nodes a random ray through the root has to visit.
+         *
+         * @return float
+         */
+        float cost() const
+        {
+            if (m_root == NULL_NODE || m_nodes[m_root].isLeaf())
+            {
+                return 0.0f;
+            }
+
+            float rootArea = surfaceArea(m_nodes[m_root].bounds);
+            if (rootArea <= 0.0f)
+            {
+                return 0.0f;
+            }
+
+            float area = 0.0f;
+            for (size_t i = 0; i < m_nodes.size(); ++i)
+            {
+                Node const& node = m_nodes[i];
+                if (node.height > 0)                        // free nodes have negative height
+                {
+                    area += surfaceArea(node.bounds);
+                }
+            }
+
+            return area / rootArea;
+        }
+
+        /**
+         * @brief
+         *
+         * @param factor
+         * @return bool true if cost() grew more than factor times since the last rebuild()
+         */
+        bool IsDegraded(float factor) const { return cost() > m_builtCost * factor; }
+
+        /**
+         * @brief top-down rebuild of all internal nodes, leaves keep their indexes
+         *
+         */
+        void rebuild()
+        {
+            std::vector<int32> leaves;
+            leaves.reserve(size());
+            for (size_t i = 0; i < m_nodes.size(); ++i)
+            {
+                if (m_nodes[i].height == 0)
+                {
+                    leaves.push_back(int32(i));
+                }
+                else if (m_nodes[i].height > 0)
+                {
+                    freeNode(int32(i));
+                }
+            }
+
+            m_root = leaves.empty() ? int32(NULL_NODE) : build(&leaves[0], &leaves[0] + leaves.size());
+            if (m_root != NULL_NODE)
+            {
+                m_nodes[m_root].parent = NULL_NODE;
+            }
+
+            m_builtCost = cost();
+        }
+
+        template<typename RayCallback>
+        /**
+         * @brief calls intersectCallback(ray, object, maxDist) for objects whose bounds
+         *        the ray enters within maxDist, nearer subtrees first. Stops as soon
+         *        as the callback returns true.
+         *
+         * @param ray
+         * @param intersectCallback
+         * @param maxDist
+         */
+        void intersectRay(const Ray& ray, RayCallback& intersectCallback, float& maxDist) const
+        {
+            if (m_root == NULL_NODE)
+            {
+                return;
+            }
+
+            Vector3 const& org = ray.origin();
+            Vector3 const& dir = ray.direction();
+            Vector3 const& invDir = ray.invDirection();
+
+            float enter;
+            if (!intersectBounds(m_nodes[m_root].bounds, org, dir, invDir, maxDist, enter))
+            {
+                return;
+            }
+
+            int32 stack[MAX_STACK_SIZE];
+            int32 stackSize = 0;
+            stack[stackSize++] = m_root;
+
+            while (stackSize)
+            {
+                Node const& node = m_nodes[stack[--stackSize]];
+
+                if (node.isLeaf())
+                {
+                    if (intersectCallback(ray, *node.object, maxDist))
+                    {
+                        return;
+                    }
+                    continue;
+                }
+
+                float enter1, enter2;
+                bool hit1 = intersectBounds(m_nodes[node.child1].bounds, org, dir, invDir, maxDist, enter1);
+                bool hit2 = intersectBounds(m_nodes[node.child2].bounds, org, dir, invDir, maxDist, enter2);
+
+                MANGOS_ASSERT(stackSize + 2 <= MAX_STACK_SIZE);
+                if (hit1 && hit2)
+                {
+                    // far child below the near one on the stack
+                    bool firstIsNear = enter1 <= enter2;
+                    stack[stackSize++] = firstIsNear ? node.child2 : node.child1;
+                    stack[stackSize++] = firstIsNear ? node.child1 : node.child2;
+                }
+                else if (hit1)
+                {
+                    stack[stackSize++] = node.child1;
+                }
+                else if (hit2)
+                {
+                    stack[stackSize++] = node.child2;
+                }
+            }
+        }
+
+    private:
+        /**
+         * @brief
+         *
+         */
+        struct Node
+        {
+            AABox bounds; /**< fat bounds for leaves, union of children otherwise */
+            const T* object; /**< TODO */
+            int32 parent; /**< next free node while in the free list */
+            int32 child1; /**< TODO */
+            int32 child2; /**< TODO */
+            int32 height; /**< 0 for leaves, -1 for free nodes */
+
+            bool isLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        static float surfaceArea(const AABox& box)
+        {
+            Vector3 e = box.high() - box.low();
+            return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+        }
+
+        static AABox merge(const AABox& a, const AABox& b)
+        {
+            return AABox(a.low().min(b.low()), a.high().max(b.high()));
+        }
+
+        // slab test, enter is the distance at which the ray enters the box
+        static bool intersectBounds(const AABox& box, const Vector3& org, const Vector3& dir, const Vector3& invDir, float maxDist, float& enter)
+        {
+            float tMin = 0.0f;
+            float tMax = maxDist;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                if (dir[axis] == 0.0f)
+                {
+                    // parallel to the slab, avoids inf * 0
+                    if (org[axis] < box.low()[axis] || org[axis] > box.high()[axis])
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+
+                float t1 = (box.low()[axis] - org[axis]) * invDir[axis];
+                float t2 = (box.high()[axis] - org[axis]) * invDir[axis];
+                if (t1 > t2)
+                {
+                    std::swap(t1, t2);
+                }
+
+                tMin = std::max(tMin, t1);
+                tMax = std::min(tMax, t2);
+                if (tMin > tMax)
+                {
+                    return false;
+                }
+            }
+
+            enter = tMin;
+            return true;
+        }
+
+        AABox fatBounds(const T& obj) const
+        {
+            AABox bounds;
+            BoundsFunc::getBounds(obj, bounds);
+            Vector3 margin(m_margin, m_margin, m_margin);
+            return AABox(bounds.low() - margin, bounds.high() + margin);
+        }
+
+        int32 allocateNode()
+        {
+            int32 index;
+            if (m_freeList != NULL_NODE)
+            {
+                index = m_freeList;
+                m_freeList = m_nodes[index].parent;
+            }
+            else
+            {
+                index = int32(m_nodes.size());
+                m_nodes.push_back(Node());
+            }
+
+            Node& node = m_nodes[index];
+            node.object = NULL;
+            node.parent = NULL_NODE;
+            node.child1 = NULL_NODE;
+            node.child2 = NULL_NODE;
+            node.height = 0;
+            return index;
+        }
+
+        void freeNode(int32 index)
+        {
+            m_nodes[index].parent = m_freeList;
+            m_nodes[index].height = -1;
+            m_freeList = index;
+        }
+
+        void insertLeaf(int32 leaf)
+        {
+            if (m_root == NULL_NODE)
+            {
+                m_root = leaf;
+                m_nodes[leaf].parent = NULL_NODE;
+                return;
+            }
+
+            // descend to the sibling with the lowest increase of the surface area
+            AABox const leafBounds = m_nodes[leaf].bounds;
+            int32 index = m_root;
+            while (!m_nodes[index].isLeaf())
+            {
+                Node const& node = m_nodes[index];
+
+                float area = surfaceArea(node.bounds);
+                float combinedArea = surfaceArea(merge(node.bounds, leafBounds));
+
+                // cost of a new parent for this node and the leaf
+                float cost = 2.0f * combinedArea;
+                // minimum cost of pushing the leaf further down
+                float inheritanceCost = 2.0f * (combinedArea - area);
+
+                float cost1 = descendCost(node.child1, leafBounds) + inheritanceCost;
+                float cost2 = descendCost(node.child2, leafBounds) + inheritanceCost;
+
+                if (cost < cost1 && cost < cost2)
+                {
+                    break;
+                }
+
+                index = cost1 < cost2 ? node.child1 : node.child2;
+            }
+
+            int32 sibling = index;
+            int32 oldParent = m_nodes[sibling].parent;
+            int32 newParent = allocateNode();
+            m_nodes[newParent].parent = oldParent;
+            m_nodes[newParent].bounds = merge(leafBounds, m_nodes[sibling].bounds);
+            m_nodes[newParent].height = m_nodes[sibling].height + 1;
+            m_nodes[newParent].child1 = sibling;
+            m_nodes[newParent].child2 = leaf;
+            m_nodes[sibling].parent = newParent;
+            m_nodes[leaf].parent = newParent;
+
+            if (oldParent == NULL_NODE)
+            {
+                m_root = newParent;
+            }
+            else if (m_nodes[oldParent].child1 == sibling)
+            {
+                m_nodes[oldParent].child1 = newParent;
+            }
+            else
+            {
+                m_nodes[oldParent].child2 = newParent;
+            }
+
+            refit(m_nodes[leaf].parent);
+        }
+
+        float descendCost(int32 child, const AABox& leafBounds) const
+        {
+            Node const& node = m_nodes[child];
+            float combinedArea = surfaceArea(merge(node.bounds, leafBounds));
+            return node.isLeaf() ? combinedArea : combinedArea - surfaceArea(node.bounds);
+        }
+
+        void removeLeaf(int32 leaf)
+        {
+            if (leaf == m_root)
+            {
+                m_root = NULL_NODE;
+                return;
+            }
+
+            int32 parent = m_nodes[leaf].parent;
+            int32 grandParent = m_nodes[parent].parent;
+            int32 sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+            if (grandParent == NULL_NODE)
+            {
+                m_root = sibling;
+                m_nodes[sibling].parent = NULL_NODE;
+                freeNode(parent);
+                return;
+            }
+
+            // replace the parent with the sibling
+            if (m_nodes[grandParent].child1 == parent)
+            {
+                m_nodes[grandParent].child1 = sibling;
+            }
+            else
+            {
+                m_nodes[grandParent].child2 = sibling;
+            }
+            m_nodes[sibling].parent = grandParent;
+            freeNode(parent);
+
+            refit(grandParent);
+        }
+
+        // walks up from index, rebalancing and recomputing bounds and heights
+        void refit(int32 index)
+        {
+            while (index != NULL_NODE)
+            {
+                index = rotate(index);
+
+                Node& node = m_nodes[index];
+                node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+                node.bounds = merge(m_nodes[node.child1].bounds, m_nodes[node.child2].bounds);
+
+                index = node.parent;
+            }
+        }
+
+        // AVL style rotation when the children heights differ by more than one, returns the new subtree root
+        int32 rotate(int32 iA)
+        {
+            Node& A = m_nodes[iA];
+            if (A.isLeaf() || A.height < 2)
+            {
+                return iA;
+            }
+
+            int32 iB = A.child1;
+            int32 iC = A.child2;
+            int32 balance = m_nodes[iC].height - m_nodes[iB].height;
+
+            if (balance > 1)
+            {
+                return rotateUp(iA, iC, iB);
+            }
+
+            if (balance < -1)
+            {
+                return rotateUp(iA, iB, iC);
+            }
+
+            return iA;
+        }
+
+        // promotes the taller child iUp of iA, iA takes the place of iUp's shorter child
+        int32 rotateUp(int32 iA, int32 iUp, int32 iOther)
+        {
+            Node& A = m_nodes[iA];
+            Node& up = m_nodes[iUp];
+
+            int32 iF = up.child1;
+            int32 iG = up.child2;
+
+            // swap A and up
+            up.child1 = iA;
+            up.parent = A.parent;
+            A.parent = iUp;
+
+            if (up.parent == NULL_NODE)
+            {
+                m_root = iUp;
+            }
+            else if (m_nodes[up.parent].child1 == iA)
+            {
+                m_nodes[up.parent].child1 = iUp;
+            }
+            else
+            {
+                m_nodes[up.parent].child2 = iUp;
+            }
+
+            // the taller grandchild stays under up, the other one replaces up under A
+            int32 iKeep = m_nodes[iF].height > m_nodes[iG].height ? iF : iG;
+            int32 iMove = iKeep == iF ? iG : iF;
+
+            up.child2 = iKeep;
+            if (A.child1 == iUp)
+            {
+                A.child1 = iMove;
+            }
+            else
+            {
+                A.child2 = iMove;
+            }
+            m_nodes[iMove].parent = iA;
+
+            A.bounds = merge(m_nodes[iOther].bounds, m_nodes[iMove].bounds);
+            A.height = 1 + std::max(m_nodes[iOther].height, m_nodes[iMove].height);
+            up.bounds = merge(A.bounds, m_nodes[iKeep].bounds);
+            up.height = 1 + std::max(A.height, m_nodes[iKeep].height);
+
+            return iUp;
+        }
+
+        // median split along the longest axis of the leaf centers
+        int32 build(int32* begin, int32* end)
+        {
+            if (end - begin == 1)
+            {
+                return *begin;
+            }
+
+            Vector3 lo = m_nodes[*begin].bounds.center();
+            Vector3 hi = lo;
+            for (int32* itr = begin + 1; itr != end; ++itr)
+            {
+                Vector3 center = m_nodes[*itr].bounds.center();
+                lo = lo.min(center);
+                hi = hi.max(center);
+            }
+
+            Vector3 extent = hi - lo;
+            int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+            int32* mid = begin + (end - begin) / 2;
+            std::nth_element(begin, mid, end, CenterLess(m_nodes, axis));
+
+            int32 child1 = build(begin, mid);
+            int32 child2 = build(mid, end);
+
+            int32 index = allocateNode();
+            Node& node = m_nodes[index];
+            node.child1 = child1;
+            node.child2 = child2;
+            node.bounds = merge(m_nodes[child1].bounds, m_nodes[child2].bounds);
+            node.height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+            m_nodes[child1].parent = index;
+            m_nodes[child2].parent = index;
+            return index;
+        }
+
+        struct CenterLess
+        {
+            CenterLess(std::vector<Node> const& nodes, int axis) : m_nodes(nodes), m_axis(axis) {}
+
+            bool operator()(int32 a, int32 b) const
+            {
+                return m_nodes[a].bounds.center()[m_axis] < m_nodes[b].bounds.center()[m_axis];
+            }
+
+            std::vector<Node> const& m_nodes;
+            int m_axis;
+        };
+
+        std::vector<Node> m_nodes; /**< leaves, internal and free nodes */
+        G3D::Table<const T*, int32> m_leaves; /**< leaf node of each object */
+        int32 m_root; /**< TODO */
+        int32 m_freeList; /**< TODO */
+        float m_margin; /**< TODO */
+        float m_builtCost; /**< cost() after the last rebuild() */
+};
+
+#endif
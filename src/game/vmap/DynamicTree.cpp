@@ -25,20 +25,9 @@
 #include "DynamicTree.h"
 #include "Log.h"
 #include "Timer.h"
-#include "BIHWrap.h"
-#include "RegularGrid.h"
+#include "DynamicBVH.h"
 #include "GameObjectModel.h"
 
-template<> struct HashTrait< GameObjectModel>
-{
-    static size_t hashCode(const GameObjectModel& g) { return (size_t)(void*)&g; }
-};
-
-template<> struct PositionTrait< GameObjectModel>
-{
-    static void getPosition(const GameObjectModel& g, Vector3& p) { p = g.GetPosition(); }
-};
-
 template<> struct BoundsTrait< GameObjectModel>
 {
     static void getBounds(const GameObjectModel& g, G3D::AABox& out) { out = g.GetBounds();}
@@ -46,10 +35,11 @@ template<> struct BoundsTrait< GameObjectModel>
 };
 
 
-//int UNBALANCED_TIMES_LIMIT = 5;
 int CHECK_TREE_PERIOD = 200;
+// full rebuild once incremental edits made the tree this much more expensive to traverse
+float REBUILD_COST_FACTOR = 1.5f;
 
-typedef RegularGrid2D<GameObjectModel, BIHWrap<GameObjectModel> > ParentTree;
+typedef DynamicBVH<GameObjectModel> ParentTree;
 
 struct DynTreeImpl : public ParentTree/*, public Intersectable*/
 {
@@ -57,29 +47,16 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
     typedef ParentTree base;
 
     DynTreeImpl() :
-        rebalance_timer(CHECK_TREE_PERIOD),
-        unbalanced_times(0)
-    {
-    }
-
-    void insert(const Model& mdl)
+        rebalance_timer(CHECK_TREE_PERIOD)
     {
-        base::insert(mdl);
-        ++unbalanced_times;
-    }
-
-    void remove(const Model& mdl)
-    {
-        base::remove(mdl);
-        ++unbalanced_times;
     }
 
     void balance()
     {
-        base::balance();
-        unbalanced_times = 0;
+        base::rebuild();
     }
 
+    // insert, remove and relocate keep the tree valid, this only restores its quality
     void update(uint32 difftime)
     {
         if (!size())
@@ -91,15 +68,20 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         if (rebalance_timer.Passed())
         {
             rebalance_timer.Reset(CHECK_TREE_PERIOD);
-            if (unbalanced_times > 0)
+            if (IsDegraded(REBUILD_COST_FACTOR))
             {
                 balance();
             }
         }
     }
 
+    template<typename RayCallback>
+    void intersectZAllignedRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& max_dist) const
+    {
+        intersectRay(ray, intersectCallback, max_dist);
+    }
+
     TimeTracker rebalance_timer;
-    int unbalanced_times;
 };
 
 DynamicMapTree::DynamicMapTree() : impl(*new DynTreeImpl())
@@ -121,6 +103,11 @@ void DynamicMapTree::remove(const GameObjectModel& mdl)
     impl.remove(mdl);
 }
 
+void DynamicMapTree::relocate(const GameObjectModel& mdl)
+{
+    impl.relocate(mdl);
+}
+
 bool DynamicMapTree::contains(const GameObjectModel& mdl) const
 {
     return impl.contains(mdl);
@@ -184,7 +171,7 @@ bool DynamicMapTree::getIntersectionTime(const G3D::Ray& ray, const Vector3& end
 {
     float distance = pMaxDist;
     DynamicTreeIntersectionCallback callback;
-    impl.intersectRay(ray, callback, distance, endPos);
+    impl.intersectRay(ray, callback, distance);
     if (callback.didHit())
     {
         pMaxDist = distance;
@@ -266,7 +253,7 @@ bool DynamicMapTree::isInLineOfSight(float x1, float y1, float z1, float x2, flo
 
     G3D::Ray r(v1, (v2 - v1) / maxDist);
     DynamicTreeIntersectionCallback callback;
-    impl.intersectRay(r, callback, maxDist, v2);
+    impl.intersectRay(r, callback, maxDist);
 
     return !callback.did_hit;
 }
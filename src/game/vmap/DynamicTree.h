@@ -124,6 +124,12 @@ class DynamicMapTree
          * @param
          */
         void remove(const GameObjectModel&);
+        /**
+         * @brief refit a model whose bounds changed (rotation) while in the tree
+         *
+         * @param
+         */
+        void relocate(const GameObjectModel&);
         /**
          * @brief
          *
@@ -139,7 +145,7 @@ class DynamicMapTree
         int size() const;
 
         /**
-         * @brief
+         * @brief full rebuild, update() does it on its own once the tree degraded
          *
          */
         void balance();
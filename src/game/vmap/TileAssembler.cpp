@@ -30,6 +30,12 @@
 #include <set>
 #include <iomanip>
 #include <sstream>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <cstdlib>
+#include <algorithm>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -44,6 +50,54 @@ template<> struct BoundsTrait<VMAP::ModelSpawn*>
 
 namespace VMAP
 {
+    static const uint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static const uint64 FNV_PRIME = 1099511628211ULL;
+    static const char VMAP_MANIFEST[] = "vmap_manifest"; /**< input hashes of the last run, next to the output */
+
+    /**
+     * @brief Continues a FNV-1a hash over a block of bytes.
+     *
+     * @param hash The hash to continue from.
+     * @param data The bytes to hash.
+     * @param len The number of bytes.
+     * @return uint64 The new hash.
+     */
+    static uint64 hashBytes(uint64 hash, const void* data, size_t len)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < len; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Start hash of every manifest entry, outputs of another format version never match.
+     */
+    static uint64 hashSeed(const char* RAW_VMAP_MAGIC)
+    {
+        uint64 hash = hashBytes(FNV_OFFSET_BASIS, VMAP_MAGIC, 8);
+        return hashBytes(hash, RAW_VMAP_MAGIC, 8);
+    }
+
+    /**
+     * @brief Hashes the placement data of a model spawn as read from dir_bin.
+     */
+    static uint64 hashSpawn(uint64 hash, const ModelSpawn& spawn)
+    {
+        hash = hashBytes(hash, &spawn.flags, sizeof(spawn.flags));
+        hash = hashBytes(hash, &spawn.adtId, sizeof(spawn.adtId));
+        hash = hashBytes(hash, &spawn.ID, sizeof(spawn.ID));
+        hash = hashBytes(hash, &spawn.iPos, sizeof(spawn.iPos));
+        hash = hashBytes(hash, &spawn.iRot, sizeof(spawn.iRot));
+        hash = hashBytes(hash, &spawn.iScale, sizeof(spawn.iScale));
+        hash = hashBytes(hash, &spawn.iBound.low(), sizeof(Vector3));
+        hash = hashBytes(hash, &spawn.iBound.high(), sizeof(Vector3));
+        return hashBytes(hash, spawn.name.data(), spawn.name.size());
+    }
+
     /**
      * @brief Reads a chunk of data from a file and compares it with a given string.
      *
@@ -89,6 +143,8 @@ namespace VMAP
         iFilterMethod = NULL;
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
+        iThreadCount = 0;
+        iIncremental = true;
         // mkdir(iDestDir);
         // init();
     }
@@ -103,6 +159,11 @@ namespace VMAP
 
     /**
      * @brief Converts the world data to a different format.
+     *
+     * Maps and model files are independent of each other and converted on
+     * iThreadCount workers, every job writes its own output files so the
+     * result does not depend on scheduling. With iIncremental set, jobs whose
+     * input hash matches the manifest of the previous run are skipped.
      */
     bool TileAssembler::convertWorld2(const char *RAW_VMAP_MAGIC)
     {
@@ -112,162 +173,455 @@ namespace VMAP
             return false;
         }
 
+        if (iIncremental)
+        {
+            readManifest();
+        }
+
         // Export map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        std::vector<MapData::iterator> maps;
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            maps.push_back(map_iter);
+        }
+
+        std::vector<std::set<std::string> > mapModelFiles(maps.size());
+        success = runParallel(maps.size(), [&](size_t i)
+        {
+            return exportMap(maps[i]->first, *maps[i]->second, mapModelFiles[i], RAW_VMAP_MAGIC);
+        });
+
+        for (size_t i = 0; i < mapModelFiles.size(); ++i)
         {
-            // Build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
+            spawnedModelFiles.insert(mapModelFiles[i].begin(), mapModelFiles[i].end());
+        }
+
+        // Add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels(RAW_VMAP_MAGIC);
 
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
+        // Export objects
+        if (success)
+        {
+            std::cout << "\nConverting Model Files" << std::endl;
+
+            std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+            std::atomic<uint32> skipped(0);
+            success = runParallel(modelFiles.size(), [&](size_t i)
             {
-                // M2 models don't have a bound set in WDT/ADT placement data, I still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
+                std::string const& modelFile = modelFiles[i];
+                std::string const key = "model:" + modelFile;
+                uint64 hash = hashFile(modelFile, hashSeed(RAW_VMAP_MAGIC));
+                if (isUpToDate(key, hash, std::vector<std::string>(1, iDestDir + "/" + modelFile + ".vmo")))
                 {
-                    if (!calculateTransformedBound(entry->second, RAW_VMAP_MAGIC))
-                    {
-                        break;
-                    }
+                    ++skipped;
+                    return true;
                 }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
+
+                printf("Converting %s\n", modelFile.c_str());
+                if (!convertRawFile(modelFile, RAW_VMAP_MAGIC))
                 {
-                    // TODO: remove extractor hack and uncomment below line:
-                    // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
+                    printf("error converting %s\n", modelFile.c_str());
+                    return false;
                 }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
+
+                setManifestEntry(key, hash);
+                return true;
+            });
+
+            if (skipped)
+            {
+                printf("%u unchanged model files skipped\n", uint32(skipped));
             }
+        }
 
-            printf("Creating map tree...\n");
-            BIH pTree;
-            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        // only record what was written, a failed run is redone next time
+        if (iIncremental && !writeManifest())
+        {
+            success = false;
+        }
+
+        // Cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i = 0; i < mapSpawns.size(); ++i)
+    /**
+     * @brief Writes the map tree and tile files of one map.
+     *
+     * @param mapId The map ID.
+     * @param spawns The model spawns of the map.
+     * @param modelFiles Receives the names of the models spawned on the map.
+     * @return bool True if successful, false otherwise.
+     */
+    bool TileAssembler::exportMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles, const char *RAW_VMAP_MAGIC)
+    {
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+
+        // the tree and tiles only depend on the spawns and on the geometry of M2 models (bounds)
+        std::stringstream mapkey;
+        mapkey << "map:" << std::setfill('0') << std::setw(3) << mapId;
+        uint64 hash = hashSeed(RAW_VMAP_MAGIC);
+        for (UniqueEntryMap::const_iterator entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            hash = hashSpawn(hash, entry->second);
+            if (entry->second.flags & MOD_M2)
             {
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+                hash = hashFile(entry->second.name, hash);
             }
+            modelFiles.insert(entry->second.name);
+        }
+        for (TileMap::const_iterator tile = spawns.TileEntries.begin(); tile != spawns.TileEntries.end(); ++tile)
+        {
+            hash = hashBytes(hash, &tile->first, sizeof(tile->first));
+            hash = hashBytes(hash, &tile->second, sizeof(tile->second));
+        }
 
-            // Write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        // the tree and every tile file of the map have to be there to skip it
+        std::vector<std::string> outputFiles(1, mapfilename.str());
+        std::set<uint32> tileIds;
+        for (TileMap::const_iterator tile = spawns.TileEntries.begin(); tile != spawns.TileEntries.end(); ++tile)
+        {
+            if (!(spawns.UniqueEntries[tile->second].flags & MOD_WORLDSPAWN) && tileIds.insert(tile->first).second)
             {
-                success = false;
-                printf("Can not open %s\n", mapfilename.str().c_str());
-                break;
+                outputFiles.push_back(getTileFileName(mapId, tile->first));
             }
+        }
 
-            // General info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8)
+        if (isUpToDate(mapkey.str(), hash, outputFiles))
+        {
+            printf("Map %u unchanged, skipped\n", mapId);
+            return true;
+        }
+
+        // Build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+
+        printf("Calculating model bounds for map %u...\n", mapId);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, I still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                success = false;
+                if (!calculateTransformedBound(entry->second, RAW_VMAP_MAGIC))
+                {
+                    break;
+                }
             }
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // Only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = false;
+                // TODO: remove extractor hack and uncomment below line:
+                // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
             }
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1)
+            mapSpawns.push_back(&(entry->second));
+        }
+
+        printf("Creating map tree for map %u...\n", mapId);
+        BIH pTree;
+        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i = 0; i < mapSpawns.size(); ++i)
+        {
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        }
+
+        // Write map tree file
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Can not open %s\n", mapfilename.str().c_str());
+            return false;
+        }
+
+        bool success = true;
+
+        // General info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8)
+        {
+            success = false;
+        }
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // Only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1)
+        {
+            success = false;
+        }
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1)
+        {
+            success = false;
+        }
+        if (success)
+        {
+            success = pTree.WriteToFile(mapfile);
+        }
+        // Global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1)
+        {
+            success = false;
+        }
+
+        for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+        {
+            success = ModelSpawn::WriteToFile(mapfile, spawns.UniqueEntries[glob->second]);
+        }
+
+        fclose(mapfile);
+
+        // <====
+
+        // Write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap& tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn& spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN)               // WDT spawn, saved as tile 65/65 currently...
             {
-                success = false;
+                continue;
             }
-            if (success)
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::string tilefilename = getTileFileName(mapId, tile->first);
+            FILE* tilefile = fopen(tilefilename.c_str(), "wb");
+            if (!tilefile)
             {
-                success = pTree.WriteToFile(mapfile);
+                printf("Can not open %s\n", tilefilename.c_str());
+                return false;
             }
-            // Global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1)
+            // File header
+            if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8)
             {
                 success = false;
             }
-
-            for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+            // Write number of tile spawns
+            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1)
             {
-                success = ModelSpawn::WriteToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                success = false;
             }
-
-            fclose(mapfile);
-
-            // <====
-
-            // Write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap& tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+            // Write tile spawns
+            for (uint32 s = 0; s < nSpawns; ++s)
             {
-                const ModelSpawn& spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN)           // WDT spawn, saved as tile 65/65 currently...
+                if (s && tile != tileEntries.end())
                 {
-                    continue;
+                    ++tile;
                 }
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
-                FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
-                // File header
-                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8)
+                const ModelSpawn& spawn2 = spawns.UniqueEntries[tile->second];
+                success = success && ModelSpawn::WriteToFile(tilefile, spawn2);
+                // MapTree nodes to update when loading tile:
+                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1)
                 {
                     success = false;
                 }
-                // Write number of tile spawns
-                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1)
+            }
+            fclose(tilefile);
+        }
+
+        if (success)
+        {
+            setManifestEntry(mapkey.str(), hash);
+        }
+        return success;
+    }
+
+    /**
+     * @brief Builds the name of the file holding one tile of a map.
+     *
+     * @param mapId The map ID.
+     * @param tileId The packed tile ID.
+     * @return std::string The path of the .vmtile file.
+     */
+    std::string TileAssembler::getTileFileName(uint32 mapId, uint32 tileId) const
+    {
+        uint32 x, y;
+        StaticMapTree::unpackTileID(tileId, x, y);
+
+        std::stringstream tilefilename;
+        tilefilename.fill('0');
+        tilefilename << iDestDir << "/" << std::setw(3) << mapId << "_";
+        tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
+        return tilefilename.str();
+    }
+
+    /**
+     * @brief Runs job(0) .. job(count - 1) on the worker threads.
+     *
+     * Jobs not started yet are dropped once one of them failed.
+     *
+     * @return bool True if all jobs succeeded, false otherwise.
+     */
+    bool TileAssembler::runParallel(size_t count, const std::function<bool(size_t)>& job)
+    {
+        uint32 threads = iThreadCount ? iThreadCount : std::max(1u, std::thread::hardware_concurrency());
+        threads = uint32(std::min<size_t>(threads, count));
+
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < count && !failed; i = next++)
+            {
+                if (!job(i))
                 {
-                    success = false;
+                    failed = true;
                 }
-                // Write tile spawns
-                for (uint32 s = 0; s < nSpawns; ++s)
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < threads; ++i)
+        {
+            workers.push_back(std::thread(worker));
+        }
+        worker();                                           // the calling thread works too
+
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            workers[i].join();
+        }
+
+        return !failed;
+    }
+
+    /**
+     * @brief Content hash of a file in the source directory, cached per run.
+     *
+     * @param pName The file name, relative to the source directory.
+     * @param seed The hash to continue from.
+     * @return uint64 The combined hash, a missing file hashes as empty.
+     */
+    uint64 TileAssembler::hashFile(const std::string& pName, uint64 seed)
+    {
+        uint64 fileHash = 0;
+        bool cached;
+        {
+            std::lock_guard<std::mutex> guard(iLock);
+            std::map<std::string, uint64>::const_iterator itr = iFileHashes.find(pName);
+            cached = itr != iFileHashes.end();
+            if (cached)
+            {
+                fileHash = itr->second;
+            }
+        }
+
+        if (!cached)
+        {
+            fileHash = FNV_OFFSET_BASIS;
+            if (FILE* rf = fopen((iSrcDir + "/" + pName).c_str(), "rb"))
+            {
+                std::vector<char> buff(64 * 1024);
+                size_t readBytes;
+                while ((readBytes = fread(&buff[0], 1, buff.size(), rf)) > 0)
                 {
-                    if (s && tile != tileEntries.end())
-                    {
-                        ++tile;
-                    }
-                    const ModelSpawn& spawn2 = map_iter->second->UniqueEntries[tile->second];
-                    success = success && ModelSpawn::WriteToFile(tilefile, spawn2);
-                    // MapTree nodes to update when loading tile:
-                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1)
-                    {
-                        success = false;
-                    }
+                    fileHash = hashBytes(fileHash, &buff[0], readBytes);
                 }
-                fclose(tilefile);
+                fclose(rf);
             }
-            // break; // Test, extract only first map; TODO: remove this line
+
+            std::lock_guard<std::mutex> guard(iLock);
+            iFileHashes[pName] = fileHash;
         }
 
-        // Add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels(RAW_VMAP_MAGIC);
+        return hashBytes(seed, &fileHash, sizeof(fileHash));
+    }
 
-        // Export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+    /**
+     * @brief Checks the previous manifest for an unchanged input whose output still exists.
+     *
+     * @param key The manifest key of the output.
+     * @param hash The hash of the current input.
+     * @param outputFile The file written for key.
+     * @return bool True if the job can be skipped.
+     */
+    bool TileAssembler::isUpToDate(const std::string& key, uint64 hash, const std::vector<std::string>& outputFiles)
+    {
+        if (!iIncremental)
+        {
+            return false;
+        }
+
+        std::map<std::string, uint64>::const_iterator itr = iOldManifest.find(key);
+        if (itr == iOldManifest.end() || itr->second != hash)
+        {
+            return false;
+        }
+
+        for (std::vector<std::string>::const_iterator outputFile = outputFiles.begin(); outputFile != outputFiles.end(); ++outputFile)
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile, RAW_VMAP_MAGIC))
+            FILE* rf = fopen(outputFile->c_str(), "rb");
+            if (!rf)
             {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
+                return false;
             }
+            fclose(rf);
         }
 
-        // Cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        setManifestEntry(key, hash);
+        return true;
+    }
+
+    /**
+     * @brief Records the input hash of a written output for the next run.
+     *
+     * @param key The manifest key of the output.
+     * @param hash The hash of the input.
+     */
+    void TileAssembler::setManifestEntry(const std::string& key, uint64 hash)
+    {
+        std::lock_guard<std::mutex> guard(iLock);
+        iManifest[key] = hash;
+    }
+
+    /**
+     * @brief Reads the manifest written by the previous run, if any.
+     */
+    void TileAssembler::readManifest()
+    {
+        std::ifstream manifest((iDestDir + "/" + VMAP_MANIFEST).c_str());
+        std::string line;
+        while (std::getline(manifest, line))
         {
-            delete map_iter->second;
+            // <hex hash><tab><key>, keys may contain spaces
+            std::string::size_type tab = line.find('\t');
+            if (tab == std::string::npos)
+            {
+                continue;
+            }
+
+            iOldManifest[line.substr(tab + 1)] = strtoull(line.substr(0, tab).c_str(), NULL, 16);
+        }
+    }
+
+    /**
+     * @brief Writes the hashes of all outputs produced or kept by this run.
+     *
+     * @return bool True if successful, false otherwise.
+     */
+    bool TileAssembler::writeManifest()
+    {
+        std::string filename = iDestDir + "/" + VMAP_MANIFEST;
+        FILE* manifest = fopen(filename.c_str(), "wb");
+        if (!manifest)
+        {
+            printf("Can not open %s\n", filename.c_str());
+            return false;
         }
+
+        bool success = true;
+        for (std::map<std::string, uint64>::const_iterator itr = iManifest.begin(); itr != iManifest.end() && success; ++itr)
+        {
+            success = fprintf(manifest, "%016llx\t%s\n", (unsigned long long)itr->second, itr->first.c_str()) > 0;
+        }
+
+        fclose(manifest);
         return success;
     }
 
@@ -456,6 +810,9 @@ namespace VMAP
 
     /**
      * @brief Exports the game object models.
+     *
+     * The list is read in order, the model bounds are computed in parallel
+     * and the copy is written in the original order again.
      */
     void TileAssembler::exportGameobjectModels(const char *RAW_VMAP_MAGIC)
     {
@@ -472,6 +829,15 @@ namespace VMAP
             return;
         }
 
+        struct GameobjectModel
+        {
+            uint32 displayId;
+            std::string name;
+            AABox bounds;
+            bool valid;
+        };
+        std::vector<GameobjectModel> models;
+
         uint32 name_length, displayId;
         char buff[500];
         while (!feof(model_list))
@@ -501,17 +867,25 @@ namespace VMAP
                 std::cout << "\nFile '" << GAMEOBJECT_MODELS << "' seems to be corrupted" << std::endl;
                 break;
             }
-            std::string model_name(buff, name_length);
+
+            GameobjectModel model;
+            model.displayId = displayId;
+            model.name = std::string(buff, name_length);
+            model.valid = false;
+            models.push_back(model);
+        }
+        fclose(model_list);
+
+        runParallel(models.size(), [&](size_t m)
+        {
+            GameobjectModel& model = models[m];
 
             WorldModel_Raw raw_model;
-            if (!raw_model.Read((iSrcDir + "/" + model_name).c_str(), RAW_VMAP_MAGIC))
+            if (!raw_model.Read((iSrcDir + "/" + model.name).c_str(), RAW_VMAP_MAGIC))
             {
-                continue;
+                return true;                                // skipped, not an error
             }
 
-            spawnedModelFiles.insert(model_name);
-
-            AABox bounds;
             bool boundEmpty = true;
             for (uint32 g = 0; g < raw_model.groupsArray.size(); ++g)
             {
@@ -523,22 +897,35 @@ namespace VMAP
                     Vector3& v = vertices[i];
                     if (boundEmpty)
                     {
-                        bounds = AABox(v, v), boundEmpty = false;
+                        model.bounds = AABox(v, v), boundEmpty = false;
                     }
                     else
                     {
-                        bounds.merge(v);
+                        model.bounds.merge(v);
                     }
                 }
             }
+            model.valid = true;
+            return true;
+        });
 
-            fwrite(&displayId, sizeof(uint32), 1, model_list_copy);
+        for (size_t m = 0; m < models.size(); ++m)
+        {
+            GameobjectModel const& model = models[m];
+            if (!model.valid)
+            {
+                continue;
+            }
+
+            spawnedModelFiles.insert(model.name);
+
+            name_length = model.name.size();
+            fwrite(&model.displayId, sizeof(uint32), 1, model_list_copy);
             fwrite(&name_length, sizeof(uint32), 1, model_list_copy);
-            fwrite(&buff, sizeof(char), name_length, model_list_copy);
-            fwrite(&bounds.low(), sizeof(Vector3), 1, model_list_copy);
-            fwrite(&bounds.high(), sizeof(Vector3), 1, model_list_copy);
+            fwrite(model.name.c_str(), sizeof(char), name_length, model_list_copy);
+            fwrite(&model.bounds.low(), sizeof(Vector3), 1, model_list_copy);
+            fwrite(&model.bounds.high(), sizeof(Vector3), 1, model_list_copy);
         }
-        fclose(model_list);
         fclose(model_list_copy);
     }
 
@@ -29,6 +29,10 @@
 #include <G3D/Matrix3.h>
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
 
 #include "ModelInstance.h"
 #include "WorldModel.h"
@@ -170,6 +174,72 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId; /**< Current unique name ID */
             MapData mapData; /**< Map data */
             std::set<std::string> spawnedModelFiles; /**< Set of spawned model files */
+            uint32 iThreadCount; /**< Number of worker threads, 0 for one per hardware thread */
+            bool iIncremental; /**< Skip outputs whose input hash did not change since the last run */
+            std::map<std::string, uint64> iOldManifest; /**< Input hashes read from the previous run */
+            std::map<std::string, uint64> iManifest; /**< Input hashes of the outputs of this run */
+            std::map<std::string, uint64> iFileHashes; /**< Content hashes of the source files read so far */
+            std::mutex iLock; /**< Guards iManifest and iFileHashes against the worker threads */
+
+            /**
+             * @brief Writes the map tree and tile files of one map
+             *
+             * @param mapId The map ID
+             * @param spawns The model spawns of the map
+             * @param modelFiles Receives the names of the models spawned on the map
+             * @return bool True if successful, false otherwise
+             */
+            bool exportMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles, const char *RAW_VMAP_MAGIC);
+            /**
+             * @brief Builds the name of the file holding one tile of a map
+             *
+             * @param mapId The map ID
+             * @param tileId The packed tile ID
+             * @return std::string The path of the .vmtile file
+             */
+            std::string getTileFileName(uint32 mapId, uint32 tileId) const;
+            /**
+             * @brief Runs job(0) .. job(count - 1) on the worker threads
+             *
+             * @param count The number of jobs
+             * @param job The job, returns false on failure
+             * @return bool True if all jobs succeeded, false otherwise
+             */
+            bool runParallel(size_t count, const std::function<bool(size_t)>& job);
+            /**
+             * @brief Continues a hash with the content of a source file
+             *
+             * @param pName The file name, relative to the source directory
+             * @param seed The hash to continue from
+             * @return uint64 The combined hash
+             */
+            uint64 hashFile(const std::string& pName, uint64 seed);
+            /**
+             * @brief Checks whether the output of a job can be kept from the previous run
+             *
+             * @param key The manifest key of the output
+             * @param hash The hash of the current input
+             * @param outputFiles The files written for key, all of them have to exist
+             * @return bool True if the job can be skipped
+             */
+            bool isUpToDate(const std::string& key, uint64 hash, const std::vector<std::string>& outputFiles);
+            /**
+             * @brief Records the input hash of a written output
+             *
+             * @param key The manifest key of the output
+             * @param hash The hash of the input
+             */
+            void setManifestEntry(const std::string& key, uint64 hash);
+            /**
+             * @brief Reads the manifest of the previous run
+             */
+            void readManifest();
+            /**
+             * @brief Writes the manifest of this run
+             *
+             * @return bool True if successful, false otherwise
+             */
+            bool writeManifest();
 
         public:
             /**
@@ -221,6 +291,18 @@ namespace VMAP
              * @param pFilterMethod The filter method to set
              */
             void setModelNameFilterMethod(bool (*pFilterMethod)(char* pName)) { iFilterMethod = pFilterMethod; }
+            /**
+             * @brief Sets the number of worker threads
+             *
+             * @param pThreadCount The number of threads, 0 for one per hardware thread
+             */
+            void setThreadCount(uint32 pThreadCount) { iThreadCount = pThreadCount; }
+            /**
+             * @brief Enables or disables skipping of unchanged outputs
+             *
+             * @param pIncremental True to reuse the outputs of the previous run
+             */
+            void setIncremental(bool pIncremental) { iIncremental = pIncremental; }
             /**
              * @brief Gets the directory entry name from the model name
              *
@@ -124,6 +124,7 @@ static bool start_db()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo", "");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    int nHolderConnections = sConfig.GetIntDefault("CharacterDatabaseHolderConnections", 2);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -132,10 +133,10 @@ static bool start_db()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + nHolderConnections + 1);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nHolderConnections))
     {
         sLog.outError("Can not connect to Character database %s", dbstring.c_str());
 
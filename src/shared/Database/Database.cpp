@@ -120,13 +120,28 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+    {
+        return NULL;
+    }
+
+    // get prepared statement object
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    // bind parameters
+    pStmt->bind(id);
+    // run query and fetch the whole result set
+    return pStmt->query();
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nHolderConns /*= 0*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -141,6 +156,8 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     }
 
     m_pingIntervallms = sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000);
+    m_writeBatchSize = std::max(1, sConfig.GetIntDefault("DatabaseWriteBatchSize", 1));
+    m_infoString = infoString;
 
     // create DB connections
 
@@ -178,6 +195,19 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         return false;
     }
 
+    // connections for parallel execution of query holders (e.g. character login)
+    for (int i = 0; i < std::min(nHolderConns, MAX_CONNECTION_POOL_SIZE); ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pHolderConns.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -200,6 +230,22 @@ void Database::StopServer()
     }
 
     m_pQueryConnections.clear();
+
+    for (size_t i = 0; i < m_pHolderConns.size(); ++i)
+    {
+        delete m_pHolderConns[i];
+    }
+
+    m_pHolderConns.clear();
+
+    // streamed results must not outlive the database, busy connections are owned by them
+    for (size_t i = 0; i < m_pStreamConnections.size(); ++i)
+    {
+        delete m_pStreamConnections[i];
+    }
+
+    m_pStreamConnections.clear();
+    m_nStreamConnections = 0;
 }
 
 SqlDelayThread* Database::CreateDelayThread()
@@ -216,6 +262,14 @@ void Database::InitDelayThread()
     m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
     m_TransStorage = new ACE_TSS<Database::TransHelper>();
     m_delayThread = new ACE_Based::Thread(m_threadBody);
+
+    for (size_t i = 0; i < m_pHolderConns.size(); ++i)
+    {
+        // the async thread pings all connections, no need to do it here
+        SqlDelayThread* threadBody = new SqlDelayThread(this, m_pHolderConns[i], false);
+        m_holderThreadBodies.push_back(threadBody);
+        m_holderThreads.push_back(new ACE_Based::Thread(threadBody));
+    }
 }
 
 void Database::HaltDelayThread()
@@ -225,8 +279,21 @@ void Database::HaltDelayThread()
         return;
     }
 
+    // holder queries are dispatched by the delay thread, so it is flushed first and the
+    // holder threads stop after it, once nothing can be handed to them anymore
     m_threadBody->Stop();                                   // Stop event
     m_delayThread->wait();                                  // Wait for flush to DB
+
+    for (size_t i = 0; i < m_holderThreads.size(); ++i)
+    {
+        m_holderThreadBodies[i]->Stop();
+        m_holderThreads[i]->wait();
+        delete m_holderThreads[i];                          // This also deletes the thread body
+    }
+
+    m_holderThreads.clear();
+    m_holderThreadBodies.clear();
+
     delete m_TransStorage;
     delete m_delayThread;                                   // This also deletes m_threadBody
     m_delayThread = NULL;
@@ -280,6 +347,69 @@ SqlConnection* Database::getQueryConnection()
     return m_pQueryConnections[nCount % m_nQueryConnPoolSize];
 }
 
+SqlDelayThread* Database::GetHolderThread()
+{
+    long nCount = ++m_nHolderCounter;
+    return m_holderThreadBodies[size_t(nCount & 0x7FFFFFFF) % m_holderThreadBodies.size()];
+}
+
+SqlConnection* Database::getStreamConnection()
+{
+    {
+        LOCK_GUARD _guard(m_streamGuard);
+        if (!m_pStreamConnections.empty())
+        {
+            SqlConnection* pConn = m_pStreamConnections.back();
+            m_pStreamConnections.pop_back();
+            return pConn;
+        }
+    }
+
+    // only during nested streamed loads, usually a single one is ever opened
+    SqlConnection* pConn = CreateConnection();
+    if (!pConn->Initialize(m_infoString.c_str()))
+    {
+        delete pConn;
+        return NULL;
+    }
+
+    LOCK_GUARD _guard(m_streamGuard);
+    ++m_nStreamConnections;
+    return pConn;
+}
+
+void Database::ReleaseStreamConnection(SqlConnection* conn)
+{
+    LOCK_GUARD _guard(m_streamGuard);
+    m_pStreamConnections.push_back(conn);
+}
+
+QueryResult* Database::QueryStreamed(const char* sql)
+{
+    SqlConnection* pConn = getStreamConnection();
+    if (!pConn)
+    {
+        // can't open another connection, fall back to a buffered result
+        return Query(sql);
+    }
+
+    QueryResult* result = pConn->QueryStreamed(sql);
+    if (!result)
+    {
+        ReleaseStreamConnection(pConn);
+        return NULL;
+    }
+
+    // same contract as Query(): NULL for empty results, otherwise positioned on the first row
+    if (!result->NextRow())
+    {
+        delete result;
+        return NULL;
+    }
+
+    return result;
+}
+
 void Database::Ping()
 {
     const char* sql = "SELECT 1";
@@ -294,6 +424,18 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         delete guard->Query(sql);
     }
+
+    for (size_t i = 0; i < m_pHolderConns.size(); ++i)
+    {
+        SqlConnection::Lock guard(m_pHolderConns[i]);
+        delete guard->Query(sql);
+    }
+
+    LOCK_GUARD _guard(m_streamGuard);
+    for (size_t i = 0; i < m_pStreamConnections.size(); ++i)
+    {
+        delete m_pStreamConnections[i]->Query(sql);
+    }
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -364,6 +506,28 @@ QueryResult* Database::PQuery(const char* format, ...)
     return Query(szQuery);
 }
 
+QueryResult* Database::PQueryStreamed(const char* format, ...)
+{
+    if (!format)
+    {
+        return NULL;
+    }
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return NULL;
+    }
+
+    return QueryStreamed(szQuery);
+}
+
 QueryNamedResult* Database::PQueryNamed(const char* format, ...)
 {
     if (!format)
@@ -703,6 +867,15 @@ bool Database::DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* pa
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+    std::shared_ptr<SqlStmtParameters> p(params);
+    // execute statement
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
 {
     int nId = -1;
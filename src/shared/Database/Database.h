@@ -85,6 +85,17 @@ class SqlConnection
          * @return QueryNamedResult
          */
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
+        /**
+         * @brief unbuffered query, the returned result owns this connection
+         *
+         * Called on a connection taken from Database::getStreamConnection(),
+         * the result is not positioned on the first row yet. On failure NULL
+         * is returned and the connection is still owned by the caller.
+         *
+         * @param sql
+         * @return QueryResult
+         */
+        virtual QueryResult* QueryStreamed(const char* sql) = 0;
 
         /**
          * @brief public methods for making requests
@@ -131,6 +142,14 @@ class SqlConnection
          * @return bool
          */
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        /**
+         * @brief run prepared SELECT statement
+         *
+         * @param nIndex
+         * @param id
+         * @return QueryResult
+         */
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
 
         /**
          * @brief SqlConnection object lock
@@ -234,9 +253,10 @@ class Database
          *
          * @param infoString
          * @param nConns
+         * @param nHolderConns connections that execute the queries of a holder in parallel, 0 runs them on the async connection
          * @return bool
          */
-        virtual bool Initialize(const char* infoString, int nConns = 1);
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nHolderConns = 0);
         /**
          * @brief start worker thread for async DB request execution
          *
@@ -287,6 +307,41 @@ class Database
          */
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
 
+        /**
+         * @brief synchronous query for bulk loads, rows are streamed from the server
+         *
+         * The query runs on its own connection and rows are read by a background
+         * thread while the caller parses the previous ones, so large tables are
+         * never buffered as a whole. Other queries can be made while iterating.
+         * GetRowCount() only counts the rows read so far, callers that need the
+         * total (e.g. for a progress bar) have to SELECT COUNT(*) themselves.
+         *
+         * @param sql
+         * @return QueryResult
+         */
+        QueryResult* QueryStreamed(const char* sql);
+        /**
+         * @brief
+         *
+         * @param format
+         * @return QueryResult
+         */
+        QueryResult* PQueryStreamed(const char* format, ...) ATTR_PRINTF(2, 3);
+        /**
+         * @brief return a stream connection to the idle list, called by the streamed result
+         *
+         * @param conn
+         */
+        void ReleaseStreamConnection(SqlConnection* conn);
+        /**
+         * @brief connection for exclusive use by one thread, e.g. for temporary tables
+         *
+         * Taken from the stream connections, give it back with ReleaseStreamConnection().
+         *
+         * @return SqlConnection NULL if no connection could be opened
+         */
+        SqlConnection* AcquireConnection() { return getStreamConnection(); }
+
         /**
          * @brief
          *
@@ -635,6 +690,18 @@ class Database
          * @return uint32
          */
         uint32 GetPingIntervall() { return m_pingIntervallms; }
+        /**
+         * @brief max. contiguous plain writes the async thread commits together
+         *
+         * @return uint32 1 runs every write on its own
+         */
+        uint32 GetWriteBatchSize() const { return m_writeBatchSize; }
+        /**
+         * @brief queue and latency counters of the delay threads
+         *
+         * @return SqlDelayStats
+         */
+        SqlDelayStats& GetDelayStats() { return m_delayStats; }
 
         /**
          * @brief function to ping database connections
@@ -652,15 +719,28 @@ class Database
          */
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
 
+        /**
+         * @brief number of threads that run holder queries in parallel
+         *
+         * @return size_t 0 if holders run on the async connection
+         */
+        size_t GetHolderThreadCount() const { return m_holderThreadBodies.size(); }
+        /**
+         * @brief round-robin selection of a holder query thread
+         *
+         * @return SqlDelayThread
+         */
+        SqlDelayThread* GetHolderThread();
+
     protected:
         /**
          * @brief
          *
          */
         Database() :
-            m_TransStorage(NULL),m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pResultQueue(NULL),
-            m_threadBody(NULL), m_delayThread(NULL), m_bAllowAsyncTransactions(false),
-            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
+            m_TransStorage(NULL),m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_nStreamConnections(0), m_pResultQueue(NULL),
+            m_threadBody(NULL), m_delayThread(NULL), m_nHolderCounter(0), m_bAllowAsyncTransactions(false),
+            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0), m_writeBatchSize(1)
         {
             m_nQueryCounter = -1;
         }
@@ -754,6 +834,12 @@ class Database
          * @return SqlConnection
          */
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
+        /**
+         * @brief idle stream connection, a new one is opened if all are busy
+         *
+         * @return SqlConnection NULL if the connection failed
+         */
+        SqlConnection* getStreamConnection();
 
         friend class SqlStatement;
         // PREPARED STATEMENT API
@@ -773,6 +859,14 @@ class Database
          * @return bool
          */
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        /**
+         * @brief
+         *
+         * @param id
+         * @param params
+         * @return QueryResult
+         */
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters* params);
 
         // connection helper counters
         int m_nQueryConnPoolSize;                               /**< current size of query connection pool */
@@ -788,10 +882,19 @@ class Database
         // only one single DB connection for transactions
         SqlConnection* m_pAsyncConn; /**< TODO */
 
+        SqlConnectionContainer m_pStreamConnections;        /**< idle connections for streamed queries */
+        int m_nStreamConnections;                           /**< stream connections opened, idle or busy */
+        std::string m_infoString;                           /**< to open stream connections on demand */
+
         SqlResultQueue*     m_pResultQueue;                 /**< Transaction queues from diff. threads */
         SqlDelayThread*     m_threadBody;                   /**< Pointer to delay sql executer (owned by m_delayThread) */
         ACE_Based::Thread*  m_delayThread;                  /**< Pointer to executer thread */
 
+        SqlConnectionContainer m_pHolderConns;              /**< one per holder thread, only used by it */
+        std::vector<SqlDelayThread*> m_holderThreadBodies;  /**< owned by m_holderThreads */
+        std::vector<ACE_Based::Thread*> m_holderThreads;    /**< run holder queries in parallel */
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_nHolderCounter; /**< counter for holder thread selection */
+
         bool m_bAllowAsyncTransactions;                     /**< flag which specifies if async transactions are enabled */
 
         // PREPARED STATEMENT REGISTRY
@@ -807,6 +910,7 @@ class Database
         typedef ACE_Guard<LOCK_TYPE> LOCK_GUARD;
 
         mutable LOCK_TYPE m_stmtGuard; /**< TODO */
+        LOCK_TYPE m_streamGuard; /**< guards m_pStreamConnections */
 
         /**
          * @brief
@@ -822,5 +926,7 @@ class Database
         bool m_logSQL; /**< TODO */
         std::string m_logsDir; /**< TODO */
         uint32 m_pingIntervallms; /**< TODO */
+        uint32 m_writeBatchSize;                            /**< see GetWriteBatchSize() */
+        SqlDelayStats m_delayStats;
 };
 #endif
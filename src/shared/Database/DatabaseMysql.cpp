@@ -281,6 +281,35 @@ QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
     return new QueryNamedResult(queryResult, names);
 }
 
+QueryResult* MySQLConnection::QueryStreamed(const char* sql)
+{
+    if (!mMysql)
+    {
+        return NULL;
+    }
+
+    uint32 _s = getMSTime();
+
+    if (mysql_query(mMysql, sql))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_error(mMysql));
+        return NULL;
+    }
+    else
+    {
+        DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL (streamed): %s", getMSTimeDiff(_s, getMSTime()), sql);
+    }
+
+    MYSQL_RES* result = mysql_use_result(mMysql);
+    if (!result)
+    {
+        return NULL;
+    }
+
+    return new QueryResultMysqlStream(this, result, mysql_fetch_fields(result), mysql_field_count(mMysql));
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
     if (!mMysql)
@@ -418,7 +447,11 @@ bool MySqlPreparedStatement::prepare()
         /* Get total columns in the query */
         m_nColumns = mysql_num_fields(m_pResultMetadata);
 
-        // bind output buffers
+        // output buffers are bound per execution, string buffers depend on the result max_length
+        m_pResult = new MYSQL_BIND[m_nColumns];
+
+        MySqlBool updateMaxLength = 1;
+        mysql_stmt_attr_set(m_stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
     }
 
     m_bPrepared = true;
@@ -520,6 +553,140 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+QueryResult* MySqlPreparedStatement::query()
+{
+    if (!isPrepared() || !isQuery())
+    {
+        return NULL;
+    }
+
+    if (!execute())
+    {
+        return NULL;
+    }
+
+    // buffer the result set on client side, that also fills MYSQL_FIELD::max_length
+    if (mysql_stmt_store_result(m_stmt))
+    {
+        sLog.outError("SQL: can not store result of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return NULL;
+    }
+
+    uint64 rowCount = mysql_stmt_num_rows(m_stmt);
+    if (!rowCount)
+    {
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    MYSQL_FIELD* fields = mysql_fetch_fields(m_pResultMetadata);
+
+    enum ColumnTypes { COLUMN_SIGNED, COLUMN_UNSIGNED, COLUMN_DOUBLE, COLUMN_STRING };
+
+    std::vector<ColumnTypes> columnTypes(m_nColumns);
+    std::vector<uint64> numbers(m_nColumns);
+    std::vector<std::vector<char> > strings(m_nColumns);
+    std::vector<unsigned long> lengths(m_nColumns);
+    std::vector<MySqlBool> nulls(m_nColumns);
+
+    memset(m_pResult, 0, sizeof(MYSQL_BIND) * m_nColumns);
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        MYSQL_BIND& pData = m_pResult[i];
+
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_LONGLONG:
+            case MYSQL_TYPE_YEAR:
+                columnTypes[i] = (fields[i].flags & UNSIGNED_FLAG) ? COLUMN_UNSIGNED : COLUMN_SIGNED;
+                pData.buffer_type = MYSQL_TYPE_LONGLONG;
+                pData.is_unsigned = columnTypes[i] == COLUMN_UNSIGNED;
+                pData.buffer = &numbers[i];
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+                columnTypes[i] = COLUMN_DOUBLE;
+                pData.buffer_type = MYSQL_TYPE_DOUBLE;
+                pData.buffer = &numbers[i];
+                break;
+            default:                                        // text, blobs, decimals and dates keep their text form
+                columnTypes[i] = COLUMN_STRING;
+                strings[i].resize(fields[i].max_length + 1);
+                pData.buffer_type = MYSQL_TYPE_STRING;
+                pData.buffer = &strings[i][0];
+                pData.buffer_length = strings[i].size();
+                break;
+        }
+
+        pData.length = &lengths[i];
+        pData.is_null = &nulls[i];
+    }
+
+    if (mysql_stmt_bind_result(m_stmt, m_pResult))
+    {
+        sLog.outError("SQL: can not bind result of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    QueryResultMysqlStmt* queryResult = new QueryResultMysqlStmt(fields, rowCount, m_nColumns);
+
+    int fetchResult;
+    while ((fetchResult = mysql_stmt_fetch(m_stmt)) == 0 || fetchResult == MYSQL_DATA_TRUNCATED)
+    {
+        if (fetchResult == MYSQL_DATA_TRUNCATED)
+        {
+            sLog.outError("SQL: truncated data in result of '%s'", m_szFmt.c_str());
+        }
+
+        for (uint32 i = 0; i < m_nColumns; ++i)
+        {
+            if (nulls[i])
+            {
+                queryResult->AddNull();
+                continue;
+            }
+
+            switch (columnTypes[i])
+            {
+                case COLUMN_SIGNED:
+                    queryResult->AddValue(int64(numbers[i]));
+                    break;
+                case COLUMN_UNSIGNED:
+                    queryResult->AddValue(numbers[i]);
+                    break;
+                case COLUMN_DOUBLE:
+                {
+                    double value;
+                    memcpy(&value, &numbers[i], sizeof(value));
+                    queryResult->AddValue(value);
+                    break;
+                }
+                case COLUMN_STRING:
+                    queryResult->AddValue(&strings[i][0], std::min<unsigned long>(lengths[i], strings[i].size() - 1));
+                    break;
+            }
+        }
+    }
+
+    if (fetchResult != MYSQL_NO_DATA)
+    {
+        sLog.outError("SQL: can not fetch result of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+    }
+
+    mysql_stmt_free_result(m_stmt);
+
+    queryResult->NextRow();
+    return queryResult;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType(const SqlStmtFieldData& data, bool& bUnsigned)
 {
     bUnsigned = 0;
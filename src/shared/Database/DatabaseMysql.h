@@ -34,10 +34,15 @@
 #include <ace/Guard_T.h>
 #include <mysql.h>
 
+#include <type_traits>
+
 #ifdef WIN32
 #include <winsock2.h>
 #endif
 
+/// my_bool was replaced by bool in MySQL 8, MariaDB still uses it
+typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type MySqlBool;
+
 /**
  * @brief MySQL prepared statement class
  *
@@ -80,6 +85,13 @@ class MySqlPreparedStatement : public SqlPreparedStatement
          */
         bool execute() override;
 
+        /**
+         * @brief execute SELECT statement, result columns are bound to typed buffers
+         *
+         * @return QueryResult
+         */
+        QueryResult* query() override;
+
     protected:
         /**
          * @brief bind parameters
@@ -153,6 +165,13 @@ class MySQLConnection : public SqlConnection
          * @return QueryNamedResult
          */
         QueryNamedResult* QueryNamed(const char* sql) override;
+        /**
+         * @brief mysql_use_result based query, see QueryResultMysqlStream
+         *
+         * @param sql
+         * @return QueryResult
+         */
+        QueryResult* QueryStreamed(const char* sql) override;
         /**
          * @brief
          *
@@ -23,3 +23,29 @@
  */
 
 //#include "DatabaseEnv.h"
+
+#include "Field.h"
+#include <cfloat>
+
+const char* Field::FormatBinary() const
+{
+    switch (mBinaryType)
+    {
+        case BINARY_INT64:
+            snprintf(mText, sizeof(mText), SI64FMTD, mBinary.i64);
+            break;
+        case BINARY_UINT64:
+            snprintf(mText, sizeof(mText), UI64FMTD, mBinary.ui64);
+            break;
+        case BINARY_DOUBLE:
+            // same precision as the text protocol sends
+            snprintf(mText, sizeof(mText), "%.*g", mType == MYSQL_TYPE_FLOAT ? FLT_DIG : DBL_DIG, mBinary.d);
+            break;
+        default:
+            mText[0] = '\0';
+            break;
+    }
+
+    mTextReady = true;
+    return mText;
+}
@@ -53,14 +53,14 @@ class Field
          * @brief
          *
          */
-        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL) {}
+        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL), mBinaryType(BINARY_NONE), mTextReady(false) { mBinary.i64 = 0; }
         /**
          * @brief
          *
          * @param value
          * @param type
          */
-        Field(const char* value, enum_field_types type) : mValue(value), mType(type) {}
+        Field(const char* value, enum_field_types type) : mValue(value), mType(type), mBinaryType(BINARY_NONE), mTextReady(false) { mBinary.i64 = 0; }
 
         /**
          * @brief
@@ -86,7 +86,7 @@ class Field
          *
          * @return const char
          */
-        const char* GetString() const { return mValue; }
+        const char* GetString() const { return mBinaryType != BINARY_NONE && !mTextReady ? FormatBinary() : mValue; }
         /**
          * @brief
          *
@@ -94,62 +94,63 @@ class Field
          */
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
         }
         /**
          * @brief
          *
          * @return float
          */
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
+        float GetFloat() const { return mValue ? static_cast<float>(mBinaryType != BINARY_NONE ? BinaryAsDouble() : atof(mValue)) : 0.0f; }
         /**
          * @brief
          *
          * @return bool
          */
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
+        bool GetBool() const { return mValue ? (mBinaryType != BINARY_NONE ? BinaryAsInt64() > 0 : atoi(mValue) > 0) : false; }
         /**
         * @brief
         *
         * @return double
         */
-        double GetDouble() const { return mValue ? static_cast<double>(atof(mValue)) : 0.0f; }
+        double GetDouble() const { return mValue ? (mBinaryType != BINARY_NONE ? BinaryAsDouble() : static_cast<double>(atof(mValue))) : 0.0f; }
         /**
         * @brief
         *
         * @return int8
         */
-        int8 GetInt8() const { return mValue ? static_cast<int8>(atol(mValue)) : int8(0); }
+        int8 GetInt8() const { return mValue ? static_cast<int8>(mBinaryType != BINARY_NONE ? BinaryAsInt64() : atol(mValue)) : int8(0); }
         /**
          * @brief
          *
          * @return int32
          */
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        int32 GetInt32() const { return mValue ? static_cast<int32>(mBinaryType != BINARY_NONE ? BinaryAsInt64() : atol(mValue)) : int32(0); }
         /**
          * @brief
          *
          * @return uint8
          */
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(mBinaryType != BINARY_NONE ? BinaryAsInt64() : atol(mValue)) : uint8(0); }
         /**
          * @brief
          *
          * @return uint16
          */
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(mBinaryType != BINARY_NONE ? BinaryAsInt64() : atol(mValue)) : uint16(0); }
         /**
          * @brief
          *
          * @return int16
          */
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        int16 GetInt16() const { return mValue ? static_cast<int16>(mBinaryType != BINARY_NONE ? BinaryAsInt64() : atol(mValue)) : int16(0); }
         /**
          * @brief
          *
          * @return uint32
          */
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(mBinaryType != BINARY_NONE ? BinaryAsInt64() : atol(mValue)) : uint32(0); }
         /**
          * @brief
          *
@@ -157,6 +158,11 @@ class Field
          */
         uint64 GetUInt64() const
         {
+            if (mValue && mBinaryType != BINARY_NONE)
+            {
+                return uint64(BinaryAsInt64());
+            }
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
             {
@@ -172,6 +178,11 @@ class Field
         */
         uint64 GetInt64() const
         {
+            if (mValue && mBinaryType != BINARY_NONE)
+            {
+                return BinaryAsInt64();
+            }
+
             int64 value = 0;
             if (!mValue || sscanf(mValue, SI64FMTD, &value) == -1)
             {
@@ -195,7 +206,19 @@ class Field
          *
          * @param value
          */
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mBinaryType = BINARY_NONE; }
+
+        /**
+         * @brief store a value received through the binary protocol
+         *
+         * Getters convert it directly, the text form is only built on
+         * GetString() calls.
+         *
+         * @param value
+         */
+        void SetValue(int64 value) { mBinary.i64 = value; SetBinary(BINARY_INT64); }
+        void SetValue(uint64 value) { mBinary.ui64 = value; SetBinary(BINARY_UINT64); }
+        void SetValue(double value) { mBinary.d = value; SetBinary(BINARY_DOUBLE); }
 
     private:
         /**
@@ -212,7 +235,59 @@ class Field
          */
         Field& operator=(Field const&);
 
+        enum BinaryTypes
+        {
+            BINARY_NONE,
+            BINARY_INT64,
+            BINARY_UINT64,
+            BINARY_DOUBLE
+        };
+
+        void SetBinary(BinaryTypes type)
+        {
+            mBinaryType = type;
+            mTextReady = false;
+            mValue = mText;                                 // not NULL, IsNULL() stays valid
+        }
+
+        int64 BinaryAsInt64() const
+        {
+            switch (mBinaryType)
+            {
+                case BINARY_UINT64: return int64(mBinary.ui64);
+                case BINARY_DOUBLE: return int64(mBinary.d);
+                default:            return mBinary.i64;
+            }
+        }
+
+        double BinaryAsDouble() const
+        {
+            switch (mBinaryType)
+            {
+                case BINARY_UINT64: return double(mBinary.ui64);
+                case BINARY_DOUBLE: return mBinary.d;
+                default:            return double(mBinary.i64);
+            }
+        }
+
+        /**
+         * @brief builds the text form of a binary value on first request
+         *
+         * @return const char
+         */
+        const char* FormatBinary() const;
+
         const char* mValue; /**< TODO */
         enum_field_types mType; /**< TODO */
+
+        union
+        {
+            int64 i64;
+            uint64 ui64;
+            double d;
+        } mBinary; /**< value received through the binary protocol */
+        BinaryTypes mBinaryType; /**< TODO */
+        mutable bool mTextReady; /**< TODO */
+        mutable char mText[32]; /**< text form of mBinary */
 };
 #endif
@@ -26,6 +26,7 @@
 
 #include "DatabaseEnv.h"
 #include "Utilities/Errors.h"
+#include "Threading/Threading.h"
 
 QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
     QueryResult(rowCount, fieldCount), mResult(result)
@@ -80,6 +81,296 @@ void QueryResultMysql::EndQuery()
     }
 }
 
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mNextCell(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(fields[i].type);
+    }
+
+    mCells.reserve(size_t(rowCount) * fieldCount);
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    EndQuery();
+}
+
+void QueryResultMysqlStmt::AddNull()
+{
+    Cell cell;
+    cell.ui64 = 0;
+    cell.type = CELL_NULL;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddValue(int64 value)
+{
+    Cell cell;
+    cell.i64 = value;
+    cell.type = CELL_INT64;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddValue(uint64 value)
+{
+    Cell cell;
+    cell.ui64 = value;
+    cell.type = CELL_UINT64;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddValue(double value)
+{
+    Cell cell;
+    cell.d = value;
+    cell.type = CELL_DOUBLE;
+    mCells.push_back(cell);
+}
+
+void QueryResultMysqlStmt::AddValue(const char* value, unsigned long length)
+{
+    Cell cell;
+    cell.offset = mText.size();
+    cell.type = CELL_STRING;
+    mCells.push_back(cell);
+
+    mText.insert(mText.end(), value, value + length);
+    mText.push_back('\0');
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (!mCurrentRow || mNextCell + mFieldCount > mCells.size())
+    {
+        EndQuery();
+        return false;
+    }
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Cell const& cell = mCells[mNextCell + i];
+        switch (cell.type)
+        {
+            case CELL_NULL:     mCurrentRow[i].SetValue((const char*)NULL);    break;
+            case CELL_STRING:   mCurrentRow[i].SetValue(&mText[cell.offset]);   break;
+            case CELL_INT64:    mCurrentRow[i].SetValue(cell.i64);              break;
+            case CELL_UINT64:   mCurrentRow[i].SetValue(cell.ui64);             break;
+            case CELL_DOUBLE:   mCurrentRow[i].SetValue(cell.d);                break;
+        }
+    }
+
+    mNextCell += mFieldCount;
+    return true;
+}
+
+void QueryResultMysqlStmt::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = 0;
+
+    std::vector<Cell>().swap(mCells);
+    std::vector<char>().swap(mText);
+}
+
+/**
+ * @brief runs QueryResultMysqlStream::ReadRows, never owns the result
+ *
+ */
+class QueryResultMysqlStreamReader : public ACE_Based::Runnable
+{
+    public:
+        explicit QueryResultMysqlStreamReader(QueryResultMysqlStream* owner) : m_owner(owner) {}
+
+        void run() override { m_owner->ReadRows(); }
+
+    private:
+        QueryResultMysqlStream* m_owner;
+};
+
+static const size_t STREAM_NULL_CELL = size_t(-1);
+
+QueryResultMysqlStream::QueryResultMysqlStream(SqlConnection* conn, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount) :
+    QueryResult(0, fieldCount), mConn(conn), mResult(result), mReader(NULL),
+    mNotEmpty(mLock), mNotFull(mLock), mReaderDone(false), mStop(false), mBlock(NULL), mBlockRow(0)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(fields[i].type);
+    }
+
+    mReader = new ACE_Based::Thread(new QueryResultMysqlStreamReader(this));
+}
+
+QueryResultMysqlStream::~QueryResultMysqlStream()
+{
+    EndQuery();
+}
+
+void QueryResultMysqlStream::ReadRows()
+{
+    Database& db = mConn->DB();
+    db.ThreadStart();
+
+    bool done = false;
+    while (!done)
+    {
+        RowBlock* block = new RowBlock;
+        block->cells.reserve(STREAM_BLOCK_ROWS * mFieldCount);
+
+        while (block->rows < STREAM_BLOCK_ROWS)
+        {
+            MYSQL_ROW row = mysql_fetch_row(mResult);
+            if (!row)
+            {
+                done = true;
+                break;
+            }
+
+            unsigned long* lengths = mysql_fetch_lengths(mResult);
+            for (uint32 i = 0; i < mFieldCount; ++i)
+            {
+                if (!row[i])
+                {
+                    block->cells.push_back(STREAM_NULL_CELL);
+                    continue;
+                }
+
+                block->cells.push_back(block->text.size());
+                block->text.insert(block->text.end(), row[i], row[i] + lengths[i]);
+                block->text.push_back('\0');
+            }
+
+            ++block->rows;
+        }
+
+        ACE_GUARD(ACE_Thread_Mutex, guard, mLock);
+
+        while (!mStop && mBlocks.size() >= STREAM_QUEUE_BLOCKS)
+        {
+            mNotFull.wait();
+        }
+
+        if (mStop)
+        {
+            delete block;
+            break;
+        }
+
+        if (block->rows)
+        {
+            mBlocks.push_back(block);
+        }
+        else
+        {
+            delete block;
+        }
+
+        mReaderDone = done;
+        mNotEmpty.signal();
+    }
+
+    // mysql_fetch_row returns NULL on errors too, the caller then sees a short result
+    if (done && mysql_errno(mResult->handle))
+    {
+        sLog.outErrorDb("streamed query ERROR: %s", mysql_error(mResult->handle));
+    }
+
+    // also discards the rows left on the wire when the consumer stopped early
+    mysql_free_result(mResult);
+    mResult = NULL;
+
+    db.ThreadEnd();
+}
+
+bool QueryResultMysqlStream::NextRow()
+{
+    if (!mCurrentRow)
+    {
+        return false;
+    }
+
+    if (!mBlock || mBlockRow >= mBlock->rows)
+    {
+        delete mBlock;
+        mBlock = NULL;
+        mBlockRow = 0;
+
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mLock, false);
+
+            while (mBlocks.empty() && !mReaderDone)
+            {
+                mNotEmpty.wait();
+            }
+
+            if (!mBlocks.empty())
+            {
+                mBlock = mBlocks.front();
+                mBlocks.pop_front();
+                mNotFull.signal();
+            }
+        }
+
+        if (!mBlock)
+        {
+            EndQuery();
+            return false;
+        }
+    }
+
+    size_t const* cells = &mBlock->cells[size_t(mBlockRow) * mFieldCount];
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetValue(cells[i] == STREAM_NULL_CELL ? (const char*)NULL : &mBlock->text[cells[i]]);
+    }
+
+    ++mBlockRow;
+    ++mRowCount;
+    return true;
+}
+
+void QueryResultMysqlStream::EndQuery()
+{
+    delete[] mCurrentRow;
+    mCurrentRow = 0;
+
+    if (mReader)
+    {
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, mLock);
+            mStop = true;
+            mNotFull.signal();
+        }
+
+        mReader->wait();
+        delete mReader;
+        mReader = NULL;
+    }
+
+    delete mBlock;
+    mBlock = NULL;
+
+    for (std::deque<RowBlock*>::const_iterator itr = mBlocks.begin(); itr != mBlocks.end(); ++itr)
+    {
+        delete *itr;
+    }
+    mBlocks.clear();
+
+    if (mConn)
+    {
+        mConn->DB().ReleaseStreamConnection(mConn);
+        mConn = NULL;
+    }
+}
+
 Field::SimpleDataTypes QueryResultMysql::GetSimpleType(enum_field_types type)
 {
     switch (type)
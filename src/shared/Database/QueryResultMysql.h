@@ -35,6 +35,14 @@
 
 #include <mysql.h>
 
+#include <ace/Condition_Thread_Mutex.h>
+#include <deque>
+
+namespace ACE_Based
+{
+    class Thread;
+}
+
 /**
  * @brief
  *
@@ -82,6 +90,164 @@ class QueryResultMysql : public QueryResult
 
         MYSQL_RES* mResult; /**< TODO */
 };
+
+/**
+ * @brief result of a prepared SELECT, received through the binary protocol
+ *
+ * Rows are copied out of the statement while the connection is locked, so the
+ * cached statement can be executed again before this result is consumed.
+ * Numeric columns are kept in binary form and never go through text parsing.
+ */
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        /**
+         * @brief
+         *
+         * @param fields
+         * @param rowCount
+         * @param fieldCount
+         */
+        QueryResultMysqlStmt(MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+
+        /**
+         * @brief
+         *
+         */
+        ~QueryResultMysqlStmt();
+
+        /**
+         * @brief
+         *
+         * @return bool
+         */
+        bool NextRow() override;
+
+        /**
+         * @brief append the next column of the row being filled
+         *
+         */
+        void AddNull();
+        void AddValue(int64 value);
+        void AddValue(uint64 value);
+        void AddValue(double value);
+        void AddValue(const char* value, unsigned long length);
+
+    private:
+        /**
+         * @brief
+         *
+         */
+        void EndQuery();
+
+        enum CellTypes
+        {
+            CELL_NULL,
+            CELL_STRING,
+            CELL_INT64,
+            CELL_UINT64,
+            CELL_DOUBLE
+        };
+
+        struct Cell
+        {
+            union
+            {
+                int64 i64;
+                uint64 ui64;
+                double d;
+                size_t offset;                              // into mText for CELL_STRING
+            };
+            CellTypes type;
+        };
+
+        std::vector<Cell> mCells; /**< row major column values */
+        std::vector<char> mText; /**< zero terminated strings of all rows */
+        size_t mNextCell; /**< TODO */
+};
+
+/**
+ * @brief result of an unbuffered (mysql_use_result) query
+ *
+ * Rows are fetched from the server by a reader thread in blocks of
+ * STREAM_BLOCK_ROWS while the caller parses the previous block, at most
+ * STREAM_QUEUE_BLOCKS blocks are held in memory. The result owns its stream
+ * connection and hands it back to the Database when the rows are exhausted
+ * or the result is deleted. GetRowCount() is the amount of rows read so far.
+ */
+class QueryResultMysqlStream : public QueryResult
+{
+        friend class QueryResultMysqlStreamReader;
+
+    public:
+        /**
+         * @brief
+         *
+         * @param conn
+         * @param result
+         * @param fields
+         * @param fieldCount
+         */
+        QueryResultMysqlStream(SqlConnection* conn, MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount);
+
+        /**
+         * @brief
+         *
+         */
+        ~QueryResultMysqlStream();
+
+        /**
+         * @brief
+         *
+         * @return bool
+         */
+        bool NextRow() override;
+
+    private:
+        enum
+        {
+            STREAM_BLOCK_ROWS   = 4096,
+            STREAM_QUEUE_BLOCKS = 4
+        };
+
+        /**
+         * @brief rows copied out of the libmysql buffer, NULL columns have offset STREAM_NULL_CELL
+         *
+         */
+        struct RowBlock
+        {
+            RowBlock() : rows(0) {}
+
+            std::vector<size_t> cells; /**< offsets into text, row major */
+            std::vector<char> text; /**< zero terminated column values */
+            uint32 rows; /**< TODO */
+        };
+
+        /**
+         * @brief reader thread body
+         *
+         */
+        void ReadRows();
+        /**
+         * @brief
+         *
+         */
+        void EndQuery();
+
+        SqlConnection* mConn; /**< stream connection, NULL once released */
+        MYSQL_RES* mResult; /**< owned by the reader thread until it finishes */
+        ACE_Based::Thread* mReader; /**< TODO */
+
+        ACE_Thread_Mutex mLock; /**< guards the members below */
+        ACE_Condition_Thread_Mutex mNotEmpty; /**< TODO */
+        ACE_Condition_Thread_Mutex mNotFull; /**< TODO */
+        std::deque<RowBlock*> mBlocks; /**< filled blocks waiting for the consumer */
+        bool mReaderDone; /**< no more blocks will be queued */
+        bool mStop; /**< consumer gave up, reader should quit */
+
+        RowBlock* mBlock; /**< block being consumed */
+        uint32 mBlockRow; /**< next row of mBlock */
+};
 #endif
 
 #endif
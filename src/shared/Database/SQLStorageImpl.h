@@ -288,7 +288,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         delete result;
     }
 
-    result = WorldDatabase.PQuery("SELECT * FROM `%s`", store.GetTableName());
+    // the row count is known, stream the rows instead of buffering the whole table
+    result = WorldDatabase.PQueryStreamed("SELECT * FROM `%s`", store.GetTableName());
 
     if (!result)
     {
@@ -354,6 +355,13 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     BarGoLink bar(recordCount);
     do
     {
+        // storage was sized by the COUNT(*) above
+        if (store.GetRecordCount() >= recordCount)
+        {
+            sLog.outError("%s table has more rows than counted, rows added during load are skipped.", store.GetTableName());
+            break;
+        }
+
         fields = result->Fetch();
         bar.step();
 
@@ -25,8 +25,12 @@
 #include "Database/SqlDelayThread.h"
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
+#include "Utilities/Timer.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <ace/OS_NS_sys_time.h>
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool ping) : m_dbEngine(db), m_dbConnection(conn), m_running(true), m_ping(ping),
+    m_wakeup(m_wakeupLock), m_pending(false)
 {
 }
 
@@ -36,28 +40,65 @@ SqlDelayThread::~SqlDelayThread()
     ProcessRequests();
 }
 
+bool SqlDelayThread::Delay(SqlOperation* sql)
+{
+    sql->SetQueuedTime(getMSTime());
+    m_dbEngine->GetDelayStats().OnQueued();
+    m_sqlQueue.add(sql);
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_wakeupLock, true);
+    m_pending = true;
+    m_wakeup.signal();
+    return true;
+}
+
 void SqlDelayThread::run()
 {
 #ifndef DO_POSTGRESQL
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
-
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    const uint32 pingIntervall = m_dbEngine->GetPingIntervall();
+    const bool ping = m_ping && pingIntervall > 0;
+    uint32 lastPing = getMSTime();
 
-    uint32 loopCounter = 0;
     while (m_running)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        ACE_Based::Thread::Sleep(loopSleepms);
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_wakeupLock);
+
+            // sleep until something is queued, the thread is stopped or the next ping is due
+            while (!m_pending && m_running)
+            {
+                if (!ping)
+                {
+                    m_wakeup.wait();
+                    continue;
+                }
+
+                uint32 sinceLastPing = getMSTimeDiff(lastPing, getMSTime());
+                if (sinceLastPing >= pingIntervall)
+                {
+                    break;
+                }
+
+                // split into seconds, the interval in usec does not fit a 32 bit long
+                uint32 waitMs = pingIntervall - sinceLastPing;
+                ACE_Time_Value timeout = ACE_OS::gettimeofday();
+                timeout += ACE_Time_Value(waitMs / IN_MILLISECONDS, (waitMs % IN_MILLISECONDS) * 1000);
+                m_wakeup.wait(&timeout);
+            }
 
+            m_pending = false;
+        }
+
+        // if the running state gets turned off while waiting
+        // empty the queue before exiting
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (ping && getMSTimeDiff(lastPing, getMSTime()) >= pingIntervall)
         {
-            loopCounter = 0;
+            lastPing = getMSTime();
             m_dbEngine->Ping();
         }
     }
@@ -70,15 +111,173 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_wakeupLock);
     m_running = false;
+    m_wakeup.signal();
 }
 
 void SqlDelayThread::ProcessRequests()
 {
+    const uint32 batchSize = m_dbEngine->GetWriteBatchSize();
+    std::vector<SqlOperation*> batch;
+
     SqlOperation* s = NULL;
     while (m_sqlQueue.next(s))
     {
-        s->Execute(m_dbConnection);
-        delete s;
+        if (batchSize > 1 && s->IsBatchable())
+        {
+            batch.push_back(s);
+            if (batch.size() >= batchSize)
+            {
+                ExecuteBatch(batch);
+            }
+
+            continue;
+        }
+
+        // keep the queue order, queries must see all writes queued before them
+        ExecuteBatch(batch);
+        ExecuteOperation(s);
     }
+
+    ExecuteBatch(batch);
+}
+
+void SqlDelayThread::ExecuteOperation(SqlOperation* op)
+{
+    ExecuteTimed(op);
+    op->OnRemove();
+}
+
+bool SqlDelayThread::ExecuteTimed(SqlOperation* op)
+{
+    uint32 startTime = getMSTime();
+    bool result = op->Execute(m_dbConnection);
+    uint32 endTime = getMSTime();
+
+    m_dbEngine->GetDelayStats().OnExecuted(m_dbEngine, op, getMSTimeDiff(op->GetQueuedTime(), startTime), getMSTimeDiff(startTime, endTime));
+    return result;
+}
+
+void SqlDelayThread::ExecuteBatch(std::vector<SqlOperation*>& batch)
+{
+    if (batch.empty())
+    {
+        return;
+    }
+
+    if (batch.size() == 1)
+    {
+        ExecuteOperation(batch.front());
+        batch.clear();
+        return;
+    }
+
+    SqlConnection::Lock guard(m_dbConnection);
+    m_dbConnection->BeginTransaction();
+
+    size_t executed = 0;
+    bool success = true;
+    while (success && executed < batch.size())
+    {
+        success = ExecuteTimed(batch[executed++]);
+    }
+
+    if (success)
+    {
+        success = m_dbConnection->CommitTransaction();
+    }
+
+    if (success)
+    {
+        m_dbEngine->GetDelayStats().OnBatch();
+    }
+    else
+    {
+        // a deadlock, lock wait timeout or lost connection discards the whole transaction, so nothing
+        // of the batch can be assumed written: run it again one statement at a time like outside a batch
+        m_dbConnection->RollbackTransaction();
+        sLog.outError("SqlDelayThread: batch of %u statements failed, replaying it statement by statement", uint32(batch.size()));
+
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            if (i < executed)
+            {
+                batch[i]->Execute(m_dbConnection);          // already accounted in the stats
+            }
+            else
+            {
+                ExecuteTimed(batch[i]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        batch[i]->OnRemove();
+    }
+
+    batch.clear();
+}
+
+int SqlDelayStats::GetBucket(uint32 time)
+{
+    for (int i = 0; i < HISTOGRAM_BUCKETS - 1; ++i)
+    {
+        if (time < GetBucketBound(i))
+        {
+            return i;
+        }
+    }
+
+    return HISTOGRAM_BUCKETS - 1;
+}
+
+uint32 SqlDelayStats::GetBucketBound(int bucket)
+{
+    static const uint32 bounds[HISTOGRAM_BUCKETS] = { 1, 5, 20, 100, 1000, 0 };
+    return bounds[bucket];
+}
+
+void SqlDelayStats::OnExecuted(Database const* db, SqlOperation const* op, uint32 waitTime, uint32 execTime)
+{
+    --m_queueDepth;
+    ++m_executed;
+    ++m_waitHistogram[GetBucket(waitTime)];
+    ++m_execHistogram[GetBucket(execTime)];
+
+    if (execTime == 0 || long(execTime) <= m_slowestThreshold.value())
+    {
+        return;
+    }
+
+    // describe outside the lock, prepared statements take the statement registry lock
+    SlowStatement entry;
+    entry.execTime = execTime;
+    entry.sql = op->Describe(db);
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_slowestLock);
+
+    SlowStatementList::iterator itr = m_slowest.begin();
+    while (itr != m_slowest.end() && itr->execTime >= execTime)
+    {
+        ++itr;
+    }
+
+    m_slowest.insert(itr, entry);
+    if (m_slowest.size() > SLOWEST_STATEMENTS)
+    {
+        m_slowest.pop_back();
+    }
+
+    if (m_slowest.size() == SLOWEST_STATEMENTS)
+    {
+        m_slowestThreshold = long(m_slowest.back().execTime);
+    }
+}
+
+SqlDelayStats::SlowStatementList SqlDelayStats::GetSlowestStatements() const
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_slowestLock, SlowStatementList());
+    return m_slowest;
 }
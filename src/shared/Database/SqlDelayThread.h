@@ -26,13 +26,97 @@
 #define MANGOS_H_SQLDELAYTHREAD
 
 #include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+#include "Platform/Define.h"
 #include "LockedQueue/LockedQueue.h"
 #include "Threading/Threading.h"
 
+#include <string>
+#include <vector>
+
 class Database;
 class SqlOperation;
 class SqlConnection;
 
+/**
+ * @brief queue depth and latency counters of the delay threads of one Database
+ *
+ * Shared by the async thread and the holder threads, readable from any thread.
+ */
+class SqlDelayStats
+{
+    public:
+        enum
+        {
+            HISTOGRAM_BUCKETS  = 6,                         ///< <1, <5, <20, <100, <1000, >=1000 ms
+            SLOWEST_STATEMENTS = 10
+        };
+
+        /**
+         * @brief one entry of the slowest statement list
+         *
+         */
+        struct SlowStatement
+        {
+            uint32 execTime;                                ///< ms spent executing
+            std::string sql;
+        };
+        typedef std::vector<SlowStatement> SlowStatementList;
+
+        SqlDelayStats() : m_queueDepth(0), m_executed(0), m_batches(0), m_slowestThreshold(0)
+        {
+            for (int i = 0; i < HISTOGRAM_BUCKETS; ++i)
+            {
+                m_waitHistogram[i] = 0;
+                m_execHistogram[i] = 0;
+            }
+        }
+
+        void OnQueued() { ++m_queueDepth; }
+        void OnBatch() { ++m_batches; }
+        /**
+         * @brief account one finished operation
+         *
+         * @param db owner of the statement, to describe prepared statements
+         * @param op operation, described only if it makes it into the slowest list
+         * @param waitTime ms spent in the queue
+         * @param execTime ms spent executing
+         */
+        void OnExecuted(Database const* db, SqlOperation const* op, uint32 waitTime, uint32 execTime);
+
+        long GetQueueDepth() const { return m_queueDepth.value(); }
+        long GetExecuted() const { return m_executed.value(); }
+        long GetBatches() const { return m_batches.value(); }
+        long GetWaitHistogram(int bucket) const { return m_waitHistogram[bucket].value(); }
+        long GetExecHistogram(int bucket) const { return m_execHistogram[bucket].value(); }
+        /**
+         * @brief upper bound (exclusive) of a histogram bucket in ms, 0 for the last one
+         *
+         */
+        static uint32 GetBucketBound(int bucket);
+        /**
+         * @brief copy of the slowest statements, slowest first
+         *
+         */
+        SlowStatementList GetSlowestStatements() const;
+
+    private:
+        typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> Counter;
+
+        static int GetBucket(uint32 time);
+
+        Counter m_queueDepth;
+        Counter m_executed;
+        Counter m_batches;
+        Counter m_waitHistogram[HISTOGRAM_BUCKETS];
+        Counter m_execHistogram[HISTOGRAM_BUCKETS];
+
+        Counter m_slowestThreshold;                         ///< fastest entry of a full m_slowest, skips the lock for common statements
+        SlowStatementList m_slowest;                        ///< sorted, slowest first
+        mutable ACE_Thread_Mutex m_slowestLock;
+};
+
 /**
  * @brief
  *
@@ -50,12 +134,33 @@ class SqlDelayThread : public ACE_Based::Runnable
         Database* m_dbEngine;                               /**< Pointer to used Database engine */
         SqlConnection* m_dbConnection;                      /**< Pointer to DB connection */
         volatile bool m_running; /**< TODO */
+        bool m_ping;                                        /**< keep the DB connections alive */
+
+        ACE_Thread_Mutex m_wakeupLock;
+        ACE_Condition_Thread_Mutex m_wakeup;                /**< signaled by Delay() and Stop() */
+        bool m_pending;                                     /**< work queued since the last wakeup, guarded by m_wakeupLock */
 
         /**
          * @brief process all enqueued requests
          *
          */
         void ProcessRequests();
+        /**
+         * @brief execute one operation and account it in the database stats
+         *
+         */
+        void ExecuteOperation(SqlOperation* op);
+        /**
+         * @brief execute one operation and account it in the database stats, without releasing it
+         *
+         * @return bool false if the operation failed
+         */
+        bool ExecuteTimed(SqlOperation* op);
+        /**
+         * @brief execute contiguous plain writes inside one transaction
+         *
+         */
+        void ExecuteBatch(std::vector<SqlOperation*>& batch);
 
     public:
         /**
@@ -63,8 +168,9 @@ class SqlDelayThread : public ACE_Based::Runnable
          *
          * @param db
          * @param conn
+         * @param ping
          */
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool ping = true);
         /**
          * @brief
          *
@@ -77,7 +183,7 @@ class SqlDelayThread : public ACE_Based::Runnable
          * @param sql
          * @return bool
          */
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        bool Delay(SqlOperation* sql);
 
         /**
          * @brief Stop event
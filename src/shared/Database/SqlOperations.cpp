@@ -73,6 +73,18 @@ bool SqlTransaction::Execute(SqlConnection* conn)
     return conn->CommitTransaction();
 }
 
+std::string SqlTransaction::Describe(Database const* db) const
+{
+    std::ostringstream ss;
+    ss << "transaction of " << m_queue.size() << " statements";
+    if (!m_queue.empty())
+    {
+        ss << ", first: " << m_queue.front()->Describe(db);
+    }
+
+    return ss.str();
+}
+
 SqlPreparedRequest::SqlPreparedRequest(int nIndex, SqlStmtParameters* arg) : m_nIndex(nIndex), m_param(arg)
 {
 }
@@ -88,6 +100,11 @@ bool SqlPreparedRequest::Execute(SqlConnection* conn)
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+std::string SqlPreparedRequest::Describe(Database const* db) const
+{
+    return db ? db->GetStmtString(m_nIndex) : std::string();
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection* conn)
@@ -117,7 +134,7 @@ void SqlResultQueue::Update()
     }
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue, Database* db)
 {
     if (!callback || !thread || !queue)
     {
@@ -126,7 +143,7 @@ bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* t
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
+    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue, db && db->GetHolderThreadCount() ? db : NULL);
     thread->Delay(holderEx);
     return true;
 }
@@ -174,6 +191,33 @@ bool SqlQueryHolder::SetPQuery(size_t index, const char* format, ...)
     return SetQuery(index, szQuery);
 }
 
+bool SqlQueryHolder::SetQuery(size_t index, SqlStatement& stmt)
+{
+    if (m_queries.size() <= index)
+    {
+        sLog.outError("Query index (%zu) out of range (size: %zu) for statement: %i", index, m_queries.size(), stmt.ID());
+        return false;
+    }
+
+    if (m_queries[index].first != NULL || m_stmts[index].second != NULL)
+    {
+        sLog.outError("Attempt assign statement %i to holder index (%zu) where other query stored", stmt.ID(), index);
+        return false;
+    }
+
+    SqlStmtParameters* params = stmt.detach();
+    if (params->boundParams() != stmt.arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i) for statement: %i", params->boundParams(), stmt.arguments(), stmt.ID());
+        delete params;
+        return false;
+    }
+
+    /// not executed yet, the parameters are kept until the result is fetched
+    m_stmts[index] = SqlStmtPair(stmt.ID(), params);
+    return true;
+}
+
 QueryResult* SqlQueryHolder::GetResult(size_t index)
 {
     if (index < m_queries.size())
@@ -184,6 +228,11 @@ QueryResult* SqlQueryHolder::GetResult(size_t index)
             delete[](const_cast<char*>(m_queries[index].first));
             m_queries[index].first = NULL;
         }
+        if (m_stmts[index].second != NULL)
+        {
+            delete m_stmts[index].second;
+            m_stmts[index].second = NULL;
+        }
         /// when you get a result aways remember to delete it!
         return m_queries[index].second;
     }
@@ -213,6 +262,11 @@ SqlQueryHolder::~SqlQueryHolder()
             delete[](const_cast<char*>(m_queries[i].first));
             delete m_queries[i].second;
         }
+        else if (m_stmts[i].second != NULL)
+        {
+            delete m_stmts[i].second;
+            delete m_queries[i].second;
+        }
     }
 }
 
@@ -220,6 +274,7 @@ void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_stmts.resize(size, SqlStmtPair(-1, (SqlStmtParameters*)NULL));
 }
 
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
@@ -229,10 +284,40 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
         return false;
     }
 
+    size_t queries = m_holder->m_queries.size();
+    size_t parts = m_db ? std::min(m_db->GetHolderThreadCount(), queries) : 0;
+    if (parts < 2)
+    {
+        ExecuteQueries(conn, 0, 1);                         // nothing to gain, run them here
+    }
+    else
+    {
+        /// all writes queued before the holder are done now, the queries can run anywhere
+        m_pendingParts = parts;
+        for (size_t i = 0; i < parts; ++i)
+        {
+            m_db->GetHolderThread()->Delay(new SqlQueryHolderPart(this, i, parts));
+        }
+
+        /// but the writes queued after it have to wait until every part has read
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_partLock, false);
+        while (m_pendingParts)
+        {
+            m_partsDone.wait();
+        }
+    }
+
+    /// sync with the caller thread
+    m_queue->add(m_callback);
+    return true;
+}
+
+void SqlQueryHolderEx::ExecuteQueries(SqlConnection* conn, size_t first, size_t step)
+{
     LOCK_DB_CONN(conn);
     /// we can do this, we are friends
     std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
-    for (size_t i = 0; i < queries.size(); ++i)
+    for (size_t i = first; i < queries.size(); i += step)
     {
         /// execute all queries in the holder and pass the results
         char const* sql = queries[i].first;
@@ -240,10 +325,25 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
         {
             m_holder->SetResult(i, conn->Query(sql));
         }
+        else if (SqlStmtParameters* params = m_holder->m_stmts[i].second)
+        {
+            m_holder->SetResult(i, conn->QueryStmt(m_holder->m_stmts[i].first, *params));
+        }
     }
+}
 
-    /// sync with the caller thread
-    m_queue->add(m_callback);
+void SqlQueryHolderEx::PartDone()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_partLock);
+    if (--m_pendingParts == 0)
+    {
+        m_partsDone.signal();
+    }
+}
 
+bool SqlQueryHolderPart::Execute(SqlConnection* conn)
+{
+    m_owner->ExecuteQueries(conn, m_first, m_step);
+    m_owner->PartDone();
     return true;
 }
@@ -28,6 +28,7 @@
 #include "Common/Common.h"
 
 #include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
 #include "LockedQueue/LockedQueue.h"
 #include <queue>
 #include "Utilities/Callback.h"
@@ -38,6 +39,7 @@ class Database;
 class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
+class SqlStatement;
 
 /**
  * @brief
@@ -46,6 +48,7 @@ class SqlStmtParameters;
 class SqlOperation
 {
     public:
+        SqlOperation() : m_queuedTime(0) {}
         /**
          * @brief
          *
@@ -58,11 +61,31 @@ class SqlOperation
          * @return bool
          */
         virtual bool Execute(SqlConnection* conn) = 0;
+        /**
+         * @brief single write without results or ordering needs of its own,
+         *        may share a transaction with its neighbours in the queue
+         *
+         * @return bool
+         */
+        virtual bool IsBatchable() const { return false; }
+        /**
+         * @brief text for the slowest statement list
+         *
+         * @param db owner of the operation
+         * @return std::string
+         */
+        virtual std::string Describe(Database const* db) const = 0;
         /**
          * @brief
          *
          */
         virtual ~SqlOperation() {}
+
+        void SetQueuedTime(uint32 time) { m_queuedTime = time; }
+        uint32 GetQueuedTime() const { return m_queuedTime; }
+
+    private:
+        uint32 m_queuedTime;                                /**< getMSTime() when handed to a delay thread */
 };
 
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
@@ -94,6 +117,8 @@ class SqlPlainRequest : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
+        std::string Describe(Database const* /*db*/) const override { return m_sql; }
 };
 
 /**
@@ -131,6 +156,7 @@ class SqlTransaction : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        std::string Describe(Database const* db) const override;
 };
 
 /**
@@ -160,6 +186,8 @@ class SqlPreparedRequest : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        bool IsBatchable() const override { return true; }
+        std::string Describe(Database const* db) const override;
 
     private:
         const int m_nIndex; /**< TODO */
@@ -225,6 +253,7 @@ class SqlQuery : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        std::string Describe(Database const* /*db*/) const override { return m_sql; }
 };
 
 /**
@@ -241,6 +270,12 @@ class SqlQueryHolder
          */
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries; /**< TODO */
+        /**
+         * @brief prepared SELECT statement id and its bound parameters
+         *
+         */
+        typedef std::pair<int, SqlStmtParameters*> SqlStmtPair;
+        std::vector<SqlStmtPair> m_stmts; /**< same indexes as m_queries */
     public:
         /**
          * @brief
@@ -268,6 +303,14 @@ class SqlQueryHolder
          * @return bool
          */
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
+        /**
+         * @brief store a prepared SELECT, its parameters are taken from stmt
+         *
+         * @param index
+         * @param stmt
+         * @return bool
+         */
+        bool SetQuery(size_t index, SqlStatement& stmt);
         /**
          * @brief
          *
@@ -294,14 +337,20 @@ class SqlQueryHolder
          * @param callback
          * @param thread
          * @param queue
+         * @param db spreads the queries over its holder threads, if it has any
          * @return bool
          */
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue, Database* db = NULL);
 };
 
 /**
  * @brief
  *
+ * Queued on the async delay thread, so the queries see all writes queued
+ * before them. With holder threads the queries are then split into parts
+ * that run in parallel, while the async thread waits for them: writes queued
+ * after the holder cannot run before every part has read, so all queries of
+ * the holder see the same state (mails and their items, for example).
  */
 class SqlQueryHolderEx : public SqlOperation
 {
@@ -309,6 +358,26 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder; /**< TODO */
         MaNGOS::IQueryCallback* m_callback; /**< TODO */
         SqlResultQueue* m_queue; /**< TODO */
+        Database* m_db;                                     /**< NULL runs all queries on the async connection */
+        ACE_Thread_Mutex m_partLock;
+        ACE_Condition_Thread_Mutex m_partsDone;             /**< signaled when the last part finished */
+        size_t m_pendingParts;                              /**< guarded by m_partLock */
+
+        /**
+         * @brief run the queries first, first + step, ... of the holder
+         *
+         * @param conn
+         * @param first
+         * @param step
+         */
+        void ExecuteQueries(SqlConnection* conn, size_t first, size_t step);
+        /**
+         * @brief the last call wakes up the async thread waiting in Execute
+         *
+         */
+        void PartDone();
+
+        friend class SqlQueryHolderPart;
     public:
         /**
          * @brief
@@ -316,9 +385,40 @@ class SqlQueryHolderEx : public SqlOperation
          * @param holder
          * @param callback
          * @param queue
+         * @param db
+         */
+        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, Database* db = NULL)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_db(db), m_partsDone(m_partLock), m_pendingParts(0) {}
+        /**
+         * @brief
+         *
+         * @param conn
+         * @return bool
+         */
+        bool Execute(SqlConnection* conn) override;
+        std::string Describe(Database const* /*db*/) const override { return "query holder"; }
+};
+
+/**
+ * @brief every step-th query of a holder, executed on a holder thread
+ *
+ */
+class SqlQueryHolderPart : public SqlOperation
+{
+    private:
+        SqlQueryHolderEx* m_owner; /**< TODO */
+        size_t m_first; /**< TODO */
+        size_t m_step; /**< TODO */
+    public:
+        /**
+         * @brief
+         *
+         * @param owner
+         * @param first
+         * @param step
          */
-        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderPart(SqlQueryHolderEx* owner, size_t first, size_t step)
+            : m_owner(owner), m_first(first), m_step(step) {}
         /**
          * @brief
          *
@@ -326,5 +426,6 @@ class SqlQueryHolderEx : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        std::string Describe(Database const* /*db*/) const override { return "query holder part"; }
 };
 #endif                                                      //__SQLOPERATIONS_H
@@ -115,6 +115,26 @@ bool SqlStatement::DirectExecute()
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+/**
+ * @brief Run the SELECT statement on a query connection.
+ * @return The query result.
+ */
+QueryResult* SqlStatement::Query()
+{
+    SqlStmtParameters* args = detach();
+    // verify amount of bound parameters
+    if (args->boundParams() != arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
+        sLog.outError("SQL ERROR: statement: %s", m_pDB->GetStmtString(ID()).c_str());
+        MANGOS_ASSERT(false);
+        delete args;
+        return NULL;
+    }
+
+    return m_pDB->QueryStmt(m_index, args);
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 /**
@@ -181,6 +201,20 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
+/**
+ * @brief Execute the statement as plain text query.
+ * @return The query result.
+ */
+QueryResult* SqlPlainPreparedStatement::query()
+{
+    if (m_szPlainRequest.empty())
+    {
+        return NULL;
+    }
+
+    return m_pConn.Query(m_szPlainRequest.c_str());
+}
+
 /**
  * @brief Convert data to string format.
  * @param data The data to convert.
@@ -374,6 +374,54 @@ class SqlStatement
          */
         bool DirectExecute();
 
+        /**
+         * @brief Run a prepared SELECT synchronously on a query connection.
+         * @return The result positioned at the first row, NULL if there are no rows.
+         */
+        QueryResult* Query();
+
+        template<typename ParamType1>
+        /**
+         * @brief Query with one parameter.
+         * @param param1 The parameter to query with.
+         * @return The query result.
+         */
+        QueryResult* PQuery(ParamType1 param1)
+        {
+            arg(param1);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        /**
+         * @brief Query with two parameters.
+         * @param param1 The first parameter to query with.
+         * @param param2 The second parameter to query with.
+         * @return The query result.
+         */
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2)
+        {
+            arg(param1);
+            arg(param2);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3>
+        /**
+         * @brief Query with three parameters.
+         * @param param1 The first parameter to query with.
+         * @param param2 The second parameter to query with.
+         * @param param3 The third parameter to query with.
+         * @return The query result.
+         */
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            return Query();
+        }
+
         // templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
         /**
@@ -511,6 +559,8 @@ class SqlStatement
     protected:
         // don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        // query holders take over the bound parameters
+        friend class SqlQueryHolder;
         /**
          * @brief Constructor to create a SqlStatement object.
          * @param index The statement ID.
@@ -613,6 +663,12 @@ class SqlPreparedStatement
          */
         virtual bool execute() = 0;
 
+        /**
+         * @brief Execute a SELECT statement.
+         * @return The result positioned at the first row, NULL if there are no rows.
+         */
+        virtual QueryResult* query() = 0;
+
     protected:
         /**
          * @brief Constructor to create a SqlPreparedStatement object.
@@ -667,6 +723,12 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
          */
         bool execute() override;
 
+        /**
+         * @brief Execute the statement as plain text query.
+         * @return The query result.
+         */
+        QueryResult* query() override;
+
     protected:
         /**
          * @brief Convert data to string format.
@@ -0,0 +1,356 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+#ifndef MANGOS_H_GRIDOBJECTLIST
+#define MANGOS_H_GRIDOBJECTLIST
+
+#include "Platform/Define.h"
+#include <vector>
+
+/**
+ * @brief hot state of a grid object mirrored next to its pointer
+ *
+ * Lets visitors skip objects without dereferencing them. The owner keeps
+ * the mirror up to date through its GridObjectRef.
+ */
+enum GridObjectMirrorFlags
+{
+    GRID_MIRROR_ALIVE       = 0x01                          // unit with DeathState ALIVE
+};
+
+/**
+ * @brief values filled by the object when it enters a list
+ */
+struct GridObjectMirror
+{
+    GridObjectMirror() : x(0.0f), y(0.0f), radius(0.0f), flags(0) {}
+
+    float x;
+    float y;
+    float radius;                                           // object bounding radius
+    uint32 flags;                                           // GridObjectMirrorFlags
+};
+
+class GridObjectRef;
+
+/**
+ * @brief type independent part of GridObjectList
+ *
+ * Keeps the mirror array and the visit bookkeeping, so a GridObjectRef can
+ * update its entry without knowing the object type.
+ */
+class GridObjectListBase
+{
+        friend class GridObjectRef;
+
+    public:
+        /**
+         * @brief number of objects in the list
+         *
+         * @return uint32
+         */
+        uint32 getSize() const { return m_size; }
+        bool isEmpty() const { return m_size == 0; }
+
+    protected:
+        GridObjectListBase() : m_size(0), m_holes(0), m_visitors(0) {}
+        virtual ~GridObjectListBase() {}
+
+        /**
+         * @brief drop the entry at index, called from GridObjectRef::unlink
+         *
+         * @param index
+         */
+        virtual void eraseAt(uint32 index) = 0;
+
+        void pushMirror(GridObjectMirror const& mirror)
+        {
+            m_mirrorX.push_back(mirror.x);
+            m_mirrorY.push_back(mirror.y);
+            m_mirrorRadius.push_back(mirror.radius);
+            m_mirrorFlags.push_back(mirror.flags);
+        }
+
+        void moveMirror(uint32 from, uint32 to)
+        {
+            m_mirrorX[to] = m_mirrorX[from];
+            m_mirrorY[to] = m_mirrorY[from];
+            m_mirrorRadius[to] = m_mirrorRadius[from];
+            m_mirrorFlags[to] = m_mirrorFlags[from];
+        }
+
+        void resizeMirrors(uint32 size)
+        {
+            m_mirrorX.resize(size);
+            m_mirrorY.resize(size);
+            m_mirrorRadius.resize(size);
+            m_mirrorFlags.resize(size);
+        }
+
+        // mirrors, one array per field, parallel to the object array
+        std::vector<float> m_mirrorX;
+        std::vector<float> m_mirrorY;
+        std::vector<float> m_mirrorRadius;
+        std::vector<uint32> m_mirrorFlags;
+        uint32 m_size;                                      // live entries
+        uint32 m_holes;                                     // entries erased while visited, compacted after the visit
+        uint32 m_visitors;                                  // nesting depth of running visits
+
+    private:
+        GridObjectListBase(GridObjectListBase const&);
+        GridObjectListBase& operator=(GridObjectListBase const&);
+};
+
+/**
+ * @brief membership of an object in a GridObjectList, embedded in the object
+ */
+class GridObjectRef
+{
+        template<class OBJECT> friend class GridObjectList;
+
+    public:
+        GridObjectRef() : m_list(NULL), m_index(0) {}
+        ~GridObjectRef() { unlink(); }
+
+        bool isValid() const { return m_list != NULL; }
+
+        template<class OBJECT, class LIST>
+        void link(LIST* list, OBJECT* obj)
+        {
+            unlink();
+            list->insert(obj);
+        }
+
+        void unlink()
+        {
+            if (m_list)
+            {
+                GridObjectListBase* list = m_list;
+                m_list = NULL;
+                list->eraseAt(m_index);
+            }
+        }
+
+        /**
+         * @brief set or clear GridObjectMirrorFlags in the list entry
+         *
+         * @param flags
+         * @param apply
+         */
+        void SetMirrorFlags(uint32 flags, bool apply)
+        {
+            if (m_list)
+            {
+                uint32& mirror = m_list->m_mirrorFlags[m_index];
+                mirror = apply ? (mirror | flags) : (mirror & ~flags);
+            }
+        }
+
+        void SetMirrorPosition(float x, float y)
+        {
+            if (m_list)
+            {
+                m_list->m_mirrorX[m_index] = x;
+                m_list->m_mirrorY[m_index] = y;
+            }
+        }
+
+        void SetMirrorRadius(float radius)
+        {
+            if (m_list)
+            {
+                m_list->m_mirrorRadius[m_index] = radius;
+            }
+        }
+
+    private:
+        GridObjectRef(GridObjectRef const&);
+        GridObjectRef& operator=(GridObjectRef const&);
+
+        GridObjectListBase* m_list;
+        uint32 m_index;
+};
+
+/**
+ * @brief objects of one type in a cell, stored as a dense pointer array
+ *
+ * Insert appends and erase moves the last entry into the freed index, both
+ * O(1). While a visit runs (see BeginVisit) erased entries are only nulled
+ * and skipped by the iterators, and entries appended during the visit are
+ * not visited by it; the array is compacted when the last visit ends.
+ */
+template<class OBJECT>
+class GridObjectList : public GridObjectListBase
+{
+    public:
+        class iterator
+        {
+            public:
+                iterator() : m_list(NULL), m_index(END), m_end(END) {}
+
+                OBJECT* getSource() const { return m_list->m_objects[m_index]; }
+                uint32 getMirrorFlags() const { return m_list->m_mirrorFlags[m_index]; }
+                float getMirrorX() const { return m_list->m_mirrorX[m_index]; }
+                float getMirrorY() const { return m_list->m_mirrorY[m_index]; }
+                float getMirrorRadius() const { return m_list->m_mirrorRadius[m_index]; }
+
+                // allows the usual iter->getSource() form
+                iterator const* operator->() const { return this; }
+
+                iterator& operator++()
+                {
+                    ++m_index;
+                    skipHoles();
+                    return *this;
+                }
+
+                bool operator==(iterator const& other) const { return m_index == other.m_index; }
+                bool operator!=(iterator const& other) const { return m_index != other.m_index; }
+
+            private:
+                friend class GridObjectList<OBJECT>;
+
+                enum { END = 0xFFFFFFFF };
+
+                iterator(GridObjectList<OBJECT>* list, uint32 index, uint32 end) : m_list(list), m_index(index), m_end(end)
+                {
+                    skipHoles();
+                }
+
+                void skipHoles()
+                {
+                    while (m_index < m_end && !m_list->m_objects[m_index])
+                    {
+                        ++m_index;
+                    }
+
+                    if (m_index >= m_end)
+                    {
+                        m_index = END;
+                    }
+                }
+
+                GridObjectList<OBJECT>* m_list;
+                uint32 m_index;
+                uint32 m_end;                               // size at begin(), later appends are not visited
+        };
+
+        GridObjectList() {}
+
+        ~GridObjectList()
+        {
+            for (typename std::vector<OBJECT*>::const_iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr)
+            {
+                if (*itr)
+                {
+                    (*itr)->GetGridRef().m_list = NULL;
+                }
+            }
+        }
+
+        iterator begin() { return iterator(this, 0, uint32(m_objects.size())); }
+        iterator end() { return iterator(); }
+
+        void insert(OBJECT* obj)
+        {
+            GridObjectRef& ref = obj->GetGridRef();
+            ref.m_list = this;
+            ref.m_index = uint32(m_objects.size());
+            m_objects.push_back(obj);
+
+            GridObjectMirror mirror;
+            obj->BuildGridMirror(mirror);
+            pushMirror(mirror);
+            ++m_size;
+        }
+
+        /**
+         * @brief mark the start of a visit, erase keeps indices stable until EndVisit
+         */
+        void BeginVisit() { ++m_visitors; }
+
+        /**
+         * @brief mark the end of a visit, the last one compacts erased entries
+         */
+        void EndVisit()
+        {
+            if (--m_visitors == 0 && m_holes)
+            {
+                compact();
+            }
+        }
+
+    protected:
+        void eraseAt(uint32 index) override
+        {
+            --m_size;
+
+            if (m_visitors)
+            {
+                m_objects[index] = NULL;
+                ++m_holes;
+                return;
+            }
+
+            uint32 last = uint32(m_objects.size()) - 1;
+            if (index != last)
+            {
+                m_objects[index] = m_objects[last];
+                moveMirror(last, index);
+                m_objects[index]->GetGridRef().m_index = index;
+            }
+
+            m_objects.pop_back();
+            resizeMirrors(last);
+        }
+
+    private:
+        void compact()
+        {
+            uint32 count = 0;
+            for (uint32 i = 0; i < m_objects.size(); ++i)
+            {
+                if (!m_objects[i])
+                {
+                    continue;
+                }
+
+                if (i != count)
+                {
+                    m_objects[count] = m_objects[i];
+                    moveMirror(i, count);
+                    m_objects[count]->GetGridRef().m_index = count;
+                }
+
+                ++count;
+            }
+
+            m_objects.resize(count);
+            resizeMirrors(count);
+            m_holes = 0;
+        }
+
+        std::vector<OBJECT*> m_objects;
+};
+
+#endif
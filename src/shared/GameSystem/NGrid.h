@@ -26,6 +26,7 @@
 #define MANGOS_NGRID_H
 
 #include "GameSystem/Grid.h"
+#include "GameSystem/GridRefManager.h"
 #include "GameSystem/GridReference.h"
 #include "Timer.h"
 
@@ -35,7 +35,7 @@
 #include <cstddef>
 #include <tuple>
 #include <unordered_map>
-#include "GameSystem/GridRefManager.h"
+#include "GameSystem/GridObjectList.h"
 
 
 // various metaprogramming primitives
@@ -163,10 +163,21 @@ template<typename TYPE_LIST>
 class TypeMapContainer
 {
     using Tuple = Meta::Rename<TYPE_LIST,std::tuple>;
-    template <typename T> using add_wrap = GridRefManager<T>;
+    template <typename T> using add_wrap = GridObjectList<T>;
 
     using Container = Meta::Transform<add_wrap, Tuple>;
 
+    // brackets a visit, erased objects keep their slot until the visit ends
+    struct VisitBegin
+    {
+        template <typename T> void Visit(GridObjectList<T>& list) { list.BeginVisit(); }
+    };
+
+    struct VisitEnd
+    {
+        template <typename T> void Visit(GridObjectList<T>& list) { list.EndVisit(); }
+    };
+
     public:
         template <typename T>
         size_t count(T*) const
@@ -191,7 +202,9 @@ class TypeMapContainer
         template <typename Visitor>
         void accept(Visitor&& v)
         {
+            Meta::for_each(std::forward<Container>(i_container), VisitBegin());
             Meta::for_each(std::forward<Container>(i_container), std::forward<Visitor>(v));
+            Meta::for_each(std::forward<Container>(i_container), VisitEnd());
         }
 
     private:
@@ -72,6 +72,19 @@ namespace ACE_Based
                 _queue.push_back(item);
             }
 
+            /**
+             * @brief Adds a range of items to the queue, taking the lock once.
+             *
+             * @param first
+             * @param last
+             */
+            template<class Iterator>
+            void add(Iterator first, Iterator last)
+            {
+                ACE_GUARD (LockType, g, this->_lock);
+                _queue.insert(_queue.end(), first, last);
+            }
+
             /**
              * @brief Gets the next result in the queue, if any.
              *
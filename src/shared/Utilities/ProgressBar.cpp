@@ -92,7 +92,8 @@ void BarGoLink::step()
 
     int i, n;
 
-    if (num_rec == 0)
+    // streamed loads count their rows up front, the table may grow meanwhile
+    if (num_rec == 0 || rec_no >= num_rec)
     {
         return;
     }